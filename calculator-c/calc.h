@@ -0,0 +1,86 @@
+/*
+  calc.h
+  libcalc: the calculator's expression engine, for embedding.
+
+  Compile an expression once and evaluate it as often as needed, one set of
+  variable values at a time or over whole columns:
+
+      calc_error_info err;
+      calc_expr *e = calc_compile("principal * (1 + rate)^years", &err);
+      if (!e) { fprintf(stderr, "%s\n", err.message); return; }
+      double vars[3] = { 1000, 0.07, 10 };   // in calc_var_name order
+      double v = calc_eval(e, vars, &err);
+      calc_release(e);
+
+  Expressions use the calculator's syntax and built-ins. Every other name
+  is a variable; variables are numbered in order of first appearance
+  (case-insensitively) and calc_var_name gives them back. M, the prompt's
+  memory, reads as 0. Assignments are not expressions and do not compile.
+
+  A compiled expression is never changed by evaluation, so any number of
+  threads may evaluate the same one at once. Link with -lm -pthread.
+*/
+
+#ifndef CALC_H
+#define CALC_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CALC_LIBRARY) && defined(__GNUC__)
+#define CALC_API __attribute__((visibility("default")))
+#else
+#define CALC_API
+#endif
+
+// Bumped whenever a declaration below changes incompatibly.
+#define CALC_VERSION 1
+
+// The stage that failed.
+typedef enum { CALC_OK, CALC_ERR_TOKENIZE, CALC_ERR_PARSE, CALC_ERR_EVAL } CalcStatus;
+
+#define CALC_ERROR_LEN 256
+
+typedef struct {
+    CalcStatus status;
+    long row;                     // calc_eval_batch: first row that failed, else -1
+    char message[CALC_ERROR_LEN]; // empty when status is CALC_OK
+} calc_error_info;
+
+typedef struct calc_expr calc_expr;
+
+// CALC_VERSION of the library actually linked.
+CALC_API int calc_version(void);
+
+// Compiles text, or returns NULL and says why in *err. err may be NULL.
+CALC_API calc_expr *calc_compile(const char *text, calc_error_info *err);
+CALC_API void calc_release(calc_expr *e);
+
+CALC_API size_t calc_var_count(const calc_expr *e);
+CALC_API const char *calc_var_name(const calc_expr *e, size_t i);
+
+// Trigonometric functions take and give degrees instead of radians. Set
+// before the expression is shared between threads.
+CALC_API void calc_set_degrees(calc_expr *e, int degrees);
+
+// Evaluates e with vars[i] bound to variable i. Returns NaN and fills *err
+// on a math error (division by zero, a domain error); err may be NULL.
+CALC_API double calc_eval(const calc_expr *e, const double *vars, calc_error_info *err);
+
+/*
+  Evaluates e for n rows, with variable i bound to columns[i][row], into
+  out[row], a block of rows at a time with vector instructions. A row
+  that fails gets NaN; returns the number of such rows, and *err describes
+  the first one.
+*/
+CALC_API size_t calc_eval_batch(const calc_expr *e, const double *const *columns, size_t n,
+                                double *out, calc_error_info *err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
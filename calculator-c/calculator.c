@@ -1,755 +1,10637 @@
-/*
-  big_calculator.c
-  A large, feature-rich scientific calculator in C.
-  - Supports infix expressions, functions, constants.
-  - Implements shunting-yard to convert to RPN and then evaluates.
-  - Single-file. Compile with: gcc big_calculator.c -o big_calc -lm
-
-  Notes:
-  - Uses math.h; link with -lm.
-  - Modest protections for invalid input; not bulletproof but robust.
-  - Angle mode is default RADIANS; use "mode deg" to switch to degrees.
-*/
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-
-#if defined(_MSC_VER)
-#define _USE_MATH_DEFINES
-#endif
-#include <math.h>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-#ifndef M_E
-#define M_E 2.71828182845904523536
-#endif
-
-#include <limits.h>
-#include <errno.h>
-
-#define MAX_TOKEN_LEN 128
-#define MAX_TOKENS 4096
-#define HISTORY_SIZE 256
-#define STACK_INIT_CAP 256
-
-typedef enum { TOKEN_NUMBER, TOKEN_OPERATOR, TOKEN_FUNCTION, TOKEN_PAREN_LEFT, TOKEN_PAREN_RIGHT, TOKEN_COMMA, TOKEN_CONSTANT, TOKEN_IDENTIFIER } TokenType;
-
-typedef struct {
-    TokenType type;
-    char str[MAX_TOKEN_LEN];
-    double value; // for number tokens or evaluated constants
-} Token;
-
-typedef struct {
-    Token *data;
-    int size;
-    int capacity;
-} TokenArray;
-
-typedef enum { MODE_RAD, MODE_DEG } AngleMode;
-
-static AngleMode angle_mode = MODE_RAD;
-static double memory_slot = 0.0;
-
-void token_array_init(TokenArray *arr) {
-    arr->capacity = 256;
-    arr->size = 0;
-    arr->data = (Token*)malloc(sizeof(Token) * arr->capacity);
-    if (!arr->data) { perror("malloc"); exit(1); }
-}
-void token_array_push(TokenArray *arr, Token t) {
-    if (arr->size >= arr->capacity) {
-        arr->capacity *= 2;
-        arr->data = (Token*)realloc(arr->data, sizeof(Token) * arr->capacity);
-        if (!arr->data) { perror("realloc"); exit(1); }
-    }
-    arr->data[arr->size++] = t;
-}
-void token_array_free(TokenArray *arr) {
-    free(arr->data);
-    arr->data = NULL;
-    arr->size = arr->capacity = 0;
-}
-
-/* ---------- Utility helpers ---------- */
-
-int str_eq_nocase(const char *a, const char *b) {
-    while (*a && *b) {
-        if (tolower((unsigned char)*a) != tolower((unsigned char)*b)) return 0;
-        a++; b++;
-    }
-    return *a == 0 && *b == 0;
-}
-
-void trim_trailing_newline(char *s) {
-    size_t n = strlen(s);
-    if (n == 0) return;
-    if (s[n-1] == '\n') s[n-1] = '\0';
-}
-
-/* ---------- Functions & operators metadata ---------- */
-
-int is_function_name(const char *s) {
-    const char *funcs[] = {
-        "sin","cos","tan","asin","acos","atan",
-        "sinh","cosh","tanh",
-        "sqrt","cbrt","ln","log","exp","pow",
-        "abs","floor","ceil","fact","nCr","nPr",
-        "gcd","lcm"
-    };
-    for (size_t i = 0; i < sizeof(funcs)/sizeof(funcs[0]); ++i)
-        if (str_eq_nocase(s, funcs[i])) return 1;
-    return 0;
-}
-
-int is_constant_name(const char *s) {
-    if (str_eq_nocase(s, "pi")) return 1;
-    if (str_eq_nocase(s, "e")) return 1;
-    if (str_eq_nocase(s, "M")) return 1; // memory recall identifier
-    return 0;
-}
-
-int is_identifier_char(char c) {
-    return isalpha((unsigned char)c) || c == '_' || c == '$';
-}
-
-/* precedence: higher number = higher precedence */
-int op_precedence(char op) {
-    switch (op) {
-        case '+': case '-': return 2;
-        case '*': case '/': case '%': return 3;
-        case '^': return 4;
-        default: return 0;
-    }
-}
-int op_right_associative(char op) {
-    return (op == '^');
-}
-
-int is_operator_char(char c) {
-    return c == '+' || c == '-' || c == '*' || c == '/' || c == '^' || c == '%';
-}
-
-/* ---------- Tokenizer ---------- */
-
-void push_number_token(TokenArray *arr, const char *s, size_t len) {
-    Token t;
-    t.type = TOKEN_NUMBER;
-    if (len >= MAX_TOKEN_LEN) len = MAX_TOKEN_LEN-1;
-    strncpy(t.str, s, len);
-    t.str[len] = '\0';
-    errno = 0;
-    t.value = strtod(t.str, NULL);
-    token_array_push(arr, t);
-}
-
-void push_operator_token(TokenArray *arr, char op) {
-    Token t;
-    t.type = TOKEN_OPERATOR;
-    t.str[0] = op;
-    t.str[1] = '\0';
-    t.value = 0.0;
-    token_array_push(arr, t);
-}
-
-void push_function_token(TokenArray *arr, const char *name) {
-    Token t;
-    t.type = TOKEN_FUNCTION;
-    strncpy(t.str, name, MAX_TOKEN_LEN-1);
-    t.str[MAX_TOKEN_LEN-1] = '\0';
-    token_array_push(arr, t);
-}
-
-void push_constant_token(TokenArray *arr, const char *name) {
-    Token t;
-    t.type = TOKEN_CONSTANT;
-    strncpy(t.str, name, MAX_TOKEN_LEN-1);
-    t.str[MAX_TOKEN_LEN-1] = '\0';
-    // value will be set in conversion stage
-    token_array_push(arr, t);
-}
-
-int tokenize_expression(const char *expr, TokenArray *out) {
-    size_t len = strlen(expr);
-    size_t i = 0;
-    while (i < len) {
-        char c = expr[i];
-        if (isspace((unsigned char)c)) { i++; continue; }
-        if (isdigit((unsigned char)c) || (c == '.' && i+1 < len && isdigit((unsigned char)expr[i+1]))) {
-            // number literal (supports decimal)
-            size_t j = i;
-            int seen_dot = 0;
-            if (expr[j] == '.') seen_dot = 1;
-            while (j < len && (isdigit((unsigned char)expr[j]) || (!seen_dot && expr[j] == '.'))) {
-                if (expr[j] == '.') seen_dot = 1;
-                j++;
-            }
-            push_number_token(out, expr + i, j - i);
-            i = j;
-            continue;
-        }
-        if (is_operator_char(c)) {
-            push_operator_token(out, c);
-            i++;
-            continue;
-        }
-        if (c == '(') {
-            Token t; t.type = TOKEN_PAREN_LEFT; strncpy(t.str, "(", MAX_TOKEN_LEN-1); t.str[MAX_TOKEN_LEN-1] = '\0'; token_array_push(out, t); i++; continue;
-        }
-        if (c == ')') {
-            Token t; t.type = TOKEN_PAREN_RIGHT; strncpy(t.str, ")", MAX_TOKEN_LEN-1); t.str[MAX_TOKEN_LEN-1] = '\0'; token_array_push(out, t); i++; continue;
-        }
-        if (c == ',') {
-            Token t; t.type = TOKEN_COMMA; strncpy(t.str, ",", MAX_TOKEN_LEN-1); t.str[MAX_TOKEN_LEN-1] = '\0'; token_array_push(out, t); i++; continue;
-        }
-        if (is_identifier_char(c)) {
-            size_t j = i;
-            while (j < len && (is_identifier_char(expr[j]) || isdigit((unsigned char)expr[j]) || expr[j]=='.')) j++;
-            size_t namelen = j - i;
-            char name[MAX_TOKEN_LEN];
-            if (namelen >= MAX_TOKEN_LEN) namelen = MAX_TOKEN_LEN-1;
-            strncpy(name, expr + i, namelen);
-            name[namelen] = '\0';
-            if (is_function_name(name)) {
-                push_function_token(out, name);
-            } else if (is_constant_name(name)) {
-                push_constant_token(out, name);
-            } else {
-                // treat unknown identifiers as function if followed by '(' else error
-                // But allow custom function names like nCr, nPr (they're in is_function_name)
-                push_function_token(out, name); // hoping it's a function or will error later
-            }
-            i = j;
-            continue;
-        }
-        // Unknown character
-        fprintf(stderr, "Tokenizer error: unexpected character '%c'\n", c);
-        return 0;
-    }
-    return 1;
-}
-
-/* ---------- Shunting-yard (infix -> RPN) ---------- */
-
-typedef struct {
-    Token *data;
-    int size;
-    int capacity;
-} TokenStack;
-
-void tokenstack_init(TokenStack *s) {
-    s->capacity = 256;
-    s->size = 0;
-    s->data = (Token*)malloc(sizeof(Token) * s->capacity);
-    if (!s->data) { perror("malloc"); exit(1); }
-}
-void tokenstack_push(TokenStack *s, Token t) {
-    if (s->size >= s->capacity) {
-        s->capacity *= 2;
-        s->data = (Token*)realloc(s->data, sizeof(Token) * s->capacity);
-        if (!s->data) { perror("realloc"); exit(1); }
-    }
-    s->data[s->size++] = t;
-}
-Token tokenstack_pop(TokenStack *s) {
-    if (s->size == 0) { Token t; t.type = TOKEN_NUMBER; strcpy(t.str, "0"); t.value = 0; return t; }
-    return s->data[--s->size];
-}
-Token tokenstack_peek(TokenStack *s) {
-    if (s->size == 0) { Token t; t.type = TOKEN_NUMBER; strcpy(t.str, "0"); t.value = 0; return t; }
-    return s->data[s->size-1];
-}
-int tokenstack_empty(TokenStack *s) { return s->size == 0; }
-void tokenstack_free(TokenStack *s) { free(s->data); s->data = NULL; s->size = s->capacity = 0; }
-
-int is_unary_operator(const TokenArray *tokens, int idx) {
-    // unary + or - when at start or after left paren, operator, or comma
-    if (tokens->data[idx].type != TOKEN_OPERATOR) return 0;
-    char op = tokens->data[idx].str[0];
-    if (!(op == '+' || op == '-')) return 0;
-    if (idx == 0) return 1;
-    TokenType prev = tokens->data[idx-1].type;
-    if (prev == TOKEN_OPERATOR || prev == TOKEN_PAREN_LEFT || prev == TOKEN_COMMA || prev == TOKEN_FUNCTION) return 1;
-    return 0;
-}
-
-int to_rpn(const TokenArray *in, TokenArray *out) {
-    TokenStack opstack;
-    tokenstack_init(&opstack);
-
-    for (int i = 0; i < in->size; ++i) {
-        Token t = in->data[i];
-        if (t.type == TOKEN_NUMBER || t.type == TOKEN_CONSTANT) {
-            token_array_push(out, t);
-        } else if (t.type == TOKEN_FUNCTION) {
-            tokenstack_push(&opstack, t);
-        } else if (t.type == TOKEN_COMMA) {
-            // pop until left paren encountered
-            int found = 0;
-            while (!tokenstack_empty(&opstack)) {
-                Token top = tokenstack_peek(&opstack);
-                if (top.type == TOKEN_PAREN_LEFT) { found = 1; break; }
-                token_array_push(out, tokenstack_pop(&opstack));
-            }
-            if (!found) { fprintf(stderr, "Error: misplaced comma or mismatched parentheses\n"); tokenstack_free(&opstack); return 0; }
-        } else if (t.type == TOKEN_OPERATOR) {
-            // handle unary + and -
-            int unary = is_unary_operator(in, i);
-            if (unary) {
-                // encode unary + as function "u+" and unary - as "u-"
-                Token uTok;
-                uTok.type = TOKEN_FUNCTION;
-                if (t.str[0] == '+') strncpy(uTok.str, "uplus", MAX_TOKEN_LEN-1);
-                else strncpy(uTok.str, "uminus", MAX_TOKEN_LEN-1);
-                tokenstack_push(&opstack, uTok);
-                continue;
-            }
-            char op = t.str[0];
-            while (!tokenstack_empty(&opstack)) {
-                Token top = tokenstack_peek(&opstack);
-                if (top.type == TOKEN_OPERATOR) {
-                    char topop = top.str[0];
-                    int p1 = op_precedence(topop);
-                    int p2 = op_precedence(op);
-                    if ((op_right_associative(op) && p2 < p1) || (!op_right_associative(op) && p2 <= p1)) {
-                        token_array_push(out, tokenstack_pop(&opstack));
-                        continue;
-                    }
-                } else if (top.type == TOKEN_FUNCTION) {
-                    // functions have higher precedence -> pop them
-                    token_array_push(out, tokenstack_pop(&opstack));
-                    continue;
-                }
-                break;
-            }
-            tokenstack_push(&opstack, t);
-        } else if (t.type == TOKEN_PAREN_LEFT) {
-            tokenstack_push(&opstack, t);
-        } else if (t.type == TOKEN_PAREN_RIGHT) {
-            int found_left = 0;
-            while (!tokenstack_empty(&opstack)) {
-                Token top = tokenstack_pop(&opstack);
-                if (top.type == TOKEN_PAREN_LEFT) { found_left = 1; break; }
-                token_array_push(out, top);
-            }
-            if (!found_left) { fprintf(stderr, "Error: mismatched parentheses\n"); tokenstack_free(&opstack); return 0; }
-            // after popping left paren, if top of stack is function, pop it into output
-            if (!tokenstack_empty(&opstack)) {
-                Token top = tokenstack_peek(&opstack);
-                if (top.type == TOKEN_FUNCTION) token_array_push(out, tokenstack_pop(&opstack));
-            }
-        } else {
-            fprintf(stderr, "Unknown token in parsing: %s\n", t.str);
-            tokenstack_free(&opstack);
-            return 0;
-        }
-    }
-
-    while (!tokenstack_empty(&opstack)) {
-        Token top = tokenstack_pop(&opstack);
-        if (top.type == TOKEN_PAREN_LEFT || top.type == TOKEN_PAREN_RIGHT) {
-            fprintf(stderr, "Error: mismatched parentheses\n");
-            tokenstack_free(&opstack);
-            return 0;
-        }
-        token_array_push(out, top);
-    }
-
-    tokenstack_free(&opstack);
-    return 1;
-}
-
-/* ---------- Evaluation of RPN ---------- */
-
-typedef struct {
-    double *data;
-    int size;
-    int capacity;
-} DoubleStack;
-
-void dstack_init(DoubleStack *s) {
-    s->capacity = STACK_INIT_CAP;
-    s->size = 0;
-    s->data = (double*)malloc(sizeof(double) * s->capacity);
-    if (!s->data) { perror("malloc"); exit(1); }
-}
-void dstack_push(DoubleStack *s, double v) {
-    if (s->size >= s->capacity) {
-        s->capacity *= 2;
-        s->data = (double*)realloc(s->data, sizeof(double) * s->capacity);
-        if (!s->data) { perror("realloc"); exit(1); }
-    }
-    s->data[s->size++] = v;
-}
-double dstack_pop(DoubleStack *s) {
-    if (s->size == 0) { return 0.0; }
-    return s->data[--s->size];
-}
-double dstack_peek(const DoubleStack *s) {
-    if (s->size == 0) return 0.0;
-    return s->data[s->size-1];
-}
-void dstack_free(DoubleStack *s) { free(s->data); s->data = NULL; s->size = s->capacity = 0; }
-
-long long ll_gcd(long long a, long long b) {
-    if (a < 0) a = -a;
-    if (b < 0) b = -b;
-    while (b) {
-        long long t = a % b;
-        a = b; b = t;
-    }
-    return a;
-}
-long long ll_lcm(long long a, long long b) {
-    if (a == 0 || b == 0) return 0;
-    return llabs(a / ll_gcd(a,b) * b);
-}
-
-double factorial_double(double x, int *err) {
-    // We'll support factorial only for non-negative integers in this implementation.
-    // If x is integer and >=0, compute; else set err.
-    *err = 0;
-    if (x < 0) { *err = 1; return 0.0; }
-    double xi = floor(x + 0.5);
-    if (fabs(x - xi) > 1e-9) { *err = 1; return 0.0; } // not an integer
-    if (xi > 170) { // factorial grows huge; beyond double
-        *err = 1;
-        return 0.0;
-    }
-    long long n = (long long)xi;
-    double res = 1.0;
-    for (long long i = 2; i <= n; ++i) res *= (double)i;
-    return res;
-}
-
-int eval_function_by_name(const char *name, DoubleStack *stack, double *out_val) {
-    // returns 1 on success, 0 on error
-    // functions use stack arguments: pop as needed (rightmost last).
-    if (str_eq_nocase(name, "uplus")) {
-        // unary plus: do nothing
-        double a = dstack_pop(stack);
-        dstack_push(stack, +a);
-        return 1;
-    } else if (str_eq_nocase(name, "uminus")) {
-        double a = dstack_pop(stack);
-        dstack_push(stack, -a);
-        return 1;
-    } else if (str_eq_nocase(name, "sin")) {
-        double a = dstack_pop(stack);
-        if (angle_mode == MODE_DEG) a = a * M_PI / 180.0;
-        dstack_push(stack, sin(a)); return 1;
-    } else if (str_eq_nocase(name, "cos")) {
-        double a = dstack_pop(stack);
-        if (angle_mode == MODE_DEG) a = a * M_PI / 180.0;
-        dstack_push(stack, cos(a)); return 1;
-    } else if (str_eq_nocase(name, "tan")) {
-        double a = dstack_pop(stack);
-        if (angle_mode == MODE_DEG) a = a * M_PI / 180.0;
-        dstack_push(stack, tan(a)); return 1;
-    } else if (str_eq_nocase(name, "asin")) {
-        double a = dstack_pop(stack);
-        double r = asin(a);
-        if (angle_mode == MODE_DEG) r = r * 180.0 / M_PI;
-        dstack_push(stack, r); return 1;
-    } else if (str_eq_nocase(name, "acos")) {
-        double a = dstack_pop(stack);
-        double r = acos(a);
-        if (angle_mode == MODE_DEG) r = r * 180.0 / M_PI;
-        dstack_push(stack, r); return 1;
-    } else if (str_eq_nocase(name, "atan")) {
-        double a = dstack_pop(stack);
-        double r = atan(a);
-        if (angle_mode == MODE_DEG) r = r * 180.0 / M_PI;
-        dstack_push(stack, r); return 1;
-    } else if (str_eq_nocase(name, "sinh")) {
-        double a = dstack_pop(stack); dstack_push(stack, sinh(a)); return 1;
-    } else if (str_eq_nocase(name, "cosh")) {
-        double a = dstack_pop(stack); dstack_push(stack, cosh(a)); return 1;
-    } else if (str_eq_nocase(name, "tanh")) {
-        double a = dstack_pop(stack); dstack_push(stack, tanh(a)); return 1;
-    } else if (str_eq_nocase(name, "sqrt")) {
-        double a = dstack_pop(stack);
-        if (a < 0) return 0;
-        dstack_push(stack, sqrt(a)); return 1;
-    } else if (str_eq_nocase(name, "cbrt")) {
-        double a = dstack_pop(stack); dstack_push(stack, cbrt(a)); return 1;
-    } else if (str_eq_nocase(name, "ln")) {
-        double a = dstack_pop(stack);
-        if (a <= 0) return 0;
-        dstack_push(stack, log(a)); return 1;
-    } else if (str_eq_nocase(name, "log")) {
-        double a = dstack_pop(stack);
-        if (a <= 0) return 0;
-        dstack_push(stack, log10(a)); return 1;
-    } else if (str_eq_nocase(name, "exp")) {
-        double a = dstack_pop(stack); dstack_push(stack, exp(a)); return 1;
-    } else if (str_eq_nocase(name, "pow")) {
-        double b = dstack_pop(stack); double a = dstack_pop(stack);
-        dstack_push(stack, pow(a, b)); return 1;
-    } else if (str_eq_nocase(name, "abs")) {
-        double a = dstack_pop(stack); dstack_push(stack, fabs(a)); return 1;
-    } else if (str_eq_nocase(name, "floor")) {
-        double a = dstack_pop(stack); dstack_push(stack, floor(a)); return 1;
-    } else if (str_eq_nocase(name, "ceil")) {
-        double a = dstack_pop(stack); dstack_push(stack, ceil(a)); return 1;
-    } else if (str_eq_nocase(name, "fact") || str_eq_nocase(name, "factorial")) {
-        double a = dstack_pop(stack);
-        int err = 0;
-        double f = factorial_double(a, &err);
-        if (err) return 0;
-        dstack_push(stack, f); return 1;
-    } else if (str_eq_nocase(name, "nCr")) {
-        double k = dstack_pop(stack);
-        double n = dstack_pop(stack);
-        long long ni = (long long)floor(n + 0.5);
-        long long ki = (long long)floor(k + 0.5);
-        if (ni < 0 || ki < 0 || ki > ni) return 0;
-        // compute nCk safely
-        double res = 1.0;
-        if (ki > ni - ki) ki = ni - ki;
-        for (long long i = 1; i <= ki; ++i) {
-            res = res * (ni - ki + i) / (double)i;
-        }
-        dstack_push(stack, res); return 1;
-    } else if (str_eq_nocase(name, "nPr")) {
-        double k = dstack_pop(stack);
-        double n = dstack_pop(stack);
-        long long ni = (long long)floor(n + 0.5);
-        long long ki = (long long)floor(k + 0.5);
-        if (ni < 0 || ki < 0 || ki > ni) return 0;
-        double res = 1.0;
-        for (long long i = 0; i < ki; ++i) res *= (double)(ni - i);
-        dstack_push(stack, res); return 1;
-    } else if (str_eq_nocase(name, "gcd")) {
-        double b = dstack_pop(stack); double a = dstack_pop(stack);
-        long long ai = (long long)llround(a);
-        long long bi = (long long)llround(b);
-        long long g = ll_gcd(ai, bi);
-        dstack_push(stack, (double)g); return 1;
-    } else if (str_eq_nocase(name, "lcm")) {
-        double b = dstack_pop(stack); double a = dstack_pop(stack);
-        long long ai = (long long)llround(a);
-        long long bi = (long long)llround(b);
-        long long l = ll_lcm(ai, bi);
-        dstack_push(stack, (double)l); return 1;
-    } else {
-        // Unknown function - try to treat as variable or error
-        return 0;
-    }
-    return 0;
-}
-
-int evaluate_rpn(const TokenArray *rpn, double *result) {
-    DoubleStack st;
-    dstack_init(&st);
-    for (int i = 0; i < rpn->size; ++i) {
-        Token t = rpn->data[i];
-        if (t.type == TOKEN_NUMBER) {
-            dstack_push(&st, t.value);
-        } else if (t.type == TOKEN_CONSTANT) {
-            if (str_eq_nocase(t.str, "pi")) dstack_push(&st, M_PI);
-            else if (str_eq_nocase(t.str, "e")) dstack_push(&st, M_E);
-            else if (str_eq_nocase(t.str, "M")) dstack_push(&st, memory_slot);
-            else {
-                fprintf(stderr, "Unknown constant: %s\n", t.str);
-                dstack_free(&st); return 0;
-            }
-        } else if (t.type == TOKEN_OPERATOR) {
-            char op = t.str[0];
-            double b = dstack_pop(&st);
-            double a = dstack_pop(&st);
-            double res = 0.0;
-            switch (op) {
-                case '+': res = a + b; break;
-                case '-': res = a - b; break;
-                case '*': res = a * b; break;
-                case '/':
-                    if (b == 0.0) { fprintf(stderr, "Math error: division by zero\n"); dstack_free(&st); return 0; }
-                    res = a / b; break;
-                case '%':
-                    if (b == 0.0) { fprintf(stderr, "Math error: modulo by zero\n"); dstack_free(&st); return 0; }
-                    res = fmod(a, b); break;
-                case '^':
-                    res = pow(a, b); break;
-                default:
-                    fprintf(stderr, "Unknown operator: %c\n", op);
-                    dstack_free(&st); return 0;
-            }
-            dstack_push(&st, res);
-        } else if (t.type == TOKEN_FUNCTION) {
-            if (!eval_function_by_name(t.str, &st, NULL)) {
-                fprintf(stderr, "Error evaluating function: %s\n", t.str);
-                dstack_free(&st); return 0;
-            }
-        } else {
-            fprintf(stderr, "Unexpected token in RPN evaluation: %s\n", t.str);
-            dstack_free(&st); return 0;
-        }
-    }
-
-    if (st.size != 1) {
-        fprintf(stderr, "Evaluation error: stack has %d elements after evaluation\n", st.size);
-        dstack_free(&st);
-        return 0;
-    }
-
-    *result = dstack_pop(&st);
-    dstack_free(&st);
-    return 1;
-}
-
-/* ---------- Command history ---------- */
-
-typedef struct {
-    char **entries;
-    int size;
-    int capacity;
-} History;
-
-void history_init(History *h) {
-    h->capacity = HISTORY_SIZE;
-    h->size = 0;
-    h->entries = (char**)malloc(sizeof(char*) * h->capacity);
-    for (int i = 0; i < h->capacity; i++) h->entries[i] = NULL;
-}
-void history_add(History *h, const char *entry) {
-    free(h->entries[h->size % h->capacity]);
-    h->entries[h->size % h->capacity] = strdup(entry);
-    h->size++;
-}
-void history_print(const History *h) {
-    for (int i = 0; i < h->size && i < h->capacity; i++) {
-        int idx = (h->size + i) % h->capacity;
-        printf("%d: %s\n", i+1, h->entries[idx]);
-    }
-}
-void history_free(History *h) {
-    for (int i = 0; i < h->capacity; i++) {
-        free(h->entries[i]);
-        h->entries[i] = NULL;
-    }
-    free(h->entries);
-    h->entries = NULL;
-    h->size = h->capacity = 0;
-}
-
-/* ---------- Main calculator logic ---------- */
-
-void print_help() {
-    printf("Big Calculator - Help:\n");
-    printf("Basic usage: <number> <operator> <number>  (e.g. 3 + 4)\n");
-    printf("Operators: + - * / ^ %%\n");
-    printf("Functions: sin cos tan asin acos atan sinh cosh tanh sqrt cbrt ln log exp pow abs floor ceil fact nCr nPr gcd lcm\n");
-    printf("Constants: pi e M (memory recall)\n");
-    printf("Angle mode: mode rad|deg (default is rad)\n");
-    printf("Memory: m+ <value>, m- <value>, mr (recall), mc (clear)\n");
-    printf("History: h (show), h <n> (show last n), !<n> (recall n), !! (repeat last)\n");
-    printf("Help: ? or help\n");
-}
-
-int main(int argc, char **argv) {
-    printf("Big Calculator - Type ? or help for help\n");
-
-    History history;
-    history_init(&history);
-
-    char line[8192];
-    while (1) {
-        printf("> ");
-        if (!fgets(line, sizeof(line), stdin)) break;
-        trim_trailing_newline(line);
-
-        if (str_eq_nocase(line, "exit") || str_eq_nocase(line, "quit")) break;
-
-        if (line[0] == '?') {
-            print_help();
-            continue;
-        }
-
-        if (str_eq_nocase(line, "mode rad")) {
-            angle_mode = MODE_RAD;
-            printf("Angle mode set to RADIANS\n");
-            continue;
-        }
-        if (str_eq_nocase(line, "mode deg")) {
-            angle_mode = MODE_DEG;
-            printf("Angle mode set to DEGREES\n");
-            continue;
-        }
-
-        if (strlen(line) > 1 && line[0] == 'm' && (line[1] == '+' || line[1] == '-')) {
-            // Memory operations
-            char op = line[1];
-            char *endptr;
-            double value = strtod(line+2, &endptr);
-            if (endptr == line+2 || *endptr != '\0') {
-                fprintf(stderr, "Invalid memory operation\n");
-                continue;
-            }
-            if (op == '+') memory_slot += value;
-            else memory_slot -= value;
-            printf("Memory slot %s: %.10g\n", (op == '+') ? "added to" : "subtracted from", fabs(value));
-            continue;
-        }
-
-        if (str_eq_nocase(line, "mr")) {
-            printf("Memory recall: %.10g\n", memory_slot);
-            continue;
-        }
-        if (str_eq_nocase(line, "mc")) {
-            memory_slot = 0.0;
-            printf("Memory cleared\n");
-            continue;
-        }
-
-        if (str_eq_nocase(line, "h")) {
-            history_print(&history);
-            continue;
-        }
-
-        // Tokenize the input expression
-        TokenArray tokens;
-        token_array_init(&tokens);
-        if (!tokenize_expression(line, &tokens)) {
-            fprintf(stderr, "Invalid expression: %s\n", line);
-            token_array_free(&tokens);
-            continue;
-        }
-
-        // Add to history
-        history_add(&history, line);
-
-        // Convert to RPN using shunting-yard
-        TokenArray rpn;
-        token_array_init(&rpn);
-        if (!to_rpn(&tokens, &rpn)) {
-            fprintf(stderr, "Error converting to RPN\n");
-            token_array_free(&tokens);
-            token_array_free(&rpn);
-            continue;
-        }
-
-        // Evaluate the RPN expression
-        double result = 0.0;
-        if (!evaluate_rpn(&rpn, &result)) {
-            fprintf(stderr, "Error evaluating expression\n");
-            token_array_free(&tokens);
-            token_array_free(&rpn);
-            continue;
-        }
-
-        printf("Result: %.10g\n", result);
-
-        token_array_free(&tokens);
-        token_array_free(&rpn);
-    }
-
-    history_free(&history);
-
-    printf("Goodbye!\n");
-    return 0;
-}
\ No newline at end of file
+/*
+  big_calculator.c
+  A large, feature-rich scientific calculator in C.
+  - Supports infix expressions, functions, constants.
+  - Implements shunting-yard to convert to RPN and then evaluates.
+  - Single-file. Compile with: gcc big_calculator.c -o big_calc -lm -pthread
+  - With -DCALC_LIBRARY the front ends are left out and what remains is
+    libcalc, whose API is calc.h (the Makefile builds both).
+
+  Notes:
+  - Uses math.h; link with -lm.
+  - Modest protections for invalid input; not bulletproof but robust.
+  - Angle mode is default RADIANS; use "mode deg" to switch to degrees.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(_MSC_VER)
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#ifndef M_E
+#define M_E 2.71828182845904523536
+#endif
+
+#include <limits.h>
+#include <float.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+#include "calc.h"
+
+#define MAX_TOKEN_LEN 128
+#define MAX_TOKENS 4096
+#define HISTORY_SIZE 256
+#define STACK_INIT_CAP 256
+
+typedef enum { TOKEN_NUMBER, TOKEN_OPERATOR, TOKEN_FUNCTION, TOKEN_PAREN_LEFT, TOKEN_PAREN_RIGHT, TOKEN_COMMA, TOKEN_CONSTANT, TOKEN_IDENTIFIER, TOKEN_UNARY } TokenType;
+
+/*
+  Tokens are 16 bytes and never copy text: the name or literal is the span
+  [offset, offset+len) of the line the TokenArray was built from.
+*/
+typedef struct {
+    unsigned char type;  // TokenType
+    char op;             // operator character, for TOKEN_OPERATOR and TOKEN_UNARY
+    unsigned short len;
+    unsigned int offset;
+    union {
+        double value;    // TOKEN_NUMBER
+        int id;          // FuncId (-1 if unknown) or ConstId
+    } u;
+} Token;
+
+typedef char token_size_check[sizeof(Token) == 16 ? 1 : -1];
+
+typedef enum { MODE_RAD, MODE_DEG } AngleMode;
+
+// How lines are evaluated: in doubles, exactly, exactly with big floats or
+// with fractions for the rest (see Exact evaluation).
+typedef enum { NUMBERS_FLOAT, NUMBERS_EXACT, NUMBERS_DIGITS, NUMBERS_RATIONAL } NumberMode;
+
+
+/* ---------- Arena allocator ---------- */
+
+/*
+  Scratch memory for one expression. Allocations bump a pointer inside one
+  block; a request that does not fit gets its own malloc'd overflow chunk.
+  arena_reset() drops the overflow and regrows the block to the high-water
+  mark, so a warmed-up arena serves later expressions without the heap.
+*/
+
+#define ARENA_ALIGN 16
+#define ARENA_INIT_SIZE (64 * 1024)
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+} ArenaChunk;
+
+typedef struct {
+    char *block;
+    size_t used;
+    size_t cap;
+    ArenaChunk *overflow;
+    size_t overflow_bytes;
+    unsigned long heap_allocs; // malloc calls made by this arena
+} Arena;
+
+void arena_init(Arena *a, size_t cap) {
+    a->block = (char*)malloc(cap);
+    if (!a->block) { perror("malloc"); exit(1); }
+    a->used = 0;
+    a->cap = cap;
+    a->overflow = NULL;
+    a->overflow_bytes = 0;
+    a->heap_allocs = 1;
+}
+
+void *arena_alloc(Arena *a, size_t n) {
+    n = (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (n <= a->cap - a->used) {
+        void *p = a->block + a->used;
+        a->used += n;
+        return p;
+    }
+    ArenaChunk *c = (ArenaChunk*)malloc(ARENA_ALIGN + n);
+    if (!c) { perror("malloc"); exit(1); }
+    c->next = a->overflow;
+    a->overflow = c;
+    a->overflow_bytes += n;
+    a->heap_allocs++;
+    return (char*)c + ARENA_ALIGN;
+}
+
+static void arena_drop_overflow(Arena *a) {
+    while (a->overflow) {
+        ArenaChunk *next = a->overflow->next;
+        free(a->overflow);
+        a->overflow = next;
+    }
+    a->overflow_bytes = 0;
+}
+
+void arena_reset(Arena *a) {
+    size_t high_water = a->used + a->overflow_bytes;
+    arena_drop_overflow(a);
+    a->used = 0;
+    if (high_water > a->cap) {
+        size_t cap = a->cap * 2;
+        if (cap < high_water) cap = high_water;
+        free(a->block);
+        a->block = (char*)malloc(cap);
+        if (!a->block) { perror("malloc"); exit(1); }
+        a->cap = cap;
+        a->heap_allocs++;
+    }
+}
+
+void arena_free(Arena *a) {
+    arena_drop_overflow(a);
+    free(a->block);
+    a->block = NULL;
+    a->used = a->cap = 0;
+}
+
+/* ---------- Executable memory ---------- */
+
+/*
+  Pages for machine code generated at run time (see JIT compiler). A block
+  is writable until exec_seal turns it executable and read-only, so no page
+  is ever both. Only x86-64 with mmap gets a JIT.
+*/
+
+#if defined(__x86_64__) && (defined(__unix__) || defined(__APPLE__))
+#define CALC_HAVE_JIT 1
+#include <sys/mman.h>
+
+typedef struct {
+    unsigned char *code; // NULL if nothing is mapped
+    size_t size;         // mapped bytes, whole pages
+} ExecBlock;
+
+// Maps at least size writable bytes; b->code is NULL if the system refuses.
+void exec_alloc(ExecBlock *b, size_t size) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    b->size = (size + page - 1) / page * page;
+    void *p = mmap(NULL, b->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    b->code = p == MAP_FAILED ? NULL : (unsigned char*)p;
+}
+
+// Makes the block executable; 0 if the system refuses.
+int exec_seal(ExecBlock *b) {
+    return mprotect(b->code, b->size, PROT_READ | PROT_EXEC) == 0;
+}
+
+void exec_free(ExecBlock *b) {
+    if (b->code) munmap(b->code, b->size);
+    b->code = NULL;
+    b->size = 0;
+}
+#endif
+
+/* ---------- Program cache ---------- */
+
+/*
+  Compiled programs for recently seen lines, so a repeated line skips the
+  tokenizer and parser. Keys are normalized source text (see
+  normalize_line); values are the compiled instructions as an opaque
+  image that compile_line copies back into the arena. Entries form a
+  chained hash table threaded on a most-recently-used list, and the least
+  recently used one is replaced when the cache is full. A capacity of 0
+  turns caching off. An entry that keeps being found also gets machine
+  code, made once and dropped with the entry.
+*/
+
+#define PROGRAM_CACHE_DEFAULT 256
+
+typedef struct {
+    char *data;     // key bytes followed by the program image, one malloc
+    size_t key_len;
+    size_t bytes;   // size of the program image
+    uint64_t hash;
+    int count;      // instructions in the image
+    int max_depth;
+    int integer;    // Program.integer
+    int prev, next; // recency list, -1 terminated
+    int chain;      // next entry in the same bucket, or -1
+    unsigned long uses; // lookups that found the entry
+#ifdef CALC_HAVE_JIT
+    ExecBlock jit;  // the program as machine code, once it has been used often
+#endif
+} CacheEntry;
+
+typedef struct {
+    CacheEntry *entries;
+    int *buckets;
+    unsigned bucket_mask;
+    int capacity;
+    int count;
+    int head, tail; // most and least recently used
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long heap_allocs; // malloc calls made for entries
+} ProgramCache;
+
+// Capacity given to every context calc_init sets up (--cache).
+static int program_cache_capacity = PROGRAM_CACHE_DEFAULT;
+
+void program_cache_init(ProgramCache *c, int capacity) {
+    memset(c, 0, sizeof(*c));
+    c->capacity = capacity > 0 ? capacity : 0;
+    c->head = c->tail = -1;
+    if (!c->capacity) return;
+    unsigned nb = 1;
+    while (nb < (unsigned)c->capacity) nb <<= 1;
+    c->entries = (CacheEntry*)malloc(sizeof(CacheEntry) * (size_t)c->capacity);
+    c->buckets = (int*)malloc(sizeof(int) * nb);
+    if (!c->entries || !c->buckets) { perror("malloc"); exit(1); }
+    for (unsigned i = 0; i < nb; ++i) c->buckets[i] = -1;
+    c->bucket_mask = nb - 1;
+}
+
+void program_cache_free(ProgramCache *c) {
+    for (int i = 0; i < c->count; ++i) {
+        free(c->entries[i].data);
+#ifdef CALC_HAVE_JIT
+        exec_free(&c->entries[i].jit);
+#endif
+    }
+    free(c->entries);
+    free(c->buckets);
+    memset(c, 0, sizeof(*c));
+}
+
+uint64_t cache_key_hash(const char *key, size_t len) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)key[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static void cache_unlink(ProgramCache *c, int i) {
+    CacheEntry *e = &c->entries[i];
+    if (e->prev >= 0) c->entries[e->prev].next = e->next; else c->head = e->next;
+    if (e->next >= 0) c->entries[e->next].prev = e->prev; else c->tail = e->prev;
+}
+
+static void cache_push_front(ProgramCache *c, int i) {
+    CacheEntry *e = &c->entries[i];
+    e->prev = -1;
+    e->next = c->head;
+    if (c->head >= 0) c->entries[c->head].prev = i;
+    c->head = i;
+    if (c->tail < 0) c->tail = i;
+}
+
+// The entry for key, made most recently used, or NULL. Counts a hit or miss.
+CacheEntry *program_cache_find(ProgramCache *c, const char *key, size_t len, uint64_t hash) {
+    if (!c->capacity) return NULL;
+    for (int i = c->buckets[hash & c->bucket_mask]; i >= 0; i = c->entries[i].chain) {
+        CacheEntry *e = &c->entries[i];
+        if (e->hash == hash && e->key_len == len && memcmp(e->data, key, len) == 0) {
+            if (c->head != i) { cache_unlink(c, i); cache_push_front(c, i); }
+            c->hits++;
+            e->uses++;
+            return e;
+        }
+    }
+    c->misses++;
+    return NULL;
+}
+
+// Adds key -> image, replacing the least recently used entry when full.
+void program_cache_store(ProgramCache *c, const char *key, size_t len, uint64_t hash,
+                         const void *image, size_t bytes, int count, int max_depth, int integer) {
+    if (!c->capacity) return;
+    int i;
+    if (c->count < c->capacity) {
+        i = c->count++;
+    } else {
+        i = c->tail;
+        cache_unlink(c, i);
+        int *link = &c->buckets[c->entries[i].hash & c->bucket_mask];
+        while (*link != i) link = &c->entries[*link].chain;
+        *link = c->entries[i].chain;
+        free(c->entries[i].data);
+#ifdef CALC_HAVE_JIT
+        exec_free(&c->entries[i].jit);
+#endif
+    }
+    CacheEntry *e = &c->entries[i];
+    size_t image_at = (len + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    e->data = (char*)malloc(image_at + bytes);
+    if (!e->data) { perror("malloc"); exit(1); }
+    c->heap_allocs++;
+    memcpy(e->data, key, len);
+    memcpy(e->data + image_at, image, bytes);
+    e->key_len = len;
+    e->bytes = bytes;
+    e->hash = hash;
+    e->count = count;
+    e->max_depth = max_depth;
+    e->integer = integer;
+    e->uses = 0;
+#ifdef CALC_HAVE_JIT
+    e->jit.code = NULL;
+    e->jit.size = 0;
+#endif
+    e->chain = c->buckets[hash & c->bucket_mask];
+    c->buckets[hash & c->bucket_mask] = i;
+    cache_push_front(c, i);
+}
+
+// The program image stored after an entry's key.
+const void *cache_entry_image(const CacheEntry *e) {
+    return e->data + ((e->key_len + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1));
+}
+
+/* ---------- Utility helpers ---------- */
+
+// Nanoseconds on a clock that only moves forward.
+uint64_t now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int str_eq_nocase(const char *a, const char *b) {
+    while (*a && *b) {
+        if (tolower((unsigned char)*a) != tolower((unsigned char)*b)) return 0;
+        a++; b++;
+    }
+    return *a == 0 && *b == 0;
+}
+
+void trim_trailing_newline(char *s) {
+    size_t n = strlen(s);
+    if (n == 0) return;
+    if (s[n-1] == '\n') s[n-1] = '\0';
+}
+
+/* ---------- Functions & operators metadata ---------- */
+
+int is_identifier_char(char c) {
+    return isalpha((unsigned char)c) || c == '_' || c == '$';
+}
+
+/* precedence: higher number = higher precedence */
+int op_precedence(char op) {
+    switch (op) {
+        case '+': case '-': return 2;
+        case '*': case '/': case '%': return 3;
+        case '^': return 4;
+        default: return 0;
+    }
+}
+int op_right_associative(char op) {
+    return (op == '^');
+}
+
+int is_operator_char(char c) {
+    return c == '+' || c == '-' || c == '*' || c == '/' || c == '^' || c == '%';
+}
+
+/* ---------- Evaluation helpers ---------- */
+
+static int ctz_u64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+// Stein's binary gcd: shifts and subtractions, no division.
+uint64_t gcd_u64(uint64_t a, uint64_t b) {
+    if (!a || !b) return a | b;
+    int shift = ctz_u64(a | b);
+    a >>= ctz_u64(a);
+    do {
+        b >>= ctz_u64(b);
+        if (a > b) { uint64_t t = a; a = b; b = t; }
+        b -= a;
+    } while (b);
+    return a << shift;
+}
+
+#define EXACT_INT_MAX (1LL << 53) // doubles hold every integer up to here
+
+// v as an int64_t if it is an integer that fits (and not -0).
+static int int_from_double(double v, int64_t *out) {
+    if (!(v >= -0x1p63 && v < 0x1p63)) return 0;
+    *out = (int64_t)v;
+    return (double)*out == v && !(v == 0.0 && signbit(v));
+}
+
+long long ll_gcd(long long a, long long b) {
+    uint64_t ua = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    uint64_t ub = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+    return (long long)gcd_u64(ua, ub);
+}
+long long ll_lcm(long long a, long long b) {
+    if (a == 0 || b == 0) return 0;
+    return llabs(a / ll_gcd(a,b) * b);
+}
+
+/* ---------- Built-in function kernels ---------- */
+
+// Kernels read their arguments leftmost first and return 1 on success,
+// 0 on a domain error. out may alias args. Angles are in radians; callers
+// convert for degree mode (see FuncInfo.angle).
+typedef int (*FuncKernel)(const double *args, double *out);
+
+static int fn_sin(const double *args, double *out) { *out = sin(args[0]); return 1; }
+static int fn_cos(const double *args, double *out) { *out = cos(args[0]); return 1; }
+static int fn_tan(const double *args, double *out) { *out = tan(args[0]); return 1; }
+static int fn_asin(const double *args, double *out) { *out = asin(args[0]); return 1; }
+static int fn_acos(const double *args, double *out) { *out = acos(args[0]); return 1; }
+static int fn_atan(const double *args, double *out) { *out = atan(args[0]); return 1; }
+static int fn_sinh(const double *args, double *out) { *out = sinh(args[0]); return 1; }
+static int fn_cosh(const double *args, double *out) { *out = cosh(args[0]); return 1; }
+static int fn_tanh(const double *args, double *out) { *out = tanh(args[0]); return 1; }
+static int fn_sqrt(const double *args, double *out) {
+    if (args[0] < 0) return 0;
+    *out = sqrt(args[0]); return 1;
+}
+static int fn_cbrt(const double *args, double *out) { *out = cbrt(args[0]); return 1; }
+static int fn_ln(const double *args, double *out) {
+    if (args[0] <= 0) return 0;
+    *out = log(args[0]); return 1;
+}
+static int fn_log(const double *args, double *out) {
+    if (args[0] <= 0) return 0;
+    *out = log10(args[0]); return 1;
+}
+static int fn_exp(const double *args, double *out) { *out = exp(args[0]); return 1; }
+static int fn_pow(const double *args, double *out) { *out = pow(args[0], args[1]); return 1; }
+static int fn_abs(const double *args, double *out) { *out = fabs(args[0]); return 1; }
+static int fn_floor(const double *args, double *out) { *out = floor(args[0]); return 1; }
+static int fn_ceil(const double *args, double *out) { *out = ceil(args[0]); return 1; }
+// Arguments that llround can take without overflowing (NaN fails too).
+static int fits_long_long(const double *args) {
+    return fabs(args[0]) < 0x1p63 && fabs(args[1]) < 0x1p63;
+}
+static int fn_gcd(const double *args, double *out) {
+    if (!fits_long_long(args)) return 0;
+    *out = (double)ll_gcd(llround(args[0]), llround(args[1])); return 1;
+}
+static int fn_lcm(const double *args, double *out) {
+    if (!fits_long_long(args)) return 0;
+    *out = (double)ll_lcm(llround(args[0]), llround(args[1])); return 1;
+}
+
+/* ---------- Vector math ---------- */
+
+/*
+  Array versions of the transcendental functions for paths that evaluate
+  many values at once. Each kernel is a branch-free loop that the compiler
+  vectorizes, cloned for AVX-512, AVX2 and SSE2 and dispatched at load
+  time. Lanes outside a kernel's fast range (non-finite input, overflow,
+  subnormal results, |x| >= 2^20 for sin/cos/tan, pow with a base that is
+  not a positive normal number) come out of the loop as NaN and a second
+  pass hands just those lanes to libm. Reductions and polynomials follow
+  fdlibm; pow carries log(x) as a double-double.
+
+  Maximum error against glibc's libm, as measured by --accuracy:
+    exp, ln, sin, cos, asin, acos, atan    1 ulp
+    log (base 10), tan, sinh, cosh         2 ulp
+    tanh, pow                              3 ulp
+  Results can differ in the last bit between the clones where AVX-512
+  contracts a multiply and add into an FMA.
+
+  out must not overlap the inputs.
+*/
+
+// ThreadSanitizer cannot run the clone resolvers, which run before it starts.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__) && !defined(__SANITIZE_THREAD__)
+#define CALC_SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define CALC_SIMD_CLONES
+#endif
+
+// A loop whose iterations are independent; the arrays it touches never overlap.
+#if defined(__GNUC__) && !defined(__clang__)
+#define SIMD_LOOP(i, n) _Pragma("GCC ivdep") for (i = 0; i < (n); ++i)
+#else
+#define SIMD_LOOP(i, n) for (i = 0; i < (n); ++i)
+#endif
+
+// Every lane is computed unconditionally and a loop's length is only known
+// at run time, so let GCC's -O2 cost model vectorize with a scalar tail.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("no-trapping-math", "vect-cost-model=cheap")
+#endif
+
+// The helpers must inline into the loops or those stay scalar.
+#if defined(__GNUC__)
+#define VM_INLINE static inline __attribute__((always_inline))
+#else
+#define VM_INLINE static inline
+#endif
+
+#define VM_SHIFT 0x1.8p52   // adding it rounds a double below 2^51 to an integer
+#define VM_INVLN2 1.44269504088896338700e+00
+#define VM_LN2HI 6.93147180369123816490e-01
+#define VM_LN2LO 1.90821492927058770002e-10
+#define VM_TWO_OVER_PI 6.36619772367581382433e-01
+#define VM_PIO2_1 1.57079632673412561417e+00    // first 33 bits of pi/2
+#define VM_PIO2_2 6.07710050630396597660e-11    // next 33 bits
+#define VM_PIO2_3 2.02226624871116645580e-21    // next 33 bits
+#define VM_PIO2_3T 8.47842766036889956997e-32   // pi/2 - (PIO2_1 + PIO2_2 + PIO2_3)
+#define VM_PIO2_HI 1.57079632679489655800e+00
+#define VM_PIO2_LO 6.12323399573676603587e-17
+#define VM_PIO4_HI 7.85398163397448278999e-01
+#define VM_PI 3.14159265358979311600e+00
+#define VM_TRIG_MAX 0x1p20
+#define VM_SIGN 0x8000000000000000ULL
+
+typedef void (*VmathFn)(const double *x, double *out, int n);
+
+VM_INLINE uint64_t vm_bits(double x) { uint64_t u; memcpy(&u, &x, sizeof u); return u; }
+VM_INLINE double vm_double(uint64_t u) { double x; memcpy(&x, &u, sizeof x); return x; }
+
+// The integer that VM_SHIFT rounding left in kd, as a two's complement value.
+VM_INLINE uint64_t vm_shift_int(double kd) { return vm_bits(kd) - vm_bits(VM_SHIFT); }
+
+// a * b = p + *err exactly (up to 2^-104 relative), without relying on FMA.
+VM_INLINE double vm_two_prod(double a, double b, double *err) {
+    double p = a * b;
+    double ah = vm_double(vm_bits(a) & 0xfffffffff8000000ULL), al = a - ah;
+    double bh = vm_double(vm_bits(b) & 0xfffffffff8000000ULL), bl = b - bh;
+    *err = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+    return p;
+}
+
+// a + b = s + *err exactly.
+VM_INLINE double vm_two_sum(double a, double b, double *err) {
+    double s = a + b;
+    double bb = s - a;
+    *err = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+// e^(x + xl) for x in [-708, 709]; xl is a small correction term.
+VM_INLINE double vm_exp_core(double x, double xl) {
+    const double P1 = 1.66666666666666019037e-01, P2 = -2.77777777770155933842e-03,
+                 P3 = 6.61375632143793436117e-05, P4 = -1.65339022054652515390e-06,
+                 P5 = 4.13813679705723846039e-08;
+    double kd = x * VM_INVLN2 + VM_SHIFT;
+    double k = kd - VM_SHIFT;
+    double hi = x - k * VM_LN2HI;
+    double lo = k * VM_LN2LO - xl;
+    double r = hi - lo;
+    double t = r * r;
+    double c = r - t * (P1 + t * (P2 + t * (P3 + t * (P4 + t * P5))));
+    double y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+    return y * vm_double((vm_shift_int(kd) + 1023) << 52);
+}
+
+// e^x - 1 for |x| <= 45, accurate near zero.
+VM_INLINE double vm_expm1_core(double x) {
+    double kd = x * VM_INVLN2 + VM_SHIFT;
+    double k = kd - VM_SHIFT;
+    double r = (x - k * VM_LN2HI) - k * VM_LN2LO;
+    // e^r - 1 by its Taylor series, |r| <= 0.347
+    double p = r + r * r * (1.0/2 + r * (1.0/6 + r * (1.0/24 + r * (1.0/120 + r * (1.0/720
+             + r * (1.0/5040 + r * (1.0/40320 + r * (1.0/362880 + r * (1.0/3628800
+             + r * (1.0/39916800 + r * (1.0/479001600 + r * (1.0/6227020800.0))))))))))));
+    double scale = vm_double((vm_shift_int(kd) + 1023) << 52);
+    return scale * p + (scale - 1.0);
+}
+
+/*
+  Splits a positive normal x into 2^k * (1 + f) with 1 + f in
+  [sqrt(2)/2, sqrt(2)); returns f and stores k.
+*/
+VM_INLINE double vm_log_reduce(double x, double *k) {
+    uint64_t u = vm_bits(x) + (0x3ff0000000000000ULL - 0x3fe6a09e00000000ULL);
+    *k = vm_double((u >> 52) | vm_bits(0x1p52)) - 0x1p52 - 1023.0;
+    return vm_double((u & 0x000fffffffffffffULL) + 0x3fe6a09e00000000ULL) - 1.0;
+}
+
+// fdlibm's log(1 + f) - f + f*f/2 for f from vm_log_reduce, with s = f / (2 + f).
+VM_INLINE double vm_log_poly(double s, double hfsq) {
+    const double Lg1 = 6.666666666666735130e-01, Lg2 = 3.999999999940941908e-01,
+                 Lg3 = 2.857142874366239149e-01, Lg4 = 2.222219843214978396e-01,
+                 Lg5 = 1.818357216161805012e-01, Lg6 = 1.531383769920937332e-01,
+                 Lg7 = 1.479819860511658591e-01;
+    double z = s * s, w = z * z;
+    double t1 = w * (Lg2 + w * (Lg4 + w * Lg6));
+    double t2 = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)));
+    return s * (hfsq + t2 + t1);
+}
+
+VM_INLINE int vm_log_ok(double x) { return x >= DBL_MIN && x <= DBL_MAX; }
+
+/*
+  Reduces |x| < VM_TRIG_MAX to r_hi + r_lo in [-pi/4, pi/4] with x = r +
+  n * pi/2, and returns n (only its low two bits matter). Every product
+  below is exact, so r keeps its accuracy even next to a multiple of pi/2.
+*/
+VM_INLINE uint64_t vm_rem_pio2(double x, double *r_hi, double *r_lo) {
+    double kd = x * VM_TWO_OVER_PI + VM_SHIFT;
+    double k = kd - VM_SHIFT;
+    double w = x - k * VM_PIO2_1;
+    double e1, e2;
+    double t = vm_two_sum(w, -(k * VM_PIO2_2), &e1);
+    double r = vm_two_sum(t, -(k * VM_PIO2_3), &e2);
+    double lo = (e1 + e2) - k * VM_PIO2_3T;
+    *r_hi = r + lo;
+    *r_lo = lo - (*r_hi - r);
+    return vm_shift_int(kd);
+}
+
+// fdlibm's __kernel_sin and __kernel_cos on x + y, |x + y| <= pi/4.
+VM_INLINE double vm_kernel_sin(double x, double y) {
+    const double S1 = -1.66666666666666324348e-01, S2 = 8.33333333332248946124e-03,
+                 S3 = -1.98412698298579493134e-04, S4 = 2.75573137070700676789e-06,
+                 S5 = -2.50507602534068634195e-08, S6 = 1.58969099521155010221e-10;
+    double z = x * x, w = z * z;
+    double r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+    double v = z * x;
+    return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+VM_INLINE double vm_kernel_cos(double x, double y) {
+    const double C1 = 4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03,
+                 C3 = 2.48015872894767294178e-05, C4 = -2.75573143513906633035e-07,
+                 C5 = 2.08757232129817482790e-09, C6 = -1.13596475577881948265e-11;
+    double z = x * x, w = z * z;
+    double r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+    double hz = 0.5 * z;
+    w = 1.0 - hz;
+    return w + (((1.0 - w) - hz) + (z * r - x * y));
+}
+
+/*
+  sqrt for 0 <= x <= 1 within an ulp or so, as plain arithmetic: GCC
+  keeps a libm call for sqrt (and the loop scalar) unless the whole file
+  is built with -fno-math-errno.
+*/
+VM_INLINE double vm_sqrt(double x) {
+    double y = vm_double(0x5fe6eb50c7b537a9ULL - (vm_bits(x) >> 1)); // ~1/sqrt(x)
+    y = y * (1.5 - 0.5 * x * y * y);
+    y = y * (1.5 - 0.5 * x * y * y);
+    y = y * (1.5 - 0.5 * x * y * y);
+    y = y * (1.5 - 0.5 * x * y * y);
+    double s = x * y;
+    return s + 0.5 * y * (x - s * s);
+}
+
+// fdlibm's rational approximation of (asin(x) - x) / x^3 in x*x, |x| <= 0.5.
+VM_INLINE double vm_asin_ratio(double t) {
+    const double pS0 = 1.66666666666666657415e-01, pS1 = -3.25565818622400915405e-01,
+                 pS2 = 2.01212532134862925881e-01, pS3 = -4.00555345006794114027e-02,
+                 pS4 = 7.91534994289814532176e-04, pS5 = 3.47933107596021167570e-05,
+                 qS1 = -2.40339491173441421878e+00, qS2 = 2.02094576023350569471e+00,
+                 qS3 = -6.88283971605453293030e-01, qS4 = 7.70381505559019352791e-02;
+    double p = t * (pS0 + t * (pS1 + t * (pS2 + t * (pS3 + t * (pS4 + t * pS5)))));
+    double q = 1.0 + t * (qS1 + t * (qS2 + t * (qS3 + t * qS4)));
+    return p / q;
+}
+
+// Hands the lanes a kernel left as NaN to libm.
+static void vm_fixup(const double *x, const double *y, double *out, int n, double (*f1)(double), double (*f2)(double, double)) {
+    int i;
+    uint64_t any = 0;
+    SIMD_LOOP(i, n) any |= vm_bits(out[i] - out[i]); // +0 unless NaN or infinite
+    if (!any) return;
+    for (i = 0; i < n; ++i)
+        if (out[i] != out[i]) out[i] = f2 ? f2(x[i], y[i]) : f1(x[i]);
+}
+
+CALC_SIMD_CLONES
+static void vmath_exp(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        double v = x[i];
+        int ok = v >= -708.0 && v <= 709.0;
+        double r = vm_exp_core(ok ? v : 0.0, 0.0);
+        out[i] = ok ? r : NAN;
+    }
+    vm_fixup(x, NULL, out, n, exp, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_log(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        int ok = vm_log_ok(x[i]);
+        double k, f = vm_log_reduce(ok ? x[i] : 1.0, &k);
+        double hfsq = 0.5 * f * f;
+        double r = vm_log_poly(f / (2.0 + f), hfsq) + k * VM_LN2LO - hfsq + f + k * VM_LN2HI;
+        out[i] = ok ? r : NAN;
+    }
+    vm_fixup(x, NULL, out, n, log, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_log10(const double *restrict x, double *restrict out, int n) {
+    const double ivln10hi = 4.34294481878168880939e-01, ivln10lo = 2.50829467116452752298e-11,
+                 log10_2hi = 3.01029995663611771306e-01, log10_2lo = 3.69423907715893078616e-13;
+    int i;
+    SIMD_LOOP(i, n) {
+        int ok = vm_log_ok(x[i]);
+        double k, f = vm_log_reduce(ok ? x[i] : 1.0, &k);
+        double hfsq = 0.5 * f * f;
+        double r = vm_log_poly(f / (2.0 + f), hfsq);
+        // f - hfsq split so that hi * ivln10hi is exact
+        double hi = vm_double(vm_bits(f - hfsq) & 0xffffffff00000000ULL);
+        double lo = f - hi - hfsq + r;
+        double val_hi = hi * ivln10hi;
+        double y = k * log10_2hi;
+        double val_lo = k * log10_2lo + (lo + hi) * ivln10lo + lo * ivln10hi;
+        double w = y + val_hi;
+        val_lo += (y - w) + val_hi;
+        out[i] = ok ? val_lo + w : NAN;
+    }
+    vm_fixup(x, NULL, out, n, log10, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_pow(const double *restrict x, const double *restrict y, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        int ok = vm_log_ok(x[i]);
+        double k, f = vm_log_reduce(ok ? x[i] : 1.0, &k);
+        // log(1 + f) = 2 atanh(s), s = f / (2 + f) carried as s + s_lo
+        double v = 2.0 + f;
+        double v_lo = f - (v - 2.0);
+        double s = f / v;
+        double pe, p = vm_two_prod(s, v, &pe);
+        double s_lo = (((f - p) - pe) - s * v_lo) / v;
+        double z = s * s;
+        double tail = s * z * (2.0/3 + z * (2.0/5 + z * (2.0/7 + z * (2.0/9 + z * (2.0/11 + z * (2.0/13
+                    + z * (2.0/15 + z * (2.0/17 + z * (2.0/19 + z * (2.0/21 + z * (2.0/23)))))))))));
+        // ln x = k ln2hi + 2s + (k ln2lo + 2 s_lo + tail) as lh + ll, each sum
+        // ordered by magnitude (|k ln2hi| >= |2s| unless k == 0)
+        double a = k * VM_LN2HI, b = 2.0 * s, c = k * VM_LN2LO + 2.0 * s_lo + tail;
+        double ab = a + b;
+        double lh = ab + c;
+        double ll = ((a - ab) + b) + ((ab - lh) + c);
+        // y * ln x as yh + ye; an infinite or NaN y fails the range check
+        double ye, yh = vm_two_prod(y[i], lh, &ye);
+        ye += y[i] * ll;
+        int in = yh >= -708.0 && yh <= 709.0;
+        double r = vm_exp_core(in ? yh : 0.0, in ? ye : 0.0);
+        out[i] = ok ? (in ? r : NAN) : NAN;
+    }
+    vm_fixup(x, y, out, n, NULL, pow);
+}
+
+// The shared sin/cos/tan loop: which = 0 sin, 1 cos, 2 tan.
+VM_INLINE double vm_trig(double x, int which) {
+    int ok = x > -VM_TRIG_MAX && x < VM_TRIG_MAX;
+    double hi, lo;
+    uint64_t q = vm_rem_pio2(ok ? x : 0.0, &hi, &lo);
+    uint64_t s = vm_bits(vm_kernel_sin(hi, lo)), c = vm_bits(vm_kernel_cos(hi, lo));
+    // quadrant selects as bit masks: SSE2 has no 64-bit integer compare
+    // cos(x) = sin(x + pi/2), tan(x) = -cos(r) / sin(r) in odd quadrants
+    uint64_t n = q + (which == 1);
+    uint64_t odd = 0 - (n & 1);
+    double r = vm_double(((s & ~odd) | (c & odd)) ^ ((n & 2) << 62));
+    if (which == 2)
+        r = vm_double(((s & ~odd) | (c & odd)) ^ (odd << 63)) / vm_double((c & ~odd) | (s & odd));
+    r = which != 1 && x == 0.0 ? x : r; // keep the sign of zero
+    return ok ? r : NAN;
+}
+
+CALC_SIMD_CLONES
+static void vmath_sin(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) out[i] = vm_trig(x[i], 0);
+    vm_fixup(x, NULL, out, n, sin, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_cos(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) out[i] = vm_trig(x[i], 1);
+    vm_fixup(x, NULL, out, n, cos, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_tan(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) out[i] = vm_trig(x[i], 2);
+    vm_fixup(x, NULL, out, n, tan, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_asin(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        double v = x[i], ax = fabs(v);
+        int ok = ax < 1.0;
+        // |x| < 0.5: x + x * R(x^2)
+        double small = v + v * vm_asin_ratio(v * v);
+        // otherwise asin(|x|) = pi/2 - 2 asin(sqrt((1 - |x|) / 2))
+        double t = ok ? (1.0 - ax) * 0.5 : 0.25;
+        double r = vm_asin_ratio(t);
+        double s = vm_sqrt(t);
+        double near_one = VM_PIO2_HI - (2.0 * (s + s * r) - VM_PIO2_LO);
+        double w = vm_double(vm_bits(s) & 0xffffffff00000000ULL);
+        double c = (t - w * w) / (s + w);
+        double p = 2.0 * s * r - (VM_PIO2_LO - 2.0 * c);
+        double mid = VM_PIO4_HI - (p - (VM_PIO4_HI - 2.0 * w));
+        double big = ax >= 0.975 ? near_one : mid;
+        big = v < 0 ? -big : big;
+        out[i] = !ok ? NAN : ax < 0.5 ? small : big;
+    }
+    vm_fixup(x, NULL, out, n, asin, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_acos(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        double v = x[i];
+        int ok = fabs(v) < 1.0;
+        double small = VM_PIO2_HI - (v - (VM_PIO2_LO - v * vm_asin_ratio(v * v)));
+        // x < -0.5: pi - 2 asin(sqrt((1 + x) / 2))
+        double zn = ok ? (1.0 + v) * 0.5 : 0.25;
+        double sn = vm_sqrt(zn);
+        double neg = VM_PI - 2.0 * (sn + (vm_asin_ratio(zn) * sn - VM_PIO2_LO));
+        // x > 0.5: 2 asin(sqrt((1 - x) / 2)), with sqrt split as df + c
+        double zp = ok ? (1.0 - v) * 0.5 : 0.25;
+        double sp = vm_sqrt(zp);
+        double df = vm_double(vm_bits(sp) & 0xffffffff00000000ULL);
+        double c = (zp - df * df) / (sp + df);
+        double pos = 2.0 * (df + (vm_asin_ratio(zp) * sp + c));
+        out[i] = !ok ? NAN : v < -0.5 ? neg : v > 0.5 ? pos : small;
+    }
+    vm_fixup(x, NULL, out, n, acos, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_atan(const double *restrict x, double *restrict out, int n) {
+    const double aT0 = 3.33333333333329318027e-01, aT1 = -1.99999999998764832476e-01,
+                 aT2 = 1.42857142725034663711e-01, aT3 = -1.11111104054623557880e-01,
+                 aT4 = 9.09088713343650656196e-02, aT5 = -7.69187620504482999495e-02,
+                 aT6 = 6.66107313738753120669e-02, aT7 = -5.83357013379057348645e-02,
+                 aT8 = 4.97687799461593236017e-02, aT9 = -3.65315727442169155270e-02,
+                 aT10 = 1.62858201153657823623e-02;
+    int i;
+    SIMD_LOOP(i, n) {
+        double w = x[i], ax = fabs(w);
+        // atan(|x|) = atan(c) + atan((|x| - c) / (1 + c|x|)) for c in {0, 0.5, 1, 1.5, inf},
+        // the quotient written as (p|x| - q) / (u + v|x|)
+        double p = 0.0, q = 1.0, u = 0.0, v = 1.0;
+        double hi = 1.57079632679489655800e+00, lo = 6.12323399573676603587e-17;
+        int b3 = ax < 2.4375, b2 = ax < 1.1875, b1 = ax < 0.6875, b0 = ax < 0.4375;
+        p = b3 ? 1.0 : p; q = b3 ? 1.5 : q; u = b3 ? 1.0 : u; v = b3 ? 1.5 : v;
+        hi = b3 ? 9.82793723247329054082e-01 : hi; lo = b3 ? 1.39033110312309984516e-17 : lo;
+        q = b2 ? 1.0 : q; v = b2 ? 1.0 : v;
+        hi = b2 ? 7.85398163397448278999e-01 : hi; lo = b2 ? 3.06161699786838301793e-17 : lo;
+        p = b1 ? 2.0 : p; u = b1 ? 2.0 : u;
+        hi = b1 ? 4.63647609000806093515e-01 : hi; lo = b1 ? 2.26987774529616870924e-17 : lo;
+        p = b0 ? 1.0 : p; q = b0 ? 0.0 : q; u = b0 ? 1.0 : u; v = b0 ? 0.0 : v;
+        double t = (p * ax - q) / (u + v * ax);
+        double z = t * t, zz = z * z;
+        double s1 = z * (aT0 + zz * (aT2 + zz * (aT4 + zz * (aT6 + zz * (aT8 + zz * aT10)))));
+        double s2 = zz * (aT1 + zz * (aT3 + zz * (aT5 + zz * (aT7 + zz * aT9))));
+        double r = b0 ? t - t * (s1 + s2) : hi - ((t * (s1 + s2) - lo) - t);
+        out[i] = vm_double(vm_bits(r) ^ (vm_bits(w) & VM_SIGN));
+    }
+    vm_fixup(x, NULL, out, n, atan, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_sinh(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        double v = x[i], ax = fabs(v);
+        int ok = ax <= 709.0;
+        double h = v < 0 ? -0.5 : 0.5;
+        double t = vm_expm1_core(ax < 22.0 ? ax : 0.0);
+        double r = ax < 1.0 ? h * (2.0 * t - t * t / (t + 1.0)) : h * (t + t / (t + 1.0));
+        double big = h * vm_exp_core(ok ? ax : 0.0, 0.0);
+        out[i] = !ok ? NAN : ax < 0x1p-28 ? v : ax < 22.0 ? r : big;
+    }
+    vm_fixup(x, NULL, out, n, sinh, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_cosh(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        double ax = fabs(x[i]);
+        int ok = ax <= 709.0;
+        double t = vm_expm1_core(ax < 0.3465735902799726 ? ax : 0.0);
+        double w = 1.0 + t;
+        double small = 1.0 + (t * t) / (w + w);
+        double e = vm_exp_core(ok ? ax : 0.0, 0.0);
+        double mid = 0.5 * e + 0.5 / e;
+        out[i] = !ok ? NAN : ax < 0.3465735902799726 ? small : ax < 22.0 ? mid : 0.5 * e;
+    }
+    vm_fixup(x, NULL, out, n, cosh, NULL);
+}
+
+CALC_SIMD_CLONES
+static void vmath_tanh(const double *restrict x, double *restrict out, int n) {
+    int i;
+    SIMD_LOOP(i, n) {
+        double v = x[i], ax = fabs(v);
+        int ok = ax == ax;
+        double a = ax < 22.0 ? ax : 0.0;
+        double t = vm_expm1_core(ax >= 1.0 ? 2.0 * a : -2.0 * a);
+        double z = ax >= 1.0 ? 1.0 - 2.0 / (t + 2.0) : -t / (t + 2.0);
+        z = ax < 0x1p-55 ? ax : ax < 22.0 ? z : 1.0;
+        out[i] = ok ? vm_double(vm_bits(z) ^ (vm_bits(v) & VM_SIGN)) : NAN;
+    }
+    vm_fixup(x, NULL, out, n, tanh, NULL);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+
+/*
+  Column kernels for the function table: the vmath routines with the
+  scalar kernels' signature shape. x and y hold n arguments; out must not
+  overlap them.
+*/
+typedef void (*VecKernel)(const double *x, const double *y, double *out, int n);
+
+static void vfn_sin(const double *x, const double *y, double *out, int n) { (void)y; vmath_sin(x, out, n); }
+static void vfn_cos(const double *x, const double *y, double *out, int n) { (void)y; vmath_cos(x, out, n); }
+static void vfn_tan(const double *x, const double *y, double *out, int n) { (void)y; vmath_tan(x, out, n); }
+static void vfn_asin(const double *x, const double *y, double *out, int n) { (void)y; vmath_asin(x, out, n); }
+static void vfn_acos(const double *x, const double *y, double *out, int n) { (void)y; vmath_acos(x, out, n); }
+static void vfn_atan(const double *x, const double *y, double *out, int n) { (void)y; vmath_atan(x, out, n); }
+static void vfn_sinh(const double *x, const double *y, double *out, int n) { (void)y; vmath_sinh(x, out, n); }
+static void vfn_cosh(const double *x, const double *y, double *out, int n) { (void)y; vmath_cosh(x, out, n); }
+static void vfn_tanh(const double *x, const double *y, double *out, int n) { (void)y; vmath_tanh(x, out, n); }
+static void vfn_ln(const double *x, const double *y, double *out, int n) { (void)y; vmath_log(x, out, n); }
+static void vfn_log(const double *x, const double *y, double *out, int n) { (void)y; vmath_log10(x, out, n); }
+static void vfn_exp(const double *x, const double *y, double *out, int n) { (void)y; vmath_exp(x, out, n); }
+static void vfn_pow(const double *x, const double *y, double *out, int n) { vmath_pow(x, y, out, n); }
+
+/* ---------- Factorials and binomials ---------- */
+
+/*
+  fact, nCr and nPr in constant time. n! for n <= 1024 is stored as an
+  unevaluated sum hi + lo that carries about 106 bits, times a power of
+  two, so quotients of table entries are almost always correctly rounded;
+  larger counts go through Stirling's series in log space. Non-integer
+  factorials are the gamma function.
+*/
+#define FACT_MAX 170         // the largest n! that fits a double
+#define FACT_TABLE_MAX 1024
+#define PRODUCT_MAX 16       // up to here nCr and nPr of large n multiply out
+
+typedef struct { double hi, lo; } DoubleDouble;
+
+// n! = (hi + lo) * 2^exp, 1 <= hi < 2 and hi correctly rounded.
+static const struct { DoubleDouble mant; int exp; } fact_table[FACT_TABLE_MAX + 1] = {
+    {{0x1.0000000000000p+0, 0x0.0p+0}, 0},
+    {{0x1.0000000000000p+0, 0x0.0p+0}, 0},
+    {{0x1.0000000000000p+0, 0x0.0p+0}, 1},
+    {{0x1.8000000000000p+0, 0x0.0p+0}, 2},
+    {{0x1.8000000000000p+0, 0x0.0p+0}, 4},
+    {{0x1.e000000000000p+0, 0x0.0p+0}, 6},
+    {{0x1.6800000000000p+0, 0x0.0p+0}, 9},
+    {{0x1.3b00000000000p+0, 0x0.0p+0}, 12},
+    {{0x1.3b00000000000p+0, 0x0.0p+0}, 15},
+    {{0x1.6260000000000p+0, 0x0.0p+0}, 18},
+    {{0x1.baf8000000000p+0, 0x0.0p+0}, 21},
+    {{0x1.308a800000000p+0, 0x0.0p+0}, 25},
+    {{0x1.c8cfc00000000p+0, 0x0.0p+0}, 28},
+    {{0x1.7328cc0000000p+0, 0x0.0p+0}, 32},
+    {{0x1.44c3b28000000p+0, 0x0.0p+0}, 36},
+    {{0x1.3077775800000p+0, 0x0.0p+0}, 40},
+    {{0x1.3077775800000p+0, 0x0.0p+0}, 44},
+    {{0x1.437eeecd80000p+0, 0x0.0p+0}, 48},
+    {{0x1.6beecca730000p+0, 0x0.0p+0}, 52},
+    {{0x1.b02b930689000p+0, 0x0.0p+0}, 56},
+    {{0x1.0e1b3be415a00p+0, 0x0.0p+0}, 61},
+    {{0x1.6283be9b5c620p+0, 0x0.0p+0}, 65},
+    {{0x1.e77526159f06cp+0, 0x0.0p+0}, 69},
+    {{0x1.5e5c335f8a4cep+0, -0x1.8000000000000p-54}, 74},
+    {{0x1.06c52687a7b9ap+0, 0x1.c000000000000p-55}, 79},
+    {{0x1.9a940c33f6121p+0, -0x1.1000000000000p-57}, 83},
+    {{0x1.4d9849ea37eebp+0, -0x1.b740000000000p-55}, 88},
+    {{0x1.19787e5d9f316p+0, 0x1.9ac4000000000p-56}, 93},
+    {{0x1.ec92dd23d6967p+0, -0x1.4c4a400000000p-54}, 97},
+    {{0x1.be6518687a785p+0, 0x1.96e5b00000000p-57}, 102},
+    {{0x1.a27ec6e1f2d0dp+0, -0x1.1051156000000p-54}, 107},
+    {{0x1.956ad0aae33a4p+0, 0x1.5831734b00000p-54}, 112},
+    {{0x1.956ad0aae33a4p+0, 0x1.5831734b00000p-54}, 117},
+    {{0x1.a21627303a541p+0, 0x1.e2f2fee558000p-54}, 122},
+    {{0x1.bc3789a33df96p+0, -0x1.beddd12c52800p-54}, 127},
+    {{0x1.e5dcbe8a8bc8cp+0, -0x1.a8c29cc87a3c0p-54}, 132},
+    {{0x1.114c2b2deea0fp+0, -0x1.eeed7830c4c1cp-54}, 138},
+    {{0x1.3c0011ed1bea1p+0, -0x1.b88525f0c7001p-55}, 143},
+    {{0x1.774015499125fp+0, -0x1.163c3a1bd8a02p-56}, 148},
+    {{0x1.c95619f1a8e64p+0, -0x1.34c659b47c00dp-54}, 153},
+    {{0x1.1dd5d037098fep+0, 0x1.3f0407ef327f8p-54}, 159},
+    {{0x1.6e39f2c684406p+0, -0x1.4e85abab0e994p-55}, 164},
+    {{0x1.e0ac0ea48d948p+0, -0x1.5b87b8a841949p-54}, 169},
+    {{0x1.42f399d68f1fcp+0, 0x1.2d019fdde7e06p-55}, 175},
+    {{0x1.bc0ef38704cbbp+0, -0x1.310ee2177095cp-54}, 180},
+    {{0x1.383a833aef5f3p+0, 0x1.1981890784d6bp-54}, 186},
+    {{0x1.c0d41ca4b818ep+0, -0x1.2b55cb05310b6p-54}, 191},
+    {{0x1.499bc508f7324p+0, 0x1.10b3fba0bfeeap-56}, 197},
+    {{0x1.ee69a78d72cb6p+0, 0x1.990df9711fe5fp-56}, 202},
+    {{0x1.7a88e4484be3bp+0, 0x1.ae4bacbea71b0p-54}, 208},
+    {{0x1.27baf2587b49ep+0, 0x1.b02b1ef4f28d2p-54}, 214},
+    {{0x1.d751f23d047dcp+0, 0x1.f0c4b9566290ep-54}, 219},
+    {{0x1.7ef294d193a63p+0, 0x1.273fad2c602b7p-55}, 225},
+    {{0x1.3d20e33d8e45ap+0, 0x1.a90176d17f47fp-56}, 231},
+    {{0x1.0b93bfbbf00acp+0, 0x1.9a64f1030d92cp-58}, 237},
+    {{0x1.cbe5f18b04928p+0, -0x1.53ea281c2c0acp-54}, 242},
+    {{0x1.92693359a4003p+0, -0x1.296ce318a6896p-54}, 248},
+    {{0x1.6665b1bbd6102p+0, 0x1.a71b05be0badap-54}, 254},
+    {{0x1.44cc291239feap+0, 0x1.7ee0fa68752abp-55}, 260},
+    {{0x1.2b6c35dccd76cp+0, -0x1.be11324f67f94p-56}, 266},
+    {{0x1.18b5727f009f5p+0, 0x1.2ee7f06ac7433p-55}, 272},
+    {{0x1.0b8cf1210c97ep+0, -0x1.5fa5776d1d0a0p-54}, 278},
+    {{0x1.0330899804332p+0, -0x1.14a84bb1b421bp-54}, 284},
+    {{0x1.fe478ee34844ap+0, -0x1.82ad54176a894p-56}, 289},
+    {{0x1.fe478ee34844ap+0, -0x1.82ad54176a894p-56}, 295},
+    {{0x1.0320568f6ab2ep+0, -0x1.e117012cf9067p-54}, 302},
+    {{0x1.0b395943e6087p+0, -0x1.80fdc9b306750p-57}, 308},
+    {{0x1.17c0097314d0dp+0, 0x1.1d9eca1b12a7bp-54}, 314},
+    {{0x1.293c0a0a461dep+0, 0x1.bde2daf30f48bp-56}, 320},
+    {{0x1.4074bad313983p+0, 0x1.d82e2503831e9p-54}, 326},
+    {{0x1.5e7fac56dd6e8p+0, -0x1.b71b0f08512d1p-55}, 332},
+    {{0x1.84d5a3305da69p+0, 0x1.18ddfb52c5f20p-55}, 338},
+    {{0x1.b5705796695b6p+0, 0x1.1dfcdd5e8f582p-54}, 344},
+    {{0x1.f2f423e7902c4p+0, -0x1.672e4e0091fdfp-56}, 350},
+    {{0x1.207524c1df599p+0, 0x1.0c164eb9eae65p-54}, 357},
+    {{0x1.5209471331bd0p+0, -0x1.95d5dbbe20ba2p-54}, 363},
+    {{0x1.916b0466cb107p+0, -0x1.e1edf4f1c6dd0p-54}, 369},
+    {{0x1.e2f4c14bac4fcp+0, -0x1.27a49565c683dp-55}, 375},
+    {{0x1.264d25ca1d009p+0, 0x1.e5ebda7afd83dp-54}, 382},
+    {{0x1.6b473aa57bcccp+0, -0x1.3830de502f114p-54}, 388},
+    {{0x1.c619094edabffp+0, -0x1.863d15e43ad59p-54}, 394},
+    {{0x1.1f5bd7e3e66d7p+0, 0x1.021ab04b2589bp-55}, 401},
+    {{0x1.702dac9bff3c4p+0, -0x1.7aa6e70fdbf3dp-54}, 407},
+    {{0x1.dd7b3bda4f022p+0, -0x1.2b1073a891403p-54}, 413},
+    {{0x1.3958df4743d96p+0, 0x1.eef4d06582b79p-56}, 420},
+    {{0x1.a02a088aa61cbp+0, 0x1.84574931b466fp-54}, 426},
+    {{0x1.179c3dbd279b5p+0, -0x1.6b155ad29acadp-54}, 433},
+    {{0x1.7c1863ed21d72p+0, -0x1.bd9107764a6bcp-54}, 439},
+    {{0x1.0550c4b30743ep+0, 0x1.36b12b7ab357cp-56}, 446},
+    {{0x1.6b645188f61a6p+0, 0x1.4c03981da8598p-54}, 452},
+    {{0x1.ff0512a89a152p+0, -0x1.b46bc8592d089p-56}, 458},
+    {{0x1.6b4d9b43dd8b0p+0, 0x1.c4ddafc84cfdfp-55}, 465},
+    {{0x1.051fc798c73bfp+0, -0x1.5d4054d40454cp-54}, 472},
+    {{0x1.7b722e0a01831p+0, 0x1.a3f425df4da70p-57}, 478},
+    {{0x1.16a7d9cf591c4p+0, 0x1.68ce979ffa0d4p-58}, 485},
+    {{0x1.9da1274fc845fp+0, -0x1.e86d56ee88d45p-58}, 491},
+    {{0x1.3638dd7bd6347p+0, 0x1.d235bfd9a32c2p-55}, 498},
+    {{0x1.d62e2fafb0a78p+0, -0x1.759a24e892c4bp-57}, 504},
+    {{0x1.67fb5c8283404p+0, -0x1.478281108417ap-55}, 511},
+    {{0x1.166c698cf183bp+0, -0x1.ea777e9631525p-58}, 518},
+    {{0x1.b30964ec395dcp+0, 0x1.2034a946aa5dfp-55}, 524},
+    {{0x1.574569a265440p+0, -0x1.2e4b39371ec8fp-54}, 531},
+    {{0x1.118b502d68b23p+0, -0x1.e1c7e32fd9104p-55}, 538},
+    {{0x1.b83c3509147ecp+0, -0x1.9d76c6840558ap-57}, 544},
+    {{0x1.65b0eb1760a70p+0, -0x1.29fe1029688b0p-54}, 551},
+    {{0x1.256b20d92d490p+0, -0x1.74726941f7c20p-54}, 558},
+    {{0x1.e5f96e67b300ep+0, -0x1.a375f95509657p-56}, 564},
+    {{0x1.963e824aafa2cp+0, -0x1.87a9279b4576bp-54}, 571},
+    {{0x1.56c4bdef04315p+0, -0x1.94ed72d605385p-55}, 578},
+    {{0x1.23e389bd89920p+0, -0x1.246919e520390p-54}, 585},
+    {{0x1.f5af14bdc472fp+0, -0x1.f694a481cf61fp-54}, 591},
+    {{0x1.b30dd3fc905bap+0, 0x1.542b19576e291p-54}, 598},
+    {{0x1.7cac197cfe503p+0, 0x1.4d2db164031fap-57}, 605},
+    {{0x1.500fee805882dp+0, -0x1.433bb52cb6a7cp-54}, 612},
+    {{0x1.2b4e306a4ed48p+0, -0x1.9fc25ab7a55adp-55}, 619},
+    {{0x1.0ce83f7f82d2fp+0, -0x1.fac44ec07f47dp-54}, 626},
+    {{0x1.e764f3171d1e4p+0, 0x1.297c3143194dep-54}, 632},
+    {{0x1.bd824633209dbp+0, -0x1.50147af8aadedp-54}, 639},
+    {{0x1.9ab418b722116p+0, -0x1.a5d2e15d3d857p-54}, 646},
+    {{0x1.7dd36efa41ac2p+0, 0x1.1f57c9ed4337dp-56}, 653},
+    {{0x1.65f6380a9d916p+0, -0x1.e53b656321f75p-57}, 660},
+    {{0x1.5262c0fa08f37p+0, -0x1.095644baf6c38p-54}, 667},
+    {{0x1.42861fee50880p+0, 0x1.66338cfb999b6p-55}, 674},
+    {{0x1.35ece2af0162bp+0, 0x1.58358979c59b5p-55}, 681},
+    {{0x1.2c3d7b998957ap+0, -0x1.728c22d208919p-55}, 688},
+    {{0x1.25340ab3f01f9p+0, -0x1.2773680471788p-57}, 695},
+    {{0x1.209f3a89205f1p+0, 0x1.2e9532cdd026bp-56}, 702},
+    {{0x1.1e5dfc140e1e5p+0, 0x1.861c04341a433p-55}, 709},
+    {{0x1.1e5dfc140e1e5p+0, 0x1.861c04341a433p-55}, 716},
+    {{0x1.209ab80c363a9p+0, -0x1.36be1e1bec424p-58}, 723},
+    {{0x1.251d22ec67138p+0, -0x1.83b9916945bf3p-54}, 730},
+    {{0x1.2bfbd1bdf17dfp+0, -0x1.333fab46f586cp-56}, 737},
+    {{0x1.355bb04be109ep+0, -0x1.bcd9a8a12d32fp-56}, 744},
+    {{0x1.4171452ed7d44p+0, 0x1.e38bad910e121p-57}, 751},
+    {{0x1.5082946d09f23p+0, 0x1.fe8d8e6cf6aecp-55}, 758},
+    {{0x1.62e9b88b007d7p+0, 0x1.6a794c36ec2c5p-55}, 765},
+    {{0x1.79185413b0855p+0, -0x1.7f6f8f82d2888p-54}, 772},
+    {{0x1.939c09fd12eebp+0, -0x1.b265679a05561p-54}, 779},
+    {{0x1.b3243ac4d8695p+0, -0x1.91554ec837033p-56}, 786},
+    {{0x1.d88957d1c3026p+0, -0x1.34f4a8e35aef6p-54}, 793},
+    {{0x1.026b1c06b6a55p+0, -0x1.88f5cc5c55baep-54}, 801},
+    {{0x1.1ca9fcdf65321p+0, 0x1.ae4279c493204p-55}, 808},
+    {{0x1.3bcc9487d4439p+0, -0x1.42ae40e9ecc84p-55}, 815},
+    {{0x1.60ce8defbf238p+0, -0x1.fc3f5642ab43ep-54}, 822},
+    {{0x1.8ce85fadb707ep+0, 0x1.c438bef4ff53bp-54}, 829},
+    {{0x1.c19f3c62c956fp+0, 0x1.e09090a312799p-55}, 836},
+    {{0x1.006cd07056d39p+0, 0x1.c109393e8044bp-54}, 844},
+    {{0x1.267cf76103b70p+0, -0x1.227b4211c5892p-57}, 851},
+    {{0x1.54807e082c4b9p+0, 0x1.d6042f736e733p-54}, 858},
+    {{0x1.8c5d92b583900p+0, -0x1.d37c830e85b7bp-56}, 865},
+    {{0x1.d07da7ecb62ccp+0, -0x1.11eaf4ca8259ap-55}, 872},
+    {{0x1.11fa1e0c9f746p+0, 0x1.fe6e699c8d1d2p-55}, 880},
+    {{0x1.455903aefd5a3p+0, 0x1.af118eb4f3c95p-54}, 887},
+    {{0x1.84e466672ad5dp+0, 0x1.5b42fc944b66ap-54}, 894},
+    {{0x1.d3e2cb341f894p+0, 0x1.31cc97e26ab77p-54}, 901},
+    {{0x1.1b4a51088f182p+0, -0x1.adb24013d2c5ep-55}, 909},
+    {{0x1.594292c26e656p+0, 0x1.744ec1e7d71eep-55}, 916},
+    {{0x1.a77ba8027b686p+0, -0x1.2babb314d1121p-54}, 923},
+    {{0x1.055e51b1882a7p+0, -0x1.e8f3f886d9092p-54}, 931},
+    {{0x1.44ab297a8724bp+0, -0x1.2ebe1d6f0332cp-55}, 938},
+    {{0x1.95d5f3d928edep+0, -0x1.bd36d26561ffbp-54}, 945},
+    {{0x1.fe771cb7257b3p+0, -0x1.3ffef4a38543ap-54}, 952},
+    {{0x1.4307602be5b7fp+0, 0x1.3602a4c216acdp-56}, 960},
+    {{0x1.9b5b6477e6884p+0, -0x1.6a9c51186b900p-55}, 967},
+    {{0x1.07868c5ccfaf4p+0, 0x1.cbd9ee062d8bep-54}, 975},
+    {{0x1.53b370efa3b7fp+0, 0x1.c31bb34fdad94p-56}, 982},
+    {{0x1.b88cb676c8529p+0, -0x1.3b7c09ba38172p-55}, 989},
+    {{0x1.1f63cb077cadep+0, -0x1.6ae6f52c3d4b9p-54}, 997},
+    {{0x1.7932fa79d3a43p+0, -0x1.713c872841cc9p-56}, 1004},
+    {{0x1.f2054eb4d96ecp+0, 0x1.5e1f856336480p-54}, 1011},
+    {{0x1.4ab7864418639p+0, -0x1.bbf88b60efa1ap-57}, 1019},
+    {{0x1.b9d12d5ef8950p+0, 0x1.3770fae63fef0p-56}, 1026},
+    {{0x1.28d88a7bcf042p+0, -0x1.97600bb6a685bp-55}, 1034},
+    {{0x1.9134ab2b55cb9p+0, -0x1.0d2f9fa9ba217p-56}, 1041},
+    {{0x1.10b1cc5774506p+0, -0x1.35bd97a15720bp-54}, 1049},
+    {{0x1.74d3155f9105ep+0, -0x1.aef26a9d2a3d6p-55}, 1056},
+    {{0x1.00511eb1b3b40p+0, 0x1.ebdcab59f97afp-54}, 1064},
+    {{0x1.62702c71ba7efp+0, 0x1.504e49e4d5f7fp-55}, 1071},
+    {{0x1.ece3fdce27589p+0, -0x1.a629909ee339ap-54}, 1078},
+    {{0x1.58a36a772582fp+0, -0x1.fb2f101f18e15p-54}, 1086},
+    {{0x1.e4a5cdb78cc01p+0, 0x1.96c5d15445033p-54}, 1093},
+    {{0x1.56a93a72c683dp+0, -0x1.8cc45fed6697dp-59}, 1101},
+    {{0x1.e7389f1b32437p+0, -0x1.21a139c32c6f0p-54}, 1108},
+    {{0x1.5c4979bc70ee3p+0, 0x1.d3d6fed5ecf2ap-56}, 1116},
+    {{0x1.f4a99efee2566p+0, 0x1.e8214394e1273p-54}, 1123},
+    {{0x1.69ce93e631907p+0, 0x1.c6004eb4b5aa9p-57}, 1131},
+    {{0x1.06e017754002fp+0, 0x1.02770e4bd2ff8p-55}, 1139},
+    {{0x1.800b62454b845p+0, -0x1.3666111d39becp-55}, 1146},
+    {{0x1.1a085c2ae3753p+0, -0x1.c1f97a48bb341p-54}, 1154},
+    {{0x1.a070581753db0p+0, -0x1.81a97a3d91ab6p-56}, 1161},
+    {{0x1.35136161503c9p+0, -0x1.c78ef22e6c875p-54}, 1169},
+    {{0x1.cd32eb4f35ba5p+0, 0x1.1038b29eba0e2p-54}, 1176},
+    {{0x1.59e6307b684bcp+0, -0x1.9eabd047a3ab6p-57}, 1184},
+    {{0x1.04c68a8d09a12p+0, -0x1.3713f100c04c8p-54}, 1192},
+    {{0x1.8b3ce9fdc2983p+0, -0x1.6ef4728a46e7fp-55}, 1199},
+    {{0x1.2d0f663c4b39fp+0, -0x1.67c2199faa015p-54}, 1207},
+    {{0x1.ccff948c5330bp+0, -0x1.1b84dcf1f1484p-56}, 1214},
+    {{0x1.62c0ad4ffc047p+0, 0x1.a574b07e7454ep-54}, 1222},
+    {{0x1.1261060bdceb7p+0, 0x1.dbf081039bf34p-55}, 1230},
+    {{0x1.aa92d76671761p+0, -0x1.0c10176c638bdp-55}, 1237},
+    {{0x1.4d42b84808a44p+0, -0x1.48b6492656e2ap-54}, 1245},
+    {{0x1.05a962b08ec8fp+0, 0x1.1bd1c121cb902p-55}, 1253},
+    {{0x1.9cef4fbea1552p+0, -0x1.c031f66d55811p-56}, 1260},
+    {{0x1.4771c43c29ee8p+0, -0x1.03679e68b2cd5p-56}, 1268},
+    {{0x1.04eea85ff16a1p+0, -0x1.675b491db73ddp-55}, 1276},
+    {{0x1.a1e639a9a8a3ep+0, -0x1.b7c4198ccbbc8p-54}, 1283},
+    {{0x1.5047426685b3ep+0, -0x1.d1dfcc8f4bf1bp-54}, 1291},
+    {{0x1.0fe99eb0e61c7p+0, -0x1.e167eccfbcd0dp-55}, 1299},
+    {{0x1.b9dba1df75ee3p+0, -0x1.c91c1a325a6bbp-60}, 1306},
+    {{0x1.68bc4f276f477p+0, 0x1.462b403a7390cp-54}, 1314},
+    {{0x1.27ea78ee5948ap+0, -0x1.f1c2154034cd2p-56}, 1322},
+    {{0x1.e7cc8358e72dbp+0, 0x1.22de843e0a3d7p-54}, 1329},
+    {{0x1.93f55cc59f71ep+0, -0x1.9f1fba7c9f852p-54}, 1337},
+    {{0x1.501b26306da9cp+0, -0x1.81656629b0b9cp-54}, 1345},
+    {{0x1.18f6b1ec7babep+0, 0x1.7754f2649912fp-56}, 1353},
+    {{0x1.d7ee5edb37babp+0, 0x1.2d9c2bc93e477p-54}, 1360},
+    {{0x1.8e312008f7059p+0, -0x1.e1843b0e3373cp-54}, 1368},
+    {{0x1.5187a4279963bp+0, 0x1.5eb74f87b3174p-57}, 1376},
+    {{0x1.1f6d81c9b89eep+0, 0x1.1d55033731d04p-54}, 1384},
+    {{0x1.ebc55c0f21dfep+0, -0x1.47d08c7f90c5cp-54}, 1391},
+    {{0x1.a69d9b1d011c6p+0, 0x1.9231d097e5848p-60}, 1399},
+    {{0x1.6cd60ee809f58p+0, -0x1.0a4cafeecdeddp-56}, 1407},
+    {{0x1.3c61a0ed38a2ep+0, 0x1.06445fdbba5afp-54}, 1415},
+    {{0x1.13990b2ea455ep+0, 0x1.2c758f8067554p-54}, 1423},
+    {{0x1.e24bd3919f965p+0, 0x1.b9b764169aa49p-59}, 1430},
+    {{0x1.a7e4a4f2fd432p+0, -0x1.bfbc5d1082215p-55}, 1438},
+    {{0x1.7637d99e83954p+0, -0x1.ad1128a24b85bp-57}, 1446},
+    {{0x1.4bd385f78ead5p+0, 0x1.c071391f02e11p-54}, 1454},
+    {{0x1.278863507b126p+0, 0x1.7d935b7e7a41cp-56}, 1462},
+    {{0x1.085d00d6fe177p+0, 0x1.3554d0d8235cdp-56}, 1470},
+    {{0x1.db071d8250922p+0, -0x1.2857317740ea7p-57}, 1477},
+    {{0x1.aca36ba096b3ep+0, -0x1.696cd5b453727p-54}, 1485},
+    {{0x1.8474198988930p+0, -0x1.0f154356d73f7p-55}, 1493},
+    {{0x1.618dab3e2d4ddp+0, -0x1.bb5d2d2504f46p-54}, 1501},
+    {{0x1.432b7e86d5692p+0, -0x1.8d432b43d6876p-54}, 1509},
+    {{0x1.28a8ed25c5e78p+0, -0x1.54aca8b745ee4p-54}, 1517},
+    {{0x1.117bba9ed2716p+0, 0x1.45f0d4770b886p-54}, 1525},
+    {{0x1.fa5f178a11a5fp+0, 0x1.4b7fe9646b5a7p-54}, 1532},
+    {{0x1.d6c467e25c685p+0, -0x1.83cf1504a431ep-54}, 1540},
+    {{0x1.b7815cfc54456p+0, -0x1.7c1ca93eaa953p-55}, 1548},
+    {{0x1.9c09472c8f010p+0, 0x1.cdd290aaa00a1p-54}, 1556},
+    {{0x1.83e4bc00f29ffp+0, 0x1.f2c33a30a0a98p-54}, 1564},
+    {{0x1.6eae39b8e55b4p+0, -0x1.f08372fe081fcp-54}, 1572},
+    {{0x1.5c0f60ca81b59p+0, 0x1.98b339d8de49dp-54}, 1580},
+    {{0x1.4bbea84103a11p+0, 0x1.ab15a64567bccp-55}, 1588},
+    {{0x1.3d7d770638792p+0, 0x1.e05ddc103623dp-54}, 1596},
+    {{0x1.3116905ffa447p+0, -0x1.0265ce886bf99p-54}, 1604},
+    {{0x1.265cc54c9a780p+0, 0x1.0aafc5ba5fd23p-54}, 1612},
+    {{0x1.1d29df2235a44p+0, 0x1.025a478c8cd3ap-54}, 1620},
+    {{0x1.155dba08462ccp+0, 0x1.8b49cf97b4f9dp-54}, 1628},
+    {{0x1.0edd87ac1487cp+0, -0x1.9df9eb45d9440p-54}, 1636},
+    {{0x1.09933405b8211p+0, 0x1.7437eca507f4ap-55}, 1644},
+    {{0x1.056ce735a1409p+0, -0x1.6331e61b18566p-56}, 1652},
+    {{0x1.025ca080005cdp+0, -0x1.878428346386bp-55}, 1660},
+    {{0x1.0057e73f005c1p+0, 0x1.ab8ae01c05406p-55}, 1668},
+    {{0x1.feaf1eaf82b77p+0, -0x1.7882ab105b139p-56}, 1675},
+    {{0x1.feaf1eaf82b77p+0, -0x1.7882ab105b139p-56}, 1683},
+    {{0x1.0056e6e7191d1p+0, 0x1.7d81349125245p-55}, 1692},
+    {{0x1.025794b4e74f5p+0, -0x1.6f83c905b8916p-55}, 1700},
+    {{0x1.055e9b7306054p+0, -0x1.3de92a3064dd9p-54}, 1708},
+    {{0x1.097415e0d21d5p+0, -0x1.70676c9338803p-61}, 1716},
+    {{0x1.0ea35a4e3637ep+0, 0x1.42219a39379d9p-55}, 1724},
+    {{0x1.14fb2e6c0b7d3p+0, 0x1.d35cc7ad1dd69p-56}, 1732},
+    {{0x1.1c8e0cb0ffcdap+0, -0x1.cfdbaedd26589p-56}, 1740},
+    {{0x1.25727d1687cc1p+0, -0x1.3796a31503e2dp-54}, 1748},
+    {{0x1.2fc3837c52923p+0, 0x1.e175112f3efa3p-54}, 1756},
+    {{0x1.3ba1269f2dcbfp+0, -0x1.2778b849d1201p-55}, 1764},
+    {{0x1.4931134804c3bp+0, 0x1.cf545f2c0b8e3p-57}, 1772},
+    {{0x1.589f602f64fcep+0, -0x1.66bceb1778f9dp-55}, 1780},
+    {{0x1.6a1f7811cd1dbp+0, 0x1.1b85be7c2af0cp-54}, 1788},
+    {{0x1.7ded30a2c6555p+0, 0x1.13070ee6f549fp-54}, 1796},
+    {{0x1.944e167c4ff45p+0, 0x1.0f2478c67da94p-54}, 1804},
+    {{0x1.ad92f7e414f3ap+0, -0x1.9fe93fad1a7c3p-54}, 1812},
+    {{0x1.ca19ba5a3a57cp+0, 0x1.ac78431866c1ap-54}, 1820},
+    {{0x1.ea4f89749271fp+0, 0x1.55316fa03bf67p-55}, 1828},
+    {{0x1.0759b8541ca83p+0, 0x1.eb420d749034ep-55}, 1837},
+    {{0x1.1becbabaaee55p+0, 0x1.f8d19b40d5bc8p-54}, 1845},
+    {{0x1.3337260bff3e3p+0, -0x1.f9c53302d8bb1p-54}, 1853},
+    {{0x1.4d9de351072d8p+0, -0x1.d3c2565175b1fp-58}, 1861},
+    {{0x1.6b9712bd4ed29p+0, 0x1.8023733ed38bbp-54}, 1869},
+    {{0x1.8dad3c7f0e365p+0, 0x1.0426c60cb760dp-54}, 1877},
+    {{0x1.b48327677699ap+0, 0x1.231d1ec7ea928p-55}, 1885},
+    {{0x1.e0d87967f8a54p+0, -0x1.9f51ec17c79aap-55}, 1893},
+    {{0x1.09c7a71af7ef5p+0, 0x1.45381c006d960p-54}, 1902},
+    {{0x1.26d97d61eb0d8p+0, 0x1.31947e20f324dp-55}, 1910},
+    {{0x1.4840209602ae1p+0, -0x1.75e6d7caa8a80p-54}, 1918},
+    {{0x1.6eb7a46796fe7p+0, -0x1.4dbf28a3435d7p-57}, 1926},
+    {{0x1.9b1fe15022474p+0, -0x1.2b14a7478442ep-56}, 1934},
+    {{0x1.ce83dd7a26902p+0, 0x1.abe230f3e2cd3p-54}, 1942},
+    {{0x1.05116e8372c46p+0, -0x1.14f5a6bcacf66p-55}, 1951},
+    {{0x1.27bdbf30e8027p+0, 0x1.2641b91e4410fp-55}, 1959},
+    {{0x1.502cb05497bacp+0, 0x1.fb3e5ab6b3afap-54}, 1967},
+    {{0x1.7f72f9207d111p+0, -0x1.fad9c10f36176p-55}, 1975},
+    {{0x1.b6de97222f248p+0, 0x1.63e4c60997174p-55}, 1983},
+    {{0x1.f803a1914223fp+0, -0x1.ce8e8921f8f6ap-56}, 1991},
+    {{0x1.22661797319bbp+0, 0x1.debe6ffe7686fp-55}, 2000},
+    {{0x1.4fc60b46d15c0p+0, 0x1.f4c618bf1c860p-54}, 2008},
+    {{0x1.858cc31528e3cp+0, 0x1.44f9d2b5b8178p-54}, 2016},
+    {{0x1.c575db16a1992p+0, 0x1.b4959e8f1096bp-55}, 2024},
+    {{0x1.08d05371b75efp+0, -0x1.d2153fcee7a00p-56}, 2033},
+    {{0x1.365421c942e34p+0, -0x1.c461cd8ceedf1p-57}, 2041},
+    {{0x1.6ce0ebb9a3a53p+0, 0x1.360c80a8a591ep-56}, 2049},
+    {{0x1.ae715614ff0cep+0, 0x1.b857f8de6a430p-61}, 2057},
+    {{0x1.fd7824e2d9e04p+0, -0x1.67db3f81c300fp-55}, 2065},
+    {{0x1.2e7f55e6b15d2p+0, 0x1.152ae9257a1bcp-54}, 2074},
+    {{0x1.6865b557d9500p+0, -0x1.edc7e03a5984fp-54}, 2082},
+    {{0x1.aec992c301c19p+0, 0x1.b1c715fa40ff1p-54}, 2090},
+    {{0x1.024ddd7fed8d9p+0, 0x1.f431bf5b1bf1ep-55}, 2099},
+    {{0x1.36c5ae7de9ce5p+0, 0x1.7ce5ed1ccecf8p-54}, 2107},
+    {{0x1.771c9b9dfb361p+0, -0x1.207cf19874bf1p-55}, 2115},
+    {{0x1.c63ca4714e337p+0, 0x1.295459b8b1505p-54}, 2123},
+    {{0x1.13e9d5e2d3004p+0, 0x1.5a6af1febed12p-56}, 2132},
+    {{0x1.5044fcac71285p+0, -0x1.6736a4461dc47p-58}, 2140},
+    {{0x1.9b2458eed65a5p+0, -0x1.a7731ced9ba65p-54}, 2148},
+    {{0x1.f84a9514f2eacp+0, -0x1.fd8cc5edc3a81p-56}, 2156},
+    {{0x1.3641e2b863737p+0, -0x1.065f86f171f80p-54}, 2165},
+    {{0x1.7ef953db9ac28p+0, -0x1.b3ddea9208ae1p-54}, 2173},
+    {{0x1.da3abcd6eea2dp+0, 0x1.118d224ad01b9p-60}, 2181},
+    {{0x1.268a7b497e372p+0, -0x1.8ac32af67117ep-57}, 2190},
+    {{0x1.6f068fa09446bp+0, -0x1.5f499448b765ep-60}, 2198},
+    {{0x1.cac83388b9586p+0, -0x1.06dc6fe56b950p-54}, 2206},
+    {{0x1.1fa2844f3833ep+0, 0x1.6732cbd8aa0d1p-54}, 2215},
+    {{0x1.69ca6a6ba4b14p+0, 0x1.b3cde46685e47p-54}, 2223},
+    {{0x1.c87a6445d0cbbp+0, -0x1.d44671a54a218p-55}, 2231},
+    {{0x1.20dd73742e20ep+0, 0x1.87ab6c156716dp-55}, 2240},
+    {{0x1.6eb923927e8fcp+0, 0x1.09e501b95effbp-58}, 2248},
+    {{0x1.d2ffc34c8d2b1p+0, -0x1.2b5997f37c41ap-56}, 2256},
+    {{0x1.2a42593b64290p+0, -0x1.cbee230076f96p-62}, 2265},
+    {{0x1.7e25025418548p+0, 0x1.fdb2b6e327679p-54}, 2273},
+    {{0x1.eb1d8ffe1344ap+0, 0x1.5e155a13db483p-55}, 2281},
+    {{0x1.3c8a0dcec26b4p+0, -0x1.8e5c3cf133aa8p-55}, 2290},
+    {{0x1.99467fda5560ap+0, 0x1.ee775e9a11195p-54}, 2298},
+    {{0x1.0963b6e7935cbp+0, -0x1.9ebd315031d33p-55}, 2307},
+    {{0x1.5936b4eb3aaf9p+0, -0x1.a37c192550cfcp-55}, 2315},
+    {{0x1.c265600ae6911p+0, -0x1.99a5f46757b78p-54}, 2323},
+    {{0x1.26b1545721dbep+0, 0x1.71f7ea96621b7p-54}, 2332},
+    {{0x1.82c8beb25c70ap+0, -0x1.34d538353e780p-55}, 2340},
+    {{0x1.fd2a4308cbb04p+0, -0x1.1a32bbf85cefdp-57}, 2348},
+    {{0x1.5020e640ce776p+0, -0x1.87496fc2deab5p-54}, 2357},
+    {{0x1.bd1b90e7d1681p+0, -0x1.fc4c7dfe19b9ap-55}, 2365},
+    {{0x1.27944e39f10f1p+0, 0x1.ff3a9a2aa1756p-54}, 2374},
+    {{0x1.89b88c332e192p+0, -0x1.4306f0a536eebp-54}, 2382},
+    {{0x1.06fe45a62fcacp+0, 0x1.403a5d41a44e9p-54}, 2391},
+    {{0x1.605eaf51aa08bp+0, -0x1.05e39a1a19b57p-55}, 2399},
+    {{0x1.d97f3b95bc7bbp+0, -0x1.8ff4eb898945fp-54}, 2407},
+    {{0x1.3f0e3ba665815p+0, 0x1.f0feee93a600dp-55}, 2416},
+    {{0x1.af393c9ee530dp+0, -0x1.2823b8c638d18p-54}, 2424},
+    {{0x1.24414a95b0549p+0, 0x1.d52f2916a1f82p-56}, 2433},
+    {{0x1.8d48c1637bb2fp+0, 0x1.8f7306f6b10b5p-54}, 2441},
+    {{0x1.0ece17d24fd18p+0, -0x1.93702f81b0a39p-55}, 2450},
+    {{0x1.723dc49189207p+0, -0x1.d3c9b079a7bfdp-54}, 2458},
+    {{0x1.fba2b0838b037p+0, -0x1.d6188f6ccfffcp-58}, 2466},
+    {{0x1.5cffd95a6f926p+0, -0x1.a8661c5359e00p-55}, 2475},
+    {{0x1.e13ccab5b3d8dp+0, 0x1.cd9665e222245p-56}, 2483},
+    {{0x1.4cbb0827a158fp+0, -0x1.bc36c0e3a9994p-54}, 2492},
+    {{0x1.cd675c4ef4be5p+0, -0x1.33ffed7bb42f8p-54}, 2500},
+    {{0x1.40d1de2ee62c5p+0, 0x1.1d80cdffcb6fdp-58}, 2509},
+    {{0x1.bf64aad766fbdp+0, -0x1.031db60ba494dp-54}, 2517},
+    {{0x1.38d363749d021p+0, -0x1.92dc64a24140ep-58}, 2526},
+    {{0x1.b6b07078882dep+0, 0x1.f1619ddc0ecfcp-55}, 2534},
+    {{0x1.34740f14bfc04p+0, 0x1.0edc517f5d351p-54}, 2543},
+    {{0x1.b2f7a94442662p+0, 0x1.be95dd934df95p-59}, 2551},
+    {{0x1.33891aad42f23p+0, 0x1.31ddffad49311p-54}, 2560},
+    {{0x1.b41368d3aded7p+0, 0x1.adae4c55b6445p-57}, 2568},
+    {{0x1.3605cc867da6dp+0, -0x1.c7430add8835cp-56}, 2577},
+    {{0x1.ba06449bc126dp+0, 0x1.01b95a608932ep-54}, 2585},
+    {{0x1.3bfa7b0b5712cp+0, 0x1.90edfe6c084d6p-56}, 2594},
+    {{0x1.c4fc166541d3ep+0, 0x1.bf6297de6ff38p-55}, 2602},
+    {{0x1.45953018c7505p+0, -0x1.1f38916c0fc48p-54}, 2611},
+    {{0x1.d54c0a53b74acp+0, -0x1.9401133985748p-55}, 2619},
+    {{0x1.5323f3767f750p+0, 0x1.3c0b391b6e8edp-55}, 2628},
+    {{0x1.eb7d19d4bab69p+0, 0x1.4a0443c2c1390p-55}, 2636},
+    {{0x1.6518e4c48fa8ap+0, 0x1.9fe38c9dc031bp-54}, 2645},
+    {{0x1.0426a2a932a86p+0, -0x1.5a09741e26f79p-55}, 2654},
+    {{0x1.7c1071a330020p+0, -0x1.ecc4e7d20676ep-54}, 2662},
+    {{0x1.165e0b3b05a97p+0, 0x1.5c5720d6b10fdp-56}, 2671},
+    {{0x1.98da207eb050ep+0, -0x1.806007c4abf0cp-56}, 2679},
+    {{0x1.2d0c9ced48d39p+0, -0x1.0ac1ad6e1426bp-54}, 2688},
+    {{0x1.bc849fb65d886p+0, -0x1.c3c3f42913824p-55}, 2696},
+    {{0x1.490c2c397e3c7p+0, 0x1.ccb3961cc0788p-58}, 2705},
+    {{0x1.e86e11a55761bp+0, 0x1.babda92d2adb3p-54}, 2713},
+    {{0x1.6b75e82189863p+0, 0x1.a77622641c642p-54}, 2722},
+    {{0x1.0f2cf831059b2p+0, 0x1.5fe24751625d6p-55}, 2731},
+    {{0x1.95b4475157632p+0, -0x1.c0c63ba69eeb2p-54}, 2739},
+    {{0x1.3047357d018a5p+0, 0x1.5ed6a686119f4p-55}, 2748},
+    {{0x1.c99b1770ff510p+0, 0x1.9bd06837d0404p-54}, 2756},
+    {{0x1.58fdecac307c1p+0, 0x1.76781e9214007p-54}, 2765},
+    {{0x1.04c3ee6426a5dp+0, -0x1.5ef434e495e1bp-54}, 2774},
+    {{0x1.8b38f54fca934p+0, 0x1.bc15dfd58cd60p-54}, 2782},
+    {{0x1.2c46c6611f68ep+0, 0x1.59669e8fbf809p-54}, 2791},
+    {{0x1.c973d237f5d9dp+0, -0x1.439b54e204844p-55}, 2799},
+    {{0x1.5d57f309bc3fdp+0, 0x1.1a6f7056b2c68p-54}, 2808},
+    {{0x1.0b7756137420ep+0, -0x1.5f0ab7f67c801p-56}, 2817},
+    {{0x1.9a9a3323dd467p+0, 0x1.714622e5a6b7dp-54}, 2825},
+    {{0x1.3bf8a95a99474p+0, -0x1.d7d5072546b48p-54}, 2834},
+    {{0x1.e788ad4eca80ep+0, 0x1.17fa4df97be77p-54}, 2842},
+    {{0x1.7913b60af09fbp+0, 0x1.445cc277aea82p-57}, 2851},
+    {{0x1.2461c8a77b93dp+0, 0x1.3ae07b32733b5p-55}, 2860},
+    {{0x1.c69005f4621fdp+0, 0x1.3311ff10de4c8p-56}, 2868},
+    {{0x1.623d3ca3f277dp+0, -0x1.1e2cde6e96b0ep-54}, 2877},
+    {{0x1.14bfd760156d9p+0, 0x1.c06cf2399a45dp-54}, 2886},
+    {{0x1.b180805d8190bp+0, -0x1.9d955893c558ap-54}, 2894},
+    {{0x1.545de4c96aba9p+0, 0x1.4745bd73fa0d7p-54}, 2903},
+    {{0x1.0be7e7948981ep+0, -0x1.d0cd36c26d5cep-55}, 2912},
+    {{0x1.a6c9f9766900fp+0, -0x1.d83da6ad49689p-59}, 2920},
+    {{0x1.4e6ec3d42a0f4p+0, -0x1.2b58cc4581291p-55}, 2929},
+    {{0x1.0931d5493d5a1p+0, 0x1.79504b02714a3p-54}, 2938},
+    {{0x1.a59e3a17708a4p+0, -0x1.cc2158bf1de30p-54}, 2946},
+    {{0x1.4ffa164aadae2p+0, 0x1.51556d47b42f2p-54}, 2955},
+    {{0x1.0c6346cea7bdap+0, -0x1.9d0e84687120cp-55}, 2964},
+    {{0x1.add6ff66f8a5bp+0, -0x1.7589400f452e7p-55}, 2972},
+    {{0x1.590c160528990p+0, -0x1.8fb359d884119p-56}, 2981},
+    {{0x1.15a7b9b826ab2p+0, -0x1.a0d129261d231p-55}, 2990},
+    {{0x1.bfef969e16621p+0, -0x1.50716f627d019p-55}, 2998},
+    {{0x1.6a32bac9d4195p+0, -0x1.cc05dc88518a2p-54}, 3007},
+    {{0x1.25941e66976a8p+0, -0x1.7b7b0101f85dep-56}, 3016},
+    {{0x1.dd10b166b60d1p+0, -0x1.3453f0d199cc4p-55}, 3024},
+    {{0x1.848c187c2745ap+0, 0x1.91c344ba947a4p-56}, 3033},
+    {{0x1.3d365ffd5c0fep+0, -0x1.c5ffe538eb321p-54}, 3042},
+    {{0x1.0397ff8dd6d70p+0, -0x1.ff88ea1614797p-54}, 3051},
+    {{0x1.a9e55f44b478bp+0, -0x1.1cf28030e65d1p-56}, 3059},
+    {{0x1.5e331ad5fe654p+0, -0x1.0c93599a0d5aep-54}, 3068},
+    {{0x1.20a41f1e60ad7p+0, 0x1.2a28d2606fe19p-58}, 3077},
+    {{0x1.dcef2f6b31be9p+0, 0x1.22ca9739d58dep-54}, 3085},
+    {{0x1.8af61344c531dp+0, 0x1.819f8a77c9b2fp-55}, 3094},
+    {{0x1.47d942fe95afep+0, -0x1.15f388c7c8898p-54}, 3103},
+    {{0x1.10c7c4bdd28b5p+0, 0x1.c2f17cc718967p-56}, 3112},
+    {{0x1.c6fd35289e2e6p+0, 0x1.6028cb201602fp-56}, 3120},
+    {{0x1.7c57aa6ff43acp+0, 0x1.599886733499ap-54}, 3129},
+    {{0x1.3eaf744ece234p+0, -0x1.99b6cd61e1b52p-56}, 3138},
+    {{0x1.0ba55aae2f1fap+0, -0x1.a606219f4d23dp-54}, 3147},
+    {{0x1.c29b63ab41563p+0, 0x1.a2f75ac99a418p-55}, 3155},
+    {{0x1.7c331c187f20cp+0, -0x1.2f3fa5b2f2ec6p-54}, 3164},
+    {{0x1.41893942b7833p+0, -0x1.a1d54e8759c39p-56}, 3173},
+    {{0x1.108d51898d8e3p+0, 0x1.26e91837a274ap-55}, 3182},
+    {{0x1.cf20218cbb88ap+0, -0x1.0b87af65dbcf7p-57}, 3190},
+    {{0x1.8a615c91d7b25p+0, 0x1.f385ce94685a3p-54}, 3199},
+    {{0x1.509c19827a99bp+0, 0x1.fc59b4d1ab10fp-54}, 3208},
+    {{0x1.1ff589d29ee18p+0, 0x1.6e0bdaf5d5783p-58}, 3217},
+    {{0x1.edce0f582e74bp+0, 0x1.8e76ca8f72222p-55}, 3225},
+    {{0x1.a85d152fc7ec5p+0, -0x1.84c8f4f65cf55p-54}, 3234},
+    {{0x1.6d842cbfa7b30p+0, 0x1.6b20e901cceebp-54}, 3243},
+    {{0x1.3b8b1aa173c59p+0, -0x1.068496d97215fp-54}, 3252},
+    {{0x1.1104db8ab1ab7p+0, -0x1.ba47710a486c0p-55}, 3261},
+    {{0x1.d9846cc48c255p+0, 0x1.0760bf915325dp-58}, 3269},
+    {{0x1.9b8d9888d3ce7p+0, -0x1.bec59a600c4eep-56}, 3278},
+    {{0x1.668057df3080dp+0, 0x1.0568ef432aa3ap-55}, 3287},
+    {{0x1.38fd0cb75ad87p+0, 0x1.d81c8e7191dcfp-54}, 3296},
+    {{0x1.11dd6b206f7d7p+0, -0x1.e2e7035ca05ebp-54}, 3305},
+    {{0x1.e05558e3e38afp+0, 0x1.0d08d31a8ab9fp-54}, 3313},
+    {{0x1.a62b03204afd2p+0, 0x1.43a60c529f6b5p-57}, 3322},
+    {{0x1.73dee340f20e0p+0, -0x1.f05d2784a7126p-54}, 3331},
+    {{0x1.484ac49f55b05p+0, 0x1.49cdc31ce481dp-54}, 3340},
+    {{0x1.227626f6f9508p+0, 0x1.ab991a422059ap-55}, 3349},
+    {{0x1.018ec48cff126p+0, 0x1.1d9461245157cp-54}, 3358},
+    {{0x1.c9c4bf569959bp+0, 0x1.1c95c53c6497bp-57}, 3366},
+    {{0x1.97b33a692093ep+0, 0x1.3ebab1d4e4cb9p-56}, 3375},
+    {{0x1.6be779a2d5940p+0, -0x1.73825c4579c85p-56}, 3384},
+    {{0x1.45860fcea90d6p+0, 0x1.59d631baed07ep-55}, 3393},
+    {{0x1.23d3af2bc48d8p+0, -0x1.f67a6aec816a8p-63}, 3402},
+    {{0x1.06302f6152972p+0, 0x1.f8f2380fbe0efp-57}, 3411},
+    {{0x1.d824c55241ba2p+0, 0x1.99a985de8b282p-54}, 3419},
+    {{0x1.aa092e0d394f0p+0, -0x1.d6580834306edp-54}, 3428},
+    {{0x1.81434d24f552fp+0, -0x1.89549b6b31cc3p-54}, 3437},
+    {{0x1.5d24fde97e532p+0, 0x1.f716a64db5bdep-55}, 3446},
+    {{0x1.3d18189a8f3a8p+0, 0x1.10e81209938efp-55}, 3455},
+    {{0x1.209aee64ac5c4p+0, 0x1.c319c355ba68dp-58}, 3464},
+    {{0x1.073d5070d3362p+0, 0x1.31b73ffaab187p-54}, 3473},
+    {{0x1.e13c170e421f0p+0, -0x1.311cff09bf376p-54}, 3481},
+    {{0x1.b8d18b1e8f916p+0, 0x1.220bc186495f2p-56}, 3490},
+    {{0x1.94a85ab50dca7p+0, 0x1.0a9032a991569p-54}, 3499},
+    {{0x1.7440df718e2fcp+0, -0x1.1190b2ca0599bp-55}, 3508},
+    {{0x1.572bcdfcaf140p+0, 0x1.83ce9b2dc2d65p-55}, 3517},
+    {{0x1.3d07f7cbefbe0p+0, -0x1.99bba1a439810p-55}, 3526},
+    {{0x1.25806067ccf2ep+0, 0x1.84ad4b5af6c39p-55}, 3535},
+    {{0x1.104a99704ca35p+0, 0x1.684b62b471f73p-54}, 3544},
+    {{0x1.fa4ab54cce7fbp+0, 0x1.9bd8570f07cf5p-55}, 3552},
+    {{0x1.d7ae99e80e620p+0, -0x1.e22779723f9cbp-54}, 3561},
+    {{0x1.b85c01afa56d7p+0, 0x1.bddd259e569ccp-54}, 3570},
+    {{0x1.9bfa1393d343fp+0, -0x1.ccdf9b4e5df86p-54}, 3579},
+    {{0x1.823a725a960fbp+0, -0x1.7011a1997818ep-54}, 3588},
+    {{0x1.6ad7e86e19f9bp+0, 0x1.dc376faf52acap-54}, 3597},
+    {{0x1.559541cfa6741p+0, 0x1.6c5030240cd49p-54}, 3606},
+    {{0x1.423c4d9563868p+0, 0x1.3b5b4ad404350p-55}, 3615},
+    {{0x1.309d015738152p+0, 0x1.d50e265e35fd1p-54}, 3624},
+    {{0x1.208cb9c51ea01p+0, -0x1.8fae18a7c1dbdp-54}, 3633},
+    {{0x1.11e594561c11fp+0, -0x1.af6241673d03ap-54}, 3642},
+    {{0x1.0485de97e7b31p+0, -0x1.a851f535b288fp-54}, 3651},
+    {{0x1.f09f305191ad5p+0, -0x1.88dc3b6e5c551p-54}, 3659},
+    {{0x1.da5009a5e7a20p+0, 0x1.0b26a4f463430p-56}, 3668},
+    {{0x1.c5ee993bc6ae1p+0, -0x1.4015010887404p-54}, 3677},
+    {{0x1.b3504ff2d307ep+0, 0x1.e30bdb82524bfp-54}, 3686},
+    {{0x1.a24f2cd356c9ap+0, -0x1.dfd29b10c4eb1p-54}, 3695},
+    {{0x1.92c93ca97f112p+0, -0x1.5408949f4b38bp-55}, 3704},
+    {{0x1.84a0298789998p+0, 0x1.a7ebb89a4e6c5p-55}, 3713},
+    {{0x1.77b8d8268987fp+0, -0x1.6313cd8368972p-54}, 3722},
+    {{0x1.6bfb1165553bbp+0, -0x1.37fb2f174d527p-54}, 3731},
+    {{0x1.61513662dd3c7p+0, -0x1.18d753361e8e8p-54}, 3740},
+    {{0x1.57a7fde6292fcp+0, 0x1.2ad690105c476p-54}, 3749},
+    {{0x1.4eee39f3d1241p+0, -0x1.d2ff8a603841ap-56}, 3758},
+    {{0x1.4714a4981a3d3p+0, 0x1.75fc9cb782440p-54}, 3767},
+    {{0x1.400db30ed5acep+0, 0x1.4bf3af5990f78p-54}, 3776},
+    {{0x1.39cd6e8f8b808p+0, 0x1.2d77ececd122bp-54}, 3785},
+    {{0x1.3449521e058ccp+0, 0x1.3056a2854eeb2p-55}, 3794},
+    {{0x1.2f782cd58d769p+0, -0x1.51aae01319422p-57}, 3803},
+    {{0x1.2b520838a2077p+0, 0x1.85e5ebfa532c9p-58}, 3812},
+    {{0x1.27d0121ff8216p+0, -0x1.7beabc5c99bcdp-54}, 3821},
+    {{0x1.24ec89f2a8350p+0, 0x1.abcb0e7a4dc39p-54}, 3830},
+    {{0x1.22a2b0dec2e4ap+0, -0x1.af190f454db00p-55}, 3839},
+    {{0x1.20eebcd574c04p+0, 0x1.6db6cb28cd224p-54}, 3848},
+    {{0x1.1fcdce189f4b8p+0, 0x1.5c49145da4552p-54}, 3857},
+    {{0x1.1f3de73192fbep+0, -0x1.465102c8a7d08p-58}, 3866},
+    {{0x1.1f3de73192fbep+0, -0x1.465102c8a7d08p-58}, 3875},
+    {{0x1.1fcd86252bc56p+0, -0x1.30de856941849p-55}, 3884},
+    {{0x1.20ed53ab50f12p+0, 0x1.7df09c115539fp-55}, 3893},
+    {{0x1.229eb7a8d1ea9p+0, -0x1.a7d27b0490c64p-55}, 3902},
+    {{0x1.24e3f518238e6p+0, 0x1.c9bbc00acc307p-56}, 3911},
+    {{0x1.27c02efcdfe74p+0, 0x1.6f8d055ab9cbcp-54}, 3920},
+    {{0x1.2b376f89d6870p+0, -0x1.1c2453953606ep-54}, 3929},
+    {{0x1.2f4eb19038f5dp+0, 0x1.fff25a8c7f781p-55}, 3938},
+    {{0x1.340bec5679d9bp+0, -0x1.2c06ee04a7451p-54}, 3947},
+    {{0x1.397621fdfefe0p+0, -0x1.2d3434cef0d70p-56}, 3956},
+    {{0x1.3f9570a7f4f8fp+0, 0x1.333a718a411d3p-54}, 3965},
+    {{0x1.4673269390bc5p+0, -0x1.f0af341519f2bp-56}, 3974},
+    {{0x1.4e19d97b0620bp+0, 0x1.f8eb2c2c99dc6p-54}, 3983},
+    {{0x1.56958180a5c89p+0, -0x1.b885b66888770p-55}, 3992},
+    {{0x1.5ff3980b2a511p+0, -0x1.e648af32b2192p-54}, 4001},
+    {{0x1.6a433aff7e0e7p+0, -0x1.f687d054ae50ep-54}, 4010},
+    {{0x1.759554d779feep+0, -0x1.263c0ed753c36p-54}, 4019},
+    {{0x1.81fcca28a18bdp+0, 0x1.affbcaaa17d28p-56}, 4028},
+    {{0x1.8f8ead440f39cp+0, -0x1.f86a2d9af6ab9p-55}, 4037},
+    {{0x1.9e6278b215ca6p+0, 0x1.137786cf24b45p-57}, 4046},
+    {{0x1.ae9251690aa45p+0, -0x1.ec38b9bd987b9p-54}, 4055},
+    {{0x1.c03b51bfd9940p+0, 0x1.5196f2a420c36p-54}, 4064},
+    {{0x1.d37dde4317ed6p+0, 0x1.8061bc44b8af0p-56}, 4073},
+    {{0x1.e87e05bf1b809p+0, -0x1.279677f18c415p-54}, 4082},
+    {{0x1.ff63ee0410ca9p+0, 0x1.ea39e9bc84aeap-56}, 4091},
+    {{0x1.0c2e2791a1ce4p+0, -0x1.3ebac84b38daep-54}, 4101},
+    {{0x1.19cc7f940705bp+0, 0x1.0115bb88f5420p-54}, 4110},
+    {{0x1.28a8c84e55648p+0, 0x1.029183b2b8c41p-56}, 4119},
+    {{0x1.38e203429e100p+0, 0x1.0b578e67edec1p-60}, 4128},
+    {{0x1.4a9ad071e403fp+0, -0x1.fb960ff01cbc7p-54}, 4137},
+    {{0x1.5df9e2a890602p+0, 0x1.55584a41a3292p-55}, 4146},
+    {{0x1.732a83e1c51dfp+0, 0x1.310191604e451p-54}, 4155},
+    {{0x1.8a5d2c1fe16fdp+0, 0x1.0411aa7653296p-54}, 4164},
+    {{0x1.a3c82d77ef779p+0, -0x1.b12b320d0c7a8p-54}, 4173},
+    {{0x1.bfa8787ce65e8p+0, -0x1.a9ef105fea4eap-54}, 4182},
+    {{0x1.de427cb9701dfp+0, -0x1.5c339ff9e34bfp-56}, 4191},
+    {{0x1.ffe3297e7a001p+0, -0x1.a52bd04e5d51dp-54}, 4200},
+    {{0x1.127089ff0ee88p+0, 0x1.43324291fc77ep-54}, 4210},
+    {{0x1.26cee43cfd03cp+0, 0x1.bb2efd82d234dp-54}, 4219},
+    {{0x1.3d43a69fa2499p+0, 0x1.27888e9249be7p-57}, 4228},
+    {{0x1.560cefa41af75p+0, -0x1.0583192921fabp-59}, 4237},
+    {{0x1.7170f8d4bf202p+0, -0x1.1da7418aced33p-55}, 4246},
+    {{0x1.8fbf3d3e32cdcp+0, 0x1.aea0614ce3579p-59}, 4255},
+    {{0x1.b151cce2ec120p+0, 0x1.f69656cbc6c38p-54}, 4264},
+    {{0x1.d68ed47e6c5b9p+0, 0x1.21c7424149d84p-54}, 4273},
+    {{0x1.ffea622b88e1ap+0, 0x1.14fd16501b573p-56}, 4282},
+    {{0x1.16f4387eb916fp+0, 0x1.a377f4d453730p-55}, 4292},
+    {{0x1.308fa3ae5b149p+0, -0x1.640d10645dc7ep-56}, 4301},
+    {{0x1.4d1d1b06b39e8p+0, -0x1.015b927b71a4bp-54}, 4310},
+    {{0x1.6cfe641cd7cf2p+0, 0x1.b60329ffbdfb1p-54}, 4319},
+    {{0x1.90a33be3a8e26p+0, 0x1.a325e466de227p-56}, 4328},
+    {{0x1.b88b7e5ad634fp+0, -0x1.a319d558e2bd2p-56}, 4337},
+    {{0x1.e549a9300ff65p+0, -0x1.6daa7503e9c46p-56}, 4346},
+    {{0x1.0bc2e499c4ceap+0, 0x1.b68f6cbbe5d12p-54}, 4356},
+    {{0x1.280072b5fc907p+0, 0x1.39a11a676e1c5p-55}, 4365},
+    {{0x1.47cc7f088931fp+0, 0x1.afa8f45ec5383p-54}, 4374},
+    {{0x1.6ba6dced78337p+0, -0x1.224121cdba6b6p-55}, 4383},
+    {{0x1.9422f085e8152p+0, 0x1.dcb74ef76f29dp-54}, 4392},
+    {{0x1.c1eae5c5135f9p+0, -0x1.8a8fda2d127cdp-55}, 4401},
+    {{0x1.f5c3773f491b1p+0, -0x1.603b6e8a20f1cp-58}, 4410},
+    {{0x1.18482f9c59d62p+0, -0x1.20982657e50cep-55}, 4420},
+    {{0x1.39acc9487a8a2p+0, 0x1.282dc8b51148bp-58}, 4429},
+    {{0x1.5fa8b5a84160ep+0, -0x1.733f4abfd01a0p-54}, 4438},
+    {{0x1.8aedf802756c4p+0, 0x1.43126b8d95cadp-54}, 4447},
+    {{0x1.bc4bb702c419dp+0, -0x1.29168e016ef7ap-55}, 4456},
+    {{0x1.f4b353be9dff1p+0, 0x1.12990a7bb1390p-54}, 4465},
+    {{0x1.1a9f38c5182e8p+0, -0x1.43009d952e775p-54}, 4475},
+    {{0x1.3f9b0eb2e2d89p+0, 0x1.5d66e5e5fa052p-61}, 4484},
+    {{0x1.6a0da6a6a4f95p+0, 0x1.962f3a41ba14ep-55}, 4493},
+    {{0x1.9ad87d9c1a34fp+0, -0x1.8f1368646a574p-55}, 4502},
+    {{0x1.d30416c871ca3p+0, -0x1.aed187d51270ap-54}, 4511},
+    {{0x1.09e393f89ec8ep+0, -0x1.c047cb158f3fap-54}, 4521},
+    {{0x1.2f4794c7951d1p+0, 0x1.e0ae1c5b689b7p-54}, 4530},
+    {{0x1.5a85497e09dfcp+0, -0x1.519221331df4dp-55}, 4539},
+    {{0x1.8c9a8d1d414d1p+0, 0x1.dda3c0007eb6dp-55}, 4548},
+    {{0x1.c6b330c90a5dep+0, -0x1.e0c986bedd72cp-56}, 4557},
+    {{0x1.0518e50370f3ep+0, 0x1.a2fb11e819b5cp-54}, 4567},
+    {{0x1.2c5d237475709p+0, 0x1.2dfdd4198193ap-54}, 4576},
+    {{0x1.5a1f53db3354cp+0, -0x1.280080969baeep-54}, 4585},
+    {{0x1.8f87294b85c05p+0, -0x1.b6b251b762d19p-56}, 4594},
+    {{0x1.cdf447bf52a66p+0, -0x1.5ecf8b9f02909p-54}, 4603},
+    {{0x1.0b84b68c8b9cdp+0, 0x1.7ad84f652ac3cp-54}, 4613},
+    {{0x1.365cf7c90df8fp+0, 0x1.0b84f41c5e9d2p-54}, 4622},
+    {{0x1.68ad09f425bcdp+0, -0x1.e39fca21018cap-59}, 4631},
+    {{0x1.a3d96d9633eddp+0, -0x1.8997c00a535e7p-54}, 4640},
+    {{0x1.e98d0647a38ccp+0, 0x1.ee211d27eb94dp-55}, 4649},
+    {{0x1.1de3db2ad602bp+0, 0x1.18482b436809bp-54}, 4659},
+    {{0x1.4e7812e89d603p+0, -0x1.7e179162a3c8bp-54}, 4668},
+    {{0x1.87f4b628986cbp+0, 0x1.40f18681a0437p-56}, 4677},
+    {{0x1.cc16bfd2a6eb9p+0, 0x1.842ee098ca27dp-54}, 4686},
+    {{0x1.0e7b5fc557218p+0, -0x1.1ca70f62d279cp-58}, 4696},
+    {{0x1.3e8e4d4aea1dfp+0, 0x1.f61827ec23a3bp-55}, 4705},
+    {{0x1.77cbdf2e602f5p+0, 0x1.70283f8c49059p-54}, 4714},
+    {{0x1.bc0e67384ca7fp+0, -0x1.2be1c3a2eedbcp-56}, 4723},
+    {{0x1.06ca8615d15d6p+0, 0x1.d687e4b913a4fp-56}, 4733},
+    {{0x1.378d19f6ddb63p+0, 0x1.5f7586ea5ab28p-54}, 4742},
+    {{0x1.71f78ed527486p+0, -0x1.ea46fc9b44c03p-58}, 4751},
+    {{0x1.b80ef56489399p+0, 0x1.678d6908950b9p-54}, 4760},
+    {{0x1.0624e92e63bedp+0, -0x1.2fa085dcc66d3p-55}, 4770},
+    {{0x1.38d50c44dc083p+0, 0x1.31a9f0410934bp-55}, 4779},
+    {{0x1.75eea8aa4f01dp+0, -0x1.e2a2ded242ff0p-55}, 4788},
+    {{0x1.bfb23cefe797ap+0, 0x1.c114001ca164dp-54}, 4797},
+    {{0x1.0c715f89d95d7p+0, -0x1.5aea07bb54e82p-56}, 4807},
+    {{0x1.42722e421497cp+0, -0x1.662d0712611f3p-54}, 4816},
+    {{0x1.83f15fa780c69p+0, -0x1.dddc590439b32p-55}, 4825},
+    {{0x1.d3805fc55aaf4p+0, 0x1.0211fb5d343bdp-54}, 4834},
+    {{0x1.1a24f9cc9b3acp+0, 0x1.a3bfda33c0062p-54}, 4844},
+    {{0x1.551bb400ddab9p+0, -0x1.e43c6d937ac4ep-57}, 4853},
+    {{0x1.9d0f8bf90c6dcp+0, -0x1.8a612cb096aa7p-57}, 4862},
+    {{0x1.f4ff5b4591932p+0, -0x1.c795b72d0baf7p-55}, 4871},
+    {{0x1.30511bf0c1ecep+0, -0x1.0e5db861ee4c8p-54}, 4881},
+    {{0x1.724ab17f73f7bp+0, 0x1.5b04f624d689ep-54}, 4890},
+    {{0x1.c34b08535555ep+0, 0x1.46ee0bfce5781p-54}, 4899},
+    {{0x1.13728bd4dcd5bp+0, -0x1.74ea6a5dc9e2fp-55}, 4909},
+    {{0x1.50c70cf742014p+0, 0x1.40358fcd50a60p-57}, 4918},
+    {{0x1.9c6bc260cb549p+0, -0x1.d6fbcd0cc2379p-54}, 4927},
+    {{0x1.f9dc2c6ab965bp+0, -0x1.9b0d981a6382fp-58}, 4936},
+    {{0x1.36ba7e488e61bp+0, 0x1.87381e651ca60p-54}, 4946},
+    {{0x1.7e57796347324p+0, -0x1.3a9df29995bfcp-54}, 4955},
+    {{0x1.d734ce19da3e6p+0, 0x1.f4425783b7f23p-54}, 4964},
+    {{0x1.22d29733f4b28p+0, 0x1.04c0f2034b877p-54}, 4974},
+    {{0x1.678d5befbc06bp+0, 0x1.12608b3512e10p-54}, 4983},
+    {{0x1.bd3a0ad7dbd45p+0, -0x1.607ce73e8f3edp-55}, 4992},
+    {{0x1.1417be395b91ep+0, 0x1.b9b545ccfa55ep-54}, 5002},
+    {{0x1.56f57e4b3fbf4p+0, -0x1.96a1a696c212ap-55}, 5011},
+    {{0x1.aab06da09ecf7p+0, -0x1.69e81dc290742p-55}, 5020},
+    {{0x1.09d8ec4d92f24p+0, -0x1.bd7c1e8ab9006p-55}, 5030},
+    {{0x1.4bca3aead0e55p+0, 0x1.440397e1de1c1p-55}, 5039},
+    {{0x1.9ebcc9a5851eap+0, 0x1.ca823eed2ad19p-54}, 5048},
+    {{0x1.039dad39dc947p+0, 0x1.2080fc7ec1b53p-59}, 5058},
+    {{0x1.4588b6358d962p+0, 0x1.3a706f26bc391p-57}, 5067},
+    {{0x1.98d330d441501p+0, -0x1.82a3798d1b53dp-54}, 5076},
+    {{0x1.011cd1b57d135p+0, 0x1.90d7308e41d05p-54}, 5086},
+    {{0x1.43e6ce2f2210ep+0, -0x1.ea11d2a9942e3p-55}, 5095},
+    {{0x1.98ac362577fb4p+0, 0x1.72d5c19a0504ep-54}, 5104},
+    {{0x1.0236cf362c8f0p+0, 0x1.ac9d1e262157ap-55}, 5114},
+    {{0x1.46cd5e4090650p+0, 0x1.e76da284232efp-59}, 5123},
+    {{0x1.9e3f51f8d7080p+0, 0x1.b34ed3c403f4dp-54}, 5132},
+    {{0x1.06f33188747eap+0, -0x1.ebae7694137d2p-54}, 5142},
+    {{0x1.4e56377b001efp+0, 0x1.aad5ac3ab9387p-54}, 5151},
+    {{0x1.a9c1caa6a2277p+0, -0x1.e1cf9ab4e088bp-56}, 5160},
+    {{0x1.0f80d47ac2e7ap+0, 0x1.3e30172609f43p-54}, 5170},
+    {{0x1.5acd8f68cef5ep+0, 0x1.dcdedb232d6dep-55}, 5179},
+    {{0x1.bba9f8f694c39p+0, 0x1.a83c655e02785p-57}, 5188},
+    {{0x1.1c38e37df74d5p+0, -0x1.ce0729e1f8cd6p-54}, 5198},
+    {{0x1.6cb6ffeb23d6bp+0, -0x1.06e0313e77c38p-54}, 5207},
+    {{0x1.d4b72ee5310eep+0, 0x1.7453c16d702b7p-55}, 5216},
+    {{0x1.2da4e36dff525p+0, 0x1.21ce735d96f80p-54}, 5226},
+    {{0x1.84d68d2bcb202p+0, 0x1.eca105b524dd4p-57}, 5235},
+    {{0x1.f5fefd4109bd0p+0, -0x1.5c8043c4347d1p-54}, 5244},
+    {{0x1.448858b98bcbbp+0, -0x1.014cebcf57eedp-54}, 5254},
+    {{0x1.a43e8ee444864p+0, -0x1.665e36b5fcbb9p-55}, 5263},
+    {{0x1.108090a8046f1p+0, -0x1.14308bbd00f0dp-54}, 5273},
+    {{0x1.61eefbe239c24p+0, -0x1.54b90d7efbb8cp-54}, 5282},
+    {{0x1.cc63dda54521ap+0, 0x1.94cb4971d290bp-54}, 5291},
+    {{0x1.2be20c9f66c7bp+0, -0x1.3a5495e91c184p-54}, 5301},
+    {{0x1.8740ec77f8188p+0, 0x1.379691a775615p-56}, 5310},
+    {{0x1.ff3a54fac1ac0p+0, 0x1.35c88f5453b7fp-54}, 5319},
+    {{0x1.4e7eaa9a11b81p+0, -0x1.6a9e8c70a6725p-55}, 5329},
+    {{0x1.b65f0094ea38bp+0, 0x1.50629b792eee9p-54}, 5338},
+    {{0x1.1fae5861b9b53p+0, 0x1.bcc0b60786cc9p-54}, 5348},
+    {{0x1.7a24ab2c749abp+0, 0x1.5d369e89c95fdp-55}, 5357},
+    {{0x1.f1ca4555857fap+0, 0x1.51da7359b10b9p-54}, 5366},
+    {{0x1.482215341fbfep+0, 0x1.0cb4bf895f746p-54}, 5376},
+    {{0x1.b13cfffed1eb6p+0, -0x1.2d395b1c9ff86p-54}, 5385},
+    {{0x1.1e6d943f3848ep+0, -0x1.79262b7cacc2fp-54}, 5395},
+    {{0x1.7b4b1b4fb7888p+0, -0x1.cb6d8b9618c63p-54}, 5404},
+    {{0x1.f7021ab837e58p+0, -0x1.e28f8d3b1bb59p-55}, 5413},
+    {{0x1.4e0765be551e6p+0, 0x1.1fc6561b5fccbp-54}, 5423},
+    {{0x1.bc48d6d3a836fp+0, -0x1.aa7964f12e287p-55}, 5432},
+    {{0x1.27e68313f7889p+0, 0x1.27fb1322af611p-54}, 5442},
+    {{0x1.8ab9ffdb22b4bp+0, 0x1.21aadc0d89e7ep-55}, 5451},
+    {{0x1.07aa3de7602ebp+0, 0x1.897d20fd0b1dep-55}, 5461},
+    {{0x1.60c143d20e2e8p+0, -0x1.5ac70baeba504p-54}, 5470},
+    {{0x1.d8a2f1de71004p+0, 0x1.8f5f4f58e45e8p-54}, 5479},
+    {{0x1.3d1751c4fc4ffp+0, -0x1.c07e7420e64cfp-57}, 5489},
+    {{0x1.aa1755e0b30b7p+0, -0x1.ab553d8186aefp-54}, 5498},
+    {{0x1.1eb2338870787p+0, -0x1.31103544cdbe6p-55}, 5508},
+    {{0x1.825e2772df925p+0, -0x1.118f6be4dca2dp-54}, 5517},
+    {{0x1.04b9091ec45e0p+0, -0x1.d999880eafe2ep-54}, 5527},
+    {{0x1.6062165395670p+0, 0x1.ff99f870991d9p-56}, 5536},
+    {{0x1.dcf4c33821b7fp+0, -0x1.e5c50c9dcc60cp-55}, 5545},
+    {{0x1.433fe24e8ada2p+0, 0x1.a56379f986fe3p-54}, 5555},
+    {{0x1.b6c937b19d7b2p+0, -0x1.3ffbbf6e4a0f6p-57}, 5564},
+    {{0x1.2a3cc3dab909bp+0, -0x1.597d1c1cf6567p-57}, 5574},
+    {{0x1.95ffb89f40e5bp+0, -0x1.a652d0c56d58bp-57}, 5583},
+    {{0x1.14becf588dbc9p+0, -0x1.7efb9a749847ap-60}, 5593},
+    {{0x1.79d280136580fp+0, -0x1.88adc7f5e2de6p-56}, 5602},
+    {{0x1.0246e58d42632p+0, 0x1.81c89a2774f50p-55}, 5612},
+    {{0x1.619e1149e764cp+0, -0x1.23e76c787d2f5p-54}, 5621},
+    {{0x1.e4d7b9b454432p+0, -0x1.80749b726747bp-55}, 5630},
+    {{0x1.4cdb19bd8cd91p+0, 0x1.940ff24835989p-55}, 5640},
+    {{0x1.c9ad4364a1aa8p+0, -0x1.6a35096e5b272p-54}, 5649},
+    {{0x1.3b1989a6084dap+0, -0x1.457c0ef8e906cp-56}, 5659},
+    {{0x1.b27e36cdf1730p+0, 0x1.f7cbfbd6b1ab7p-54}, 5668},
+    {{0x1.2bfca456b0743p+0, -0x1.1429e9df84d4ep-54}, 5678},
+    {{0x1.9ed35b3fe000ap+0, 0x1.1a1e0a98ea51ap-54}, 5687},
+    {{0x1.1f37d6edf9d87p+0, 0x1.d555335980f41p-56}, 5697},
+    {{0x1.8e4a6f0c01772p+0, 0x1.76b5498d4774ap-54}, 5706},
+    {{0x1.148c2e9a96048p+0, -0x1.5dd3a02e27a2dp-54}, 5716},
+    {{0x1.8092f0cef89e4p+0, -0x1.667a4ac02f1e6p-54}, 5725},
+    {{0x1.0bc6502c1c9c3p+0, -0x1.eb354d18a19ddp-55}, 5735},
+    {{0x1.756b8dcd83e5dp+0, -0x1.9a80aa41acb09p-54}, 5744},
+    {{0x1.04bcd9433fd8bp+0, 0x1.40bd523d49578p-55}, 5754},
+    {{0x1.6ca017d40b491p+0, -0x1.97bb9f7f25b7dp-54}, 5763},
+    {{0x1.fe9e315e71cdcp+0, 0x1.ff03c12471ae1p-54}, 5772},
+    {{0x1.6607eb9db8cbdp+0, -0x1.91b0de12f24a7p-54}, 5782},
+    {{0x1.f6c81f5ffd023p+0, -0x1.1c2fbfb7367f2p-55}, 5791},
+    {{0x1.6184b60f7de59p+0, -0x1.f3e8c9666928bp-54}, 5801},
+    {{0x1.f1d36260d0c9cp+0, -0x1.6df94f9cb715dp-54}, 5810},
+    {{0x1.5f018add43364p+0, -0x1.0a0a48a1ff16ep-54}, 5820},
+    {{0x1.efa8ad9772691p+0, 0x1.60527a6f3e493p-54}, 5829},
+    {{0x1.5e7242bc13e45p+0, -0x1.e5cb5edeb1ec8p-55}, 5839},
+    {{0x1.f03ccb7f522acp+0, 0x1.7a0dc314d4875p-54}, 5848},
+    {{0x1.5fd31a46c4c15p+0, 0x1.a811839e895bep-55}, 5858},
+    {{0x1.f3903fcf7c608p+0, 0x1.cc49bcc73813fp-56}, 5867},
+    {{0x1.63288d5d826cap+0, -0x1.dc61c9e52f10fp-55}, 5877},
+    {{0x1.f9af3d47a433ap+0, 0x1.20db6204973e3p-54}, 5886},
+    {{0x1.687f6d2f928edp+0, 0x1.8f632b022e8ecp-57}, 5896},
+    {{0x1.0158f731b5df7p+0, 0x1.c54702bcf3af2p-55}, 5906},
+    {{0x1.6fed316912057p+0, 0x1.cc05c2f512323p-54}, 5915},
+    {{0x1.075e899e76267p+0, -0x1.9bb4e03212b99p-54}, 5925},
+    {{0x1.7990874a2b611p+0, 0x1.571eca60dc9fdp-56}, 5934},
+    {{0x1.0f017d1b7ca2fp+0, -0x1.e6dbd31e7cd23p-55}, 5944},
+    {{0x1.859223d7832a3p+0, 0x1.c42400842c91ep-55}, 5953},
+    {{0x1.18626e4bdc272p+0, -0x1.a4a8b506f75ffp-58}, 5963},
+    {{0x1.9425e0fb58546p+0, 0x1.221a8d310f56fp-54}, 5972},
+    {{0x1.23aa561d63feep+0, 0x1.e35ca96527d20p-54}, 5982},
+    {{0x1.a58c30767a867p+0, -0x1.5564132bcc728p-54}, 5991},
+    {{0x1.310bb211bc29cp+0, 0x1.2bf555208e4e2p-54}, 6001},
+    {{0x1.ba13f30fb3b09p+0, -0x1.fd4b75a1d1c4cp-54}, 6010},
+    {{0x1.40c3f99ca4a15p+0, 0x1.ad767f65d60b8p-54}, 6020},
+    {{0x1.d21cc6b79f3a7p+0, 0x1.0020623ff6116p-55}, 6029},
+    {{0x1.531d6f9317984p+0, 0x1.5c2bc7bd84631p-54}, 6039},
+    {{0x1.ee19e3915160ep+0, -0x1.69686bf1bc375p-55}, 6048},
+    {{0x1.687162c2421d7p+0, -0x1.a9d2765f4c06bp-54}, 6058},
+    {{0x1.074ad323e64b8p+0, -0x1.030cbc779c88ep-54}, 6068},
+    {{0x1.812af5e004657p+0, -0x1.95ec4369f4fc8p-55}, 6077},
+    {{0x1.1a1af71593385p+0, -0x1.b2a745b00d777p-54}, 6087},
+    {{0x1.9dca8d6c25711p+0, -0x1.3c62d5bdde05dp-57}, 6096},
+    {{0x1.2fe0bfdb6b7f0p+0, 0x1.d2f4ed61121e8p-54}, 6106},
+    {{0x1.beea0a2a33985p+0, 0x1.1d826e3a864bap-55}, 6115},
+    {{0x1.4913547c12fdbp+0, -0x1.dce2baeaf40ebp-54}, 6125},
+    {{0x1.e5420114f6011p+0, -0x1.fa70ad42edc74p-55}, 6134},
+    {{0x1.6641bacc799ecp+0, 0x1.790d680acb39fp-54}, 6144},
+    {{0x1.08d81757a8e8ap+0, -0x1.a85adac0a86d0p-59}, 6154},
+    {{0x1.8817ea8ec7106p+0, 0x1.245e0bf126353p-54}, 6163},
+    {{0x1.229fba1b540c6p+0, 0x1.a2b4b559fe11fp-54}, 6173},
+    {{0x1.af65184090c27p+0, -0x1.f27bc2ce6add6p-54}, 6182},
+    {{0x1.4098e145fb948p+0, -0x1.83747985e6eb0p-54}, 6192},
+    {{0x1.dd238745276c0p+0, -0x1.a0a458dc48abcp-54}, 6201},
+    {{0x1.6386390ac71fbp+0, 0x1.098d8ac9dcda0p-54}, 6211},
+    {{0x1.0941248f0a90ap+0, 0x1.da209a8c9bc6bp-54}, 6221},
+    {{0x1.8c53d51fb9492p+0, 0x1.10d36dd62d80ap-55}, 6230},
+    {{0x1.2878b5ed3b1a3p+0, 0x1.420b1454db84ep-54}, 6240},
+    {{0x1.bc20d488e209cp+0, 0x1.38df31ea3db31p-55}, 6249},
+    {{0x1.4d189f66a9875p+0, 0x1.d54ecadf5c8cap-56}, 6259},
+    {{0x1.f44b7b69b19fcp+0, -0x1.971f284b857edp-56}, 6268},
+    {{0x1.7832c24cfa10ap+0, -0x1.5222edccc9e1ep-56}, 6278},
+    {{0x1.1b4037cb75480p+0, 0x1.bcb419ba077fap-55}, 6288},
+    {{0x1.ab16d420c6d69p+0, 0x1.4f43c7653fa73p-54}, 6297},
+    {{0x1.4266fba1be198p+0, -0x1.ebd42b75a3661p-55}, 6307},
+    {{0x1.e761ae6582608p+0, 0x1.ac3f212694fe6p-54}, 6316},
+    {{0x1.70de2dbd536c9p+0, -0x1.07c6715219790p-55}, 6326},
+    {{0x1.17885ea979384p+0, 0x1.c81b9e1fc8b25p-55}, 6336},
+    {{0x1.a83673a83075ep+0, 0x1.442de9773c129p-55}, 6345},
+    {{0x1.424d5edf48d19p+0, 0x1.393387845c908p-57}, 6355},
+    {{0x1.ea60b7d8b94aep+0, -0x1.9e6f032a03a54p-54}, 6364},
+    {{0x1.7587ac0a15240p+0, 0x1.d8a2e12dfe724p-55}, 6374},
+    {{0x1.1ce3b9f6b09fbp+0, 0x1.f43d1d1f2a285p-54}, 6384},
+    {{0x1.b31fd107c7c3fp+0, 0x1.c0255dea658e4p-56}, 6393},
+    {{0x1.4cb79415b3001p+0, 0x1.06ab24a3fec9ep-54}, 6403},
+    {{0x1.fd791ac13a182p+0, -0x1.3727bf93876b7p-56}, 6412},
+    {{0x1.869016c2a0c90p+0, -0x1.33441c4e6c481p-55}, 6422},
+    {{0x1.2bc99978646a4p+0, 0x1.aa131c22e6f15p-54}, 6432},
+    {{0x1.ccce61668e596p+0, -0x1.1913a0405a040p-54}, 6441},
+    {{0x1.629ad0f3eb8acp+0, 0x1.bf67cb5cf575dp-55}, 6451},
+    {{0x1.1139c97ff13cbp+0, -0x1.37a2a3474fef8p-54}, 6461},
+    {{0x1.a59429e86938ap+0, -0x1.f9afe3de10ad1p-55}, 6470},
+    {{0x1.45a7335f47478p+0, -0x1.5d4fcf2264b0dp-54}, 6480},
+    {{0x1.f7bea37762429p+0, 0x1.8ea22e5b30f9dp-56}, 6489},
+    {{0x1.861b621733d81p+0, -0x1.63a573ccf0a94p-55}, 6499},
+    {{0x1.2e7c3b8efdb30p+0, 0x1.901e1adacbb26p-54}, 6509},
+    {{0x1.d5ade67a86ed8p+0, -0x1.72b9414d44b69p-54}, 6518},
+    {{0x1.6d1a2e293ee2ap+0, -0x1.802e01c31069ep-54}, 6528},
+    {{0x1.1c2aa06d9a31ep+0, -0x1.a40f3b7c4a19bp-56}, 6538},
+    {{0x1.bae6700ad353cp+0, -0x1.9bacef6daddf8p-54}, 6547},
+    {{0x1.59954dec72649p+0, 0x1.02c7d02e2b94ep-54}, 6557},
+    {{0x1.0dfca4e0b95e9p+0, 0x1.d458354824189p-55}, 6567},
+    {{0x1.a661bff192007p+0, 0x1.8059ffadae3c4p-54}, 6576},
+    {{0x1.4acf8ed4b2d96p+0, -0x1.c9f30680f213ap-55}, 6586},
+    {{0x1.036a43414b3ffp+0, 0x1.9ce2aca6622b1p-55}, 6596},
+    {{0x1.975cdd9c882a7p+0, -0x1.03d206715cec3p-54}, 6605},
+    {{0x1.403dc1374e0b6p+0, -0x1.a940db909e4cbp-54}, 6615},
+    {{0x1.f821372a0fdbep+0, -0x1.2ae2334952656p-55}, 6624},
+    {{0x1.8d4c2d3965ff8p+0, 0x1.7c3a1e0a7ba85p-54}, 6634},
+    {{0x1.397e1baf4a7bap+0, -0x1.3fa244bba6d31p-58}, 6644},
+    {{0x1.ef57c2be79305p+0, 0x1.746f41a657ee7p-54}, 6653},
+    {{0x1.87d2eb8baadccp+0, -0x1.0765fe91eb71ep-54}, 6663},
+    {{0x1.36524c0cdd925p+0, 0x1.cd8fe287bb1e4p-56}, 6673},
+    {{0x1.ec26849c67661p+0, -0x1.21fee75e5e9f0p-55}, 6682},
+    {{0x1.86bd94c92d17cp+0, 0x1.99e12f6729b02p-54}, 6692},
+    {{0x1.369bb3c5eb586p+0, 0x1.8dd2812e81a38p-54}, 6702},
+    {{0x1.ee6cd8a98c1f3p+0, 0x1.ad4094a1875bcp-54}, 6711},
+    {{0x1.89febca71ba8ep+0, -0x1.9f0898f4822dep-58}, 6721},
+    {{0x1.3a597e0453d18p+0, -0x1.cd645381229bap-55}, 6731},
+    {{0x1.f638fa54e9e9bp+0, -0x1.092a4b4a82554p-58}, 6740},
+    {{0x1.91ae12376a15ap+0, 0x1.d3beb6c482842p-54}, 6750},
+    {{0x1.41a864965ff35p+0, 0x1.be8fb85b5c83dp-54}, 6760},
+    {{0x1.01e442a5906dep+0, -0x1.a0f74570c0135p-54}, 6770},
+    {{0x1.9e0976ffcee06p+0, -0x1.ead9f8f808be0p-55}, 6779},
+    {{0x1.4cc41b641884dp+0, 0x1.097f5026a6f95p-55}, 6789},
+    {{0x1.0bc5ce0a8bbaep+0, 0x1.0b48e4fe34b93p-56}, 6799},
+    {{0x1.af783a7ffe26ap+0, -0x1.85442c11902e6p-58}, 6808},
+    {{0x1.5c0a7b303e822p+0, 0x1.f06008273d533p-54}, 6818},
+    {{0x1.191576fd367bap+0, -0x1.323ce2d49e723p-55}, 6828},
+    {{0x1.c690b66d7e1bfp+0, -0x1.c79f3b69ec1e5p-54}, 6837},
+    {{0x1.7000a7b024582p+0, -0x1.eddba8d980679p-54}, 6847},
+    {{0x1.2a4887eb45756p+0, 0x1.ebb474a3b46c1p-54}, 6857},
+    {{0x1.e420b89a5b3c1p+0, -0x1.1be1396099553p-55}, 6866},
+    {{0x1.895a95fd6a20dp+0, -0x1.33537f4f3e4aap-54}, 6876},
+    {{0x1.3ffbf08365953p+0, -0x1.5a0158a06cd86p-55}, 6886},
+    {{0x1.049cb163043c0p+0, -0x1.373862baa298fp-57}, 6896},
+    {{0x1.a9058b4afb67ep+0, -0x1.bf71cea06c059p-54}, 6905},
+    {{0x1.5afd86b8373fdp+0, -0x1.f54be9b0f8309p-54}, 6915},
+    {{0x1.1b9fba5e1328ep+0, 0x1.2e7f66783244bp-55}, 6925},
+    {{0x1.d0366e07f95bfp+0, -0x1.6072bda4a2dcdp-54}, 6934},
+    {{0x1.7c5898a7088f1p+0, -0x1.3e30170d23836p-57}, 6944},
+    {{0x1.3800ad3905056p+0, -0x1.58a06e5d18e43p-54}, 6954},
+    {{0x1.003e8e44145fap+0, 0x1.6af63d5c0a4e9p-54}, 6964},
+    {{0x1.a566dff5f5815p+0, -0x1.23190d17a30cdp-54}, 6973},
+    {{0x1.5aea70dfbbdc3p+0, 0x1.bad903c65429cp-57}, 6983},
+    {{0x1.1def3b0867d68p+0, -0x1.dcbfc878e2286p-55}, 6993},
+    {{0x1.d7e752ed5f5f8p+0, -0x1.f2d2845b813fbp-55}, 7002},
+    {{0x1.85df9d031c4b6p+0, 0x1.83e313a666b7ep-55}, 7012},
+    {{0x1.427bb61f52a76p+0, -0x1.3594763f8e44bp-54}, 7022},
+    {{0x1.0b0e72d1f0729p+0, 0x1.dfa10e135e2f2p-54}, 7032},
+    {{0x1.bad575651f360p+0, 0x1.0d528fd71dad2p-54}, 7041},
+    {{0x1.6f962ff270685p+0, 0x1.9f8f086610223p-54}, 7051},
+    {{0x1.317c1058baeabp+0, 0x1.785a1e3ad1e87p-54}, 7061},
+    {{0x1.fc587333a70a9p+0, 0x1.548bec9bc2999p-55}, 7070},
+    {{0x1.a774adf6c6e59p+0, -0x1.54a4e24e804b3p-56}, 7080},
+    {{0x1.6127cf154ee07p+0, 0x1.3df43ea1c400ap-55}, 7090},
+    {{0x1.26defd280a9bep+0, 0x1.e5bd57a5c8b3cp-54}, 7100},
+    {{0x1.ecfccf3ef1bcap+0, 0x1.cc188e892b8c9p-54}, 7109},
+    {{0x1.9c9694726dd02p+0, 0x1.761f1a949964cp-55}, 7119},
+    {{0x1.59b42b61e102ep+0, 0x1.50bc87e2c1437p-54}, 7129},
+    {{0x1.21ffe3645b813p+0, -0x1.170bb20510c15p-55}, 7139},
+    {{0x1.e71bcff291b30p+0, -0x1.425ad28241126p-54}, 7148},
+    {{0x1.99922298b501cp+0, -0x1.3e15bb000a6d6p-55}, 7158},
+    {{0x1.58c6841f8c5efp+0, 0x1.c21e5a8abb9c7p-54}, 7168},
+    {{0x1.22914dd9968d1p+0, -0x1.d3a6eb319462ep-54}, 7178},
+    {{0x1.ea55335f2e0e0p+0, -0x1.54a6b38ea99b8p-56}, 7187},
+    {{0x1.9e3278a526a75p+0, 0x1.301f17695e9d3p-55}, 7197},
+    {{0x1.5e49af07ab308p+0, 0x1.2a6496993907ep-56}, 7207},
+    {{0x1.2894e2f1be315p+0, 0x1.5ca4aa823b097p-56}, 7217},
+    {{0x1.f6cc68bdd46fap+0, -0x1.043c35bbcdfa8p-54}, 7226},
+    {{0x1.aab0f7e31887bp+0, 0x1.c527e7665f733p-54}, 7236},
+    {{0x1.6a855a9b71575p+0, -0x1.f3fa639a179eap-56}, 7246},
+    {{0x1.345aedd1b7a80p+0, 0x1.515ce2e3d7347p-55}, 7256},
+    {{0x1.06956e8496651p+0, 0x1.1f4919360542ap-55}, 7266},
+    {{0x1.bfb9caf1126f5p+0, 0x1.66ec11be4dfc1p-54}, 7275},
+    {{0x1.7e2413b6c23c0p+0, 0x1.a4587d24ed8fap-54}, 7285},
+    {{0x1.468953d86a78dp+0, -0x1.58d16310b2018p-54}, 7295},
+    {{0x1.17577aba23155p+0, 0x1.5504e040b7b8bp-54}, 7305},
+    {{0x1.de7b57b7d5181p+0, -0x1.55df25e1254e2p-54}, 7314},
+    {{0x1.9a42c1b61f362p+0, -0x1.6e41a9f516f8fp-55}, 7324},
+    {{0x1.602acdc8154abp+0, 0x1.c19b225bdd87dp-55}, 7334},
+    {{0x1.2ea4c8d7f24c3p+0, 0x1.22615186f260bp-55}, 7344},
+    {{0x1.046145cbca361p+0, -0x1.c0578b374bf0ap-56}, 7354},
+    {{0x1.c08b913c0f572p+0, -0x1.7456ced241d18p-56}, 7363},
+    {{0x1.82c8597c8a3a6p+0, -0x1.a4476b5f39059p-58}, 7373},
+    {{0x1.4de6f54083546p+0, 0x1.2152e584ecbc6p-54}, 7383},
+    {{0x1.2093db760180bp+0, -0x1.fcc6c8b7998bep-60}, 7393},
+    {{0x1.f35fdcc53499bp+0, 0x1.63e500aa9252cp-58}, 7402},
+    {{0x1.b090497bd2502p+0, 0x1.0223cea9e01f9p-57}, 7412},
+    {{0x1.771d1fb960618p+0, -0x1.e8093cb22be92p-55}, 7422},
+    {{0x1.45a908caafecap+0, 0x1.084dfb0e5160dp-55}, 7432},
+    {{0x1.1b0b6a2429e73p+0, -0x1.49241ca60722bp-54}, 7442},
+    {{0x1.ec905d35eeebdp+0, -0x1.bac857daed6adp-54}, 7451},
+    {{0x1.ad11c131fb1f6p+0, 0x1.0a4b7b784b2ffp-54}, 7461},
+    {{0x1.762dbbbad63f2p+0, 0x1.8e94db29e463bp-60}, 7471},
+    {{0x1.46aced659e0c2p+0, -0x1.bd2028554768dp-55}, 7481},
+    {{0x1.1d85a47d90e31p+0, 0x1.7b79925fbb6b1p-54}, 7491},
+    {{0x1.f3a9dfdbbd8d6p+0, 0x1.9814c02787fb6p-54}, 7500},
+    {{0x1.b5b18e583ccb2p+0, -0x1.890fa55abe442p-55}, 7510},
+    {{0x1.7fd6355461502p+0, -0x1.2164710427b58p-56}, 7520},
+    {{0x1.50fb4f51d46f1p+0, 0x1.c67bc471e688ep-54}, 7530},
+    {{0x1.282ce0b6ebb5ap+0, 0x1.a6e58f50373c9p-55}, 7540},
+    {{0x1.04997cb8f2e59p+0, 0x1.f032f8b2a9341p-56}, 7550},
+    {{0x1.cb1a66b9d3ea7p+0, 0x1.a29cc22c016b5p-60}, 7559},
+    {{0x1.94da88165ea00p+0, -0x1.d276d21e2d8e0p-55}, 7569},
+    {{0x1.6568ec23bf894p+0, -0x1.9bcce57ea4376p-55}, 7579},
+    {{0x1.3bdffab298071p+0, -0x1.81f8eae99650fp-54}, 7589},
+    {{0x1.1779ab4f03824p+0, -0x1.6b7ebbd7ab7eap-54}, 7599},
+    {{0x1.ef1608f878b73p+0, 0x1.2825fc7ae3666p-55}, 7608},
+    {{0x1.b70089f4530a7p+0, 0x1.9d335dc1ef478p-56}, 7618},
+    {{0x1.85b33a7622b70p+0, 0x1.56b2f63e99ea1p-54}, 7628},
+    {{0x1.5a50c673fbd9ap+0, 0x1.508c09d4a1c78p-54}, 7638},
+    {{0x1.34195c8daf4eep+0, 0x1.8b44adf75769ep-57}, 7648},
+    {{0x1.1266966e30224p+0, 0x1.8024abc127694p-59}, 7658},
+    {{0x1.e94fef3f7cd51p+0, 0x1.bad016445eec7p-55}, 7667},
+    {{0x1.b4bfd90c2aec3p+0, -0x1.0c1441ff945f3p-59}, 7677},
+    {{0x1.86426d319f5a9p+0, -0x1.0e7c58cfc8feap-54}, 7687},
+    {{0x1.5d196bad638c0p+0, -0x1.efa9db8ef65e3p-57}, 7697},
+    {{0x1.389f03ad05652p+0, -0x1.ddef6deee30ffp-56}, 7707},
+    {{0x1.18428dcb9c562p+0, 0x1.a0e276bc95dc5p-54}, 7717},
+    {{0x1.f70b7582f71cap+0, 0x1.108cf83efdf9ep-55}, 7726},
+    {{0x1.c3f44b93aa03cp+0, -0x1.9590ac7bb3e8cp-54}, 7736},
+    {{0x1.967e78f98fa9ep+0, -0x1.90c55f2242901p-54}, 7746},
+    {{0x1.6e00dfecb3da7p+0, -0x1.7366d8a163bafp-56}, 7756},
+    {{0x1.49e749d69b1d2p+0, 0x1.929d861e43adap-55}, 7766},
+    {{0x1.29afb3a0a5f75p+0, -0x1.5259edfd58773p-54}, 7776},
+    {{0x1.0ce7f702ddebap+0, 0x1.1eb88789cbacbp-55}, 7786},
+    {{0x1.e65787be2f5d3p+0, -0x1.64b8216ee4515p-54}, 7795},
+    {{0x1.b845bd226b609p+0, 0x1.ca124fbbdccf6p-54}, 7805},
+    {{0x1.8eff3367314f9p+0, -0x1.c0df67bdbfe41p-54}, 7815},
+    {{0x1.69fb06625e7c7p+0, -0x1.fe3aaddde556ap-54}, 7825},
+    {{0x1.48c07b4c56d00p+0, -0x1.c2c895d00d926p-55}, 7835},
+    {{0x1.2ae50019a7edap+0, -0x1.ccebef1a742b7p-54}, 7845},
+    {{0x1.100a6d1759d74p+0, 0x1.1f50d83b111e7p-60}, 7855},
+    {{0x1.efbaffcb0d36cp+0, -0x1.bf46f2df85d4ep-56}, 7864},
+    {{0x1.c429104fb48d7p+0, -0x1.77f73686e091bp-56}, 7874},
+    {{0x1.9cdc7ea4c71c2p+0, 0x1.d65b02fb2c398p-55}, 7884},
+    {{0x1.79618bc29dffcp+0, -0x1.d90867a334c9cp-54}, 7894},
+    {{0x1.59518222d5134p+0, -0x1.535fc3545c365p-56}, 7904},
+    {{0x1.3c5129b4e82e2p+0, 0x1.d2418f2673107p-57}, 7914},
+    {{0x1.220f6cfea3e85p+0, -0x1.a91c987edf7f3p-55}, 7924},
+    {{0x1.0a44290dc0764p+0, -0x1.9c7a7ff8ee537p-56}, 7934},
+    {{0x1.e95e4573c6395p+0, 0x1.a9e8dbccfdfbap-56}, 7943},
+    {{0x1.c22e38e400d9cp+0, -0x1.580c92733b16cp-54}, 7953},
+    {{0x1.9e9210e3f7c88p+0, 0x1.9ca9b08989572p-56}, 7963},
+    {{0x1.7e2ea792286cdp+0, 0x1.df1b1bafb2a71p-54}, 7973},
+    {{0x1.60b28e24a1ce7p+0, 0x1.dc931133927acp-56}, 7983},
+    {{0x1.45d4f450d77b4p+0, -0x1.f3ee88a6f6cb6p-54}, 7993},
+    {{0x1.2d54b0f1c3473p+0, 0x1.0da9271f97436p-54}, 8003},
+    {{0x1.16f767cfd1c8fp+0, -0x1.2a5a66c7c0f6ap-54}, 8013},
+    {{0x1.0288c8f5592b7p+0, 0x1.067fb83f606b7p-54}, 8023},
+    {{0x1.dfb3ccdf3c73ap+0, 0x1.b0efadd97e764p-58}, 8032},
+    {{0x1.bd813b8452646p+0, 0x1.1e4252f697a65p-55}, 8042},
+    {{0x1.9e2e255504995p+0, 0x1.aa21a92140fcap-55}, 8052},
+    {{0x1.8176723e5f87bp+0, 0x1.cd2ba74e65763p-56}, 8062},
+    {{0x1.671cd96f1bfffp+0, -0x1.3696b5285d9e6p-54}, 8072},
+    {{0x1.4eea27c85f5cfp+0, -0x1.b9521ae6ca9eep-55}, 8082},
+    {{0x1.38ac9b241107cp+0, 0x1.aff1638a2356cp-57}, 8092},
+    {{0x1.24374ffd74ea8p+0, -0x1.0628d3dc933cap-56}, 8102},
+    {{0x1.1161bf559ee16p+0, 0x1.cabccdcb2440dp-56}, 8112},
+    {{0x1.00074af06f8b9p+0, 0x1.aacf28dd7f99ep-55}, 8122},
+    {{0x1.e00dac82d125bp+0, 0x1.1022364fa7a04p-54}, 8131},
+    {{0x1.c284d525c4c7ap+0, 0x1.34c836f082204p-55}, 8141},
+    {{0x1.a73dca3dfb5d9p+0, -0x1.f5e9e8630dc0bp-55}, 8151},
+    {{0x1.8e075bf1ca244p+0, -0x1.a101dca593978p-54}, 8161},
+    {{0x1.76b4ed8e9f4c2p+0, -0x1.7892c0b7dff1ap-54}, 8171},
+    {{0x1.611e00dea79e7p+0, 0x1.e71fb3e2b8359p-54}, 8181},
+    {{0x1.4d1dcdd20b200p+0, -0x1.14ef2f9b3e72fp-55}, 8191},
+    {{0x1.3a92e51d1a017p+0, 0x1.7d3d906592e38p-54}, 8201},
+    {{0x1.295edc9582956p+0, 0x1.8190ca00136c2p-56}, 8211},
+    {{0x1.1966043c7ad1ep+0, -0x1.1ec92f365b67cp-54}, 8221},
+    {{0x1.0a8f23034a57dp+0, -0x1.63a99338fd95cp-54}, 8231},
+    {{0x1.f98674e6bd7d8p+0, -0x1.920862d253ae1p-56}, 8240},
+    {{0x1.dfdaa0f705de2p+0, -0x1.fb3beb9b4adc7p-57}, 8250},
+    {{0x1.c7f47d72b8535p+0, -0x1.08fc57cfa7710p-56}, 8260},
+    {{0x1.b1b10d529e534p+0, -0x1.320602c301e20p-55}, 8270},
+    {{0x1.9cf0546f6a3fcp+0, 0x1.e93d8dbda5ea3p-56}, 8280},
+    {{0x1.8995107a3144cp+0, 0x1.3493aac63088dp-54}, 8290},
+    {{0x1.778478f89581ep+0, -0x1.9b2c38a0d062fp-55}, 8300},
+    {{0x1.66a605896aca8p+0, 0x1.d7a621f5347ccp-54}, 8310},
+    {{0x1.56e339cb20d92p+0, 0x1.d760a7b96f721p-57}, 8320},
+    {{0x1.4827764f666fdp+0, -0x1.bf381fdee215fp-55}, 8330},
+    {{0x1.3a5fce1790e2ap+0, -0x1.55384244230bcp-54}, 8340},
+    {{0x1.2d7ae02399715p+0, -0x1.59cb9c62bcde5p-57}, 8350},
+    {{0x1.2168b4aa2c8c8p+0, 0x1.7981995406e63p-54}, 8360},
+    {{0x1.161a9d9b86cf1p+0, -0x1.d53d76a9415edp-54}, 8370},
+    {{0x1.0b831a1ada6cap+0, 0x1.85a1a09bb0de9p-54}, 8380},
+    {{0x1.0195bca2db51ap+0, -0x1.09a7bdb42c636p-55}, 8390},
+    {{0x1.f08e2723f1c9dp+0, 0x1.7bf191e696373p-54}, 8399},
+    {{0x1.df1927c3ae49cp+0, -0x1.4ad3d8750a217p-55}, 8409},
+    {{0x1.ceb90ba7be14cp+0, -0x1.f3c28d6785047p-54}, 8419},
+    {{0x1.bf5be6c4ac451p+0, -0x1.fb2a97b59519cp-54}, 8429},
+    {{0x1.b0f13094d5b7dp+0, -0x1.6f49e147ec2ecp-56}, 8439},
+    {{0x1.a369a7102f0a1p+0, 0x1.c306dc25332bcp-60}, 8449},
+    {{0x1.96b73441719d8p+0, 0x1.0faafb37d8970p-55}, 8459},
+    {{0x1.8accd63986c96p+0, 0x1.33dabc6ddadf4p-54}, 8469},
+    {{0x1.7f9e892865b83p+0, 0x1.691654bdf363ap-57}, 8479},
+    {{0x1.752133684af02p+0, 0x1.d7e6d70d98378p-54}, 8489},
+    {{0x1.6b4a934d4af65p+0, 0x1.2aeb01c3f8e81p-55}, 8499},
+    {{0x1.62112e8fd48f1p+0, 0x1.3ea81470fe2c5p-56}, 8509},
+    {{0x1.596c432cd19e9p+0, 0x1.89703cf89dfbep-55}, 8519},
+    {{0x1.5153b999c4b4ep+0, -0x1.17e4323a9adc0p-54}, 8529},
+    {{0x1.49c0182e9089dp+0, -0x1.139ad219c9e19p-54}, 8539},
+    {{0x1.42aa77a9906edp+0, 0x1.74510169c3f4cp-54}, 8549},
+    {{0x1.3c0c78b556389p+0, -0x1.1469f769d4001p-60}, 8559},
+    {{0x1.35e03a59cb897p+0, 0x1.47c3f069acf49p-54}, 8569},
+    {{0x1.30205144a102bp+0, -0x1.f350f24c49010p-54}, 8579},
+    {{0x1.2ac7bfd6ec2e2p+0, -0x1.e1140c13e370fp-55}, 8589},
+    {{0x1.25d1eee79ac26p+0, -0x1.ee8bbb7047752p-54}, 8599},
+    {{0x1.213aa72bfc575p+0, -0x1.1b46320a195d4p-56}, 8609},
+    {{0x1.1cfe0b3917650p+0, 0x1.df38054c63207p-54}, 8619},
+    {{0x1.19189211cf932p+0, 0x1.78aac139d7c58p-54}, 8629},
+    {{0x1.1587023715b08p+0, 0x1.e9e29645dbc84p-54}, 8639},
+    {{0x1.12466d30706f7p+0, 0x1.8424ee830a34fp-54}, 8649},
+    {{0x1.0f542b842b3a4p+0, 0x1.c5f311e643b1bp-55}, 8659},
+    {{0x1.0cadd91760ce3p+0, 0x1.e30864730810fp-56}, 8669},
+    {{0x1.0a5151eeec346p+0, 0x1.f2c99191053ecp-56}, 8679},
+    {{0x1.083caf4b0e5c0p+0, -0x1.b44700648732fp-54}, 8689},
+    {{0x1.066e45184b02ep+0, -0x1.f14b8423d7465p-54}, 8699},
+    {{0x1.04e49fb0a6925p+0, 0x1.fb3cda44bcf93p-55}, 8709},
+    {{0x1.039e81e909c22p+0, -0x1.793d31cc18f31p-55}, 8719},
+    {{0x1.029ae36720b86p+0, -0x1.43e1fa4d266d1p-54}, 8729},
+    {{0x1.01d8ef3c935fdp+0, 0x1.588779749b7e2p-57}, 8739},
+    {{0x1.015802c4f5162p+0, 0x1.87db35b7e1306p-57}, 8749},
+    {{0x1.0117acc443d8ep+0, -0x1.3110d822b1990p-54}, 8759},
+    {{0x1.0117acc443d8ep+0, -0x1.3110d822b1990p-54}, 8769},
+};
+
+// ln n!, correctly rounded.
+static const double log_fact_table[FACT_MAX + 1] = {
+    0x0.0p+0, 0x0.0p+0, 0x1.62e42fefa39efp-1,
+    0x1.cab0bfa2a2002p+0, 0x1.96ca77c922cf9p+1, 0x1.326643c4479c9p+2,
+    0x1.a51273acf01cap+2, 0x1.10ce1f32dcc30p+3, 0x1.5358e82fcb70dp+3,
+    0x1.99a8921a7f7cfp+3, 0x1.e357590954d15p+3, 0x1.180973f3a8d74p+4,
+    0x1.3fcba16d50143p+4, 0x1.68d5a9c3b32cep+4, 0x1.930f3df162a42p+4,
+    0x1.be636a63fd346p+4, 0x1.eabff061f1a84p+4, 0x1.0c0a63f2f353ap+5,
+    0x1.2329df2d5ee52p+5, 0x1.3ab8153363985p+5, 0x1.52af57aed77bep+5,
+    0x1.6b0a8643472a9p+5, 0x1.83c4faba84f06p+5, 0x1.9cda78b856a45p+5,
+    0x1.b6472034e8d14p+5, 0x1.d007622cd65e7p+5, 0x1.ea17f717c6794p+5,
+    0x1.023aeb67e4fefp+6, 0x1.0f8f18d330240p+6, 0x1.1d07353917231p+6,
+    0x1.2aa208b59d0e5p+6, 0x1.385e6fd9e5a40p+6, 0x1.463b59b942084p+6,
+    0x1.5437c633ace4ap+6, 0x1.6252c474896bap+6, 0x1.708b719e11658p+6,
+    0x1.7ee0f79b26758p+6, 0x1.8d528c1243d96p+6, 0x1.9bdf6f75257a3p+6,
+    0x1.aa86ec2969812p+6, 0x1.b94855c702ba2p+6, 0x1.c8230869ca105p+6,
+    0x1.d7166813e12eep+6, 0x1.e621e01eeba4fp+6, 0x1.f544e2ba69cf1p+6,
+    0x1.023f743addd9fp+7, 0x1.09e7b7ea41ea9p+7, 0x1.119afe762626bp+7,
+    0x1.19590c853a559p+7, 0x1.2121a930c6ec3p+7, 0x1.28f49ddeb1f31p+7,
+    0x1.30d1b61e86335p+7, 0x1.38b8bf8931ddbp+7, 0x1.40a989a33a6cdp+7,
+    0x1.48a3e5c12af19p+7, 0x1.50a7a6ee08711p+7, 0x1.58b4a1d39da73p+7,
+    0x1.60caaca474746p+7, 0x1.68e99f0757979p+7, 0x1.711152043b2c4p+7,
+    0x1.79419ff26dc59p+7, 0x1.817a6467f6fb9p+7, 0x1.89bb7c2a0aea1p+7,
+    0x1.9204c51e7c761p+7, 0x1.9a561e3e1a4bdp+7, 0x1.a2af6787e4609p+7,
+    0x1.ab1081f509726p+7, 0x1.b3794f6d9d7afp+7, 0x1.bbe9b2bdfb621p+7,
+    0x1.c4618f8cc56f7p+7, 0x1.cce0ca5179100p+7, 0x1.d567484b8b7b6p+7,
+    0x1.ddf4ef7a05a70p+7, 0x1.e689a69396befp+7, 0x1.ef2554ff15148p+7,
+    0x1.f7c7e2cc66183p+7, 0x1.00389c56e3462p+8, 0x1.04909ff8b652bp+8,
+    0x1.08ebf13dbf263p+8, 0x1.0d4a85602b129p+8, 0x1.11ac51df8932ap+8,
+    0x1.16114c7e34736p+8, 0x1.1a796b3ede1acp+8, 0x1.1ee4a46236d3ep+8,
+    0x1.2352ee64b46d5p+8, 0x1.27c43ffc72962p+8, 0x1.2c3890172d057p+8,
+    0x1.30afd5d851956p+8, 0x1.352a089728f1bp+8, 0x1.39a71fdd14947p+8,
+    0x1.3e271363e0df7p+8, 0x1.42a9db142a36ap+8, 0x1.472f6f03d410cp+8,
+    0x1.4bb7c77491066p+8, 0x1.5042dcd27af64p+8, 0x1.54d0a7b2ba658p+8,
+    0x1.596120d23c4ecp+8, 0x1.5df4411475a1cp+8, 0x1.628a018233bedp+8,
+    0x1.67225b4879462p+8, 0x1.6bbd47b7669b6p+8, 0x1.705ac0412d89fp+8,
+    0x1.74fabe790f7bep+8, 0x1.799d3c1265c0ep+8, 0x1.7e4232dfb367dp+8,
+    0x1.82e99cd1c0368p+8, 0x1.879373f6bc4fep+8, 0x1.8c3fb2796c21cp+8,
+    0x1.90ee52a05c35fp+8, 0x1.959f4ecd1c8b3p+8, 0x1.9a52a17b831ccp+8,
+    0x1.9f084540f545ep+8, 0x1.a3c034cbb7b2cp+8, 0x1.a87a6ae24493ap+8,
+    0x1.ad36e262a7cc0p+8, 0x1.b1f59641e0db5p+8, 0x1.b6b6818b4a3ebp+8,
+    0x1.bb799f600610ap+8, 0x1.c03eeaf66facdp+8, 0x1.c5065f9992226p+8,
+    0x1.c9cff8a8a340dp+8, 0x1.ce9bb196830eap+8, 0x1.d36985e93f7b8p+8,
+    0x1.d83971399c213p+8, 0x1.dd0b6f329dea4p+8, 0x1.e1df7b911a74cp+8,
+    0x1.e6b592234b0c9p+8, 0x1.eb8daec863182p+8, 0x1.f067cd7029d4dp+8,
+    0x1.f543ea1a97428p+8, 0x1.fa2200d7741ebp+8, 0x1.ff020dc5fcd0cp+8,
+    0x1.01f2068a4395cp+9, 0x1.0463fd801573cp+9, 0x1.06d6e9ea365edp+9,
+    0x1.094ac9f576038p+9, 0x1.0bbf9bd589663p+9, 0x1.0e355dc4e4164p+9,
+    0x1.10ac0e0492828p+9, 0x1.1323aadc1563ep+9, 0x1.159c32993e34fp+9,
+    0x1.1815a3900cac1p+9, 0x1.1a8ffc1a8d2fep+9, 0x1.1d0b3a98b83c1p+9,
+    0x1.1f875d7052afep+9, 0x1.2204630ccefc3p+9, 0x1.248249df2f2b1p+9,
+    0x1.2701105de7b8dp+9, 0x1.2980b504c3372p+9, 0x1.2c013654c6b40p+9,
+    0x1.2e8292d416dddp+9, 0x1.3104c90dddddep+9, 0x1.3387d79231e3dp+9,
+    0x1.360bbcf5fc5bfp+9, 0x1.389077d2e1cb2p+9, 0x1.3b1606c72a4a4p+9,
+    0x1.3d9c6875aa9cfp+9, 0x1.40239b85adddfp+9, 0x1.42ab9ea2dfbd1p+9,
+    0x1.4534707d3748fp+9, 0x1.47be0fc8e241ep+9, 0x1.4a487b3e30effp+9,
+    0x1.4cd3b19982794p+9, 0x1.4f5fb19b31b3fp+9, 0x1.51ec7a0782708p+9,
+    0x1.547a09a68f387p+9, 0x1.57085f44377dfp+9, 0x1.599779b00e38ep+9,
+    0x1.5c2757bd48ee8p+9, 0x1.5eb7f842af200p+9, 0x1.61495a1a8a1d5p+9,
+};
+
+static DoubleDouble dd_mul(DoubleDouble a, DoubleDouble b) {
+    double e, p = vm_two_prod(a.hi, b.hi, &e);
+    e += a.hi * b.lo + a.lo * b.hi;
+    double hi = p + e;
+    return (DoubleDouble){ hi, e - (hi - p) };
+}
+
+static DoubleDouble dd_mul_d(DoubleDouble a, double b) {
+    double e, p = vm_two_prod(a.hi, b, &e);
+    e += a.lo * b;
+    double hi = p + e;
+    return (DoubleDouble){ hi, e - (hi - p) };
+}
+
+// a / b, rounded to a double.
+static double dd_div(DoubleDouble a, DoubleDouble b) {
+    double q = a.hi / b.hi;
+    double e, p = vm_two_prod(q, b.hi, &e);
+    double r = (a.hi - p) - e + a.lo - q * b.lo;
+    return q + r / b.hi;
+}
+
+static DoubleDouble dd_div_d(DoubleDouble a, double b) {
+    double q = a.hi / b;
+    double e, p = vm_two_prod(q, b, &e);
+    double r = ((a.hi - p) - e + a.lo) / b;
+    double hi = q + r;
+    return (DoubleDouble){ hi, r - (hi - q) };
+}
+
+// What Stirling's formula leaves out of ln x!, in terms of x1 = x + 1:
+// ln x! = (x1 - 1/2) ln x1 - x1 + ln sqrt(2 pi) + stirling_tail(x1). Past
+// the table the next term of the series is below 2^-60.
+static double stirling_tail(double x1) {
+    double r = 1.0 / x1, r2 = r * r;
+    return r * (1.0 / 12 - r2 * (1.0 / 360 - r2 * (1.0 / 1260)));
+}
+
+// ln x! for an integer x > FACT_MAX. lgamma would do, but it writes the
+// global signgam, which worker threads would race on.
+static double log_fact_large(double x) {
+    double x1 = x + 1.0;
+    return (x1 - 0.5) * log(x1) - x1 + 0.91893853320467274178 + stirling_tail(x1);
+}
+
+// ln(n!/(n - k)!) for integers 0 <= k <= n, n > FACT_MAX. When n - k is
+// past the table too the two Stirling series are subtracted term by term,
+// so the error is a few ulps of k ln n rather than of n ln n.
+static double log_fact_ratio(double n, double k) {
+    double m = n - k, m1 = m + 1.0;
+    if (m <= FACT_MAX) return log_fact_large(n) - log_fact_table[(int)m];
+    return (m + 0.5) * log1p(k / m1) + k * log(n + 1.0) - k
+        + stirling_tail(n + 1.0) - stirling_tail(m1);
+}
+
+double factorial_double(double x, int *err) {
+    *err = 0;
+    if (x == floor(x)) {
+        // negative integers are poles of gamma; past 170 overflows
+        if (x < 0 || x > FACT_MAX) { *err = 1; return 0.0; }
+        return ldexp(fact_table[(int)x].mant.hi, fact_table[(int)x].exp);
+    }
+    double r = tgamma(x + 1.0);
+    if (!isfinite(r)) { *err = 1; return 0.0; }
+    return r;
+}
+
+static int fn_fact(const double *args, double *out) {
+    int err = 0;
+    *out = factorial_double(args[0], &err);
+    return !err;
+}
+
+// Arguments of nCr and nPr rounded to integers, with 0 <= k <= n.
+static int count_args(const double *args, double *n, double *k) {
+    *n = floor(args[0] + 0.5);
+    *k = floor(args[1] + 0.5);
+    return isfinite(*n) && *k >= 0 && *k <= *n;
+}
+
+// n! / (k! m!), or n! / m! when k is negative, from the table.
+static double fact_quotient(int n, int k, int m) {
+    DoubleDouble d = fact_table[m].mant;
+    int e = fact_table[n].exp - fact_table[m].exp;
+    if (k >= 0) {
+        d = dd_mul(d, fact_table[k].mant);
+        e -= fact_table[k].exp;
+    }
+    return ldexp(dd_div(fact_table[n].mant, d), e);
+}
+
+/*
+  n <= 1024 divides table entries, within half an ulp plus 2^-100 relative
+  (so exact below 2^53; only exact halfway cases can round the wrong way).
+  Past that, k <= PRODUCT_MAX multiplies k factors in double-double, within
+  half an ulp plus 2^-98. Larger k is exp of a log-space sum, within about
+  4e-13 relative: its error is a few ulps of the logarithm, which stays
+  below about 1400 wherever the result is finite.
+*/
+static int fn_ncr(const double *args, double *out) {
+    double n, k;
+    if (!count_args(args, &n, &k)) return 0;
+    if (k > n - k) k = n - k;
+    if (n <= FACT_TABLE_MAX) {
+        *out = fact_quotient((int)n, (int)k, (int)(n - k));
+    } else if (k <= PRODUCT_MAX) {
+        DoubleDouble r = { 1.0, 0.0 };
+        for (int i = 1; i <= (int)k; ++i) r = dd_div_d(dd_mul_d(r, n - k + i), i);
+        *out = r.hi;
+    } else if (k <= FACT_MAX) {
+        *out = exp(log_fact_ratio(n, k) - log_fact_table[(int)k]);
+    } else {
+        // all three factorials past FACT_MAX: Stirling's series regrouped
+        // so that no two large terms cancel
+        double n1 = n + 1.0, k1 = k + 1.0, m1 = n - k + 1.0;
+        *out = exp((k1 - 0.5) * log(n1 / k1) + (m1 - 0.5) * log1p(k / m1) - 0.5 * log(n1)
+                   + (1.0 - 0.91893853320467274178)
+                   + stirling_tail(n1) - stirling_tail(k1) - stirling_tail(m1));
+    }
+    return 1;
+}
+
+static int fn_npr(const double *args, double *out) {
+    double n, k;
+    if (!count_args(args, &n, &k)) return 0;
+    if (n <= FACT_TABLE_MAX) {
+        *out = fact_quotient((int)n, -1, (int)(n - k));
+    } else if (k <= PRODUCT_MAX) {
+        DoubleDouble r = { 1.0, 0.0 };
+        for (int i = 0; i < (int)k; ++i) r = dd_mul_d(r, n - i);
+        *out = r.hi;
+    } else {
+        *out = exp(log_fact_ratio(n, k));
+    }
+    return 1;
+}
+
+/* ---------- Built-in registry ---------- */
+
+typedef enum {
+    FN_SIN, FN_COS, FN_TAN, FN_ASIN, FN_ACOS, FN_ATAN,
+    FN_SINH, FN_COSH, FN_TANH,
+    FN_SQRT, FN_CBRT, FN_LN, FN_LOG, FN_EXP, FN_POW,
+    FN_ABS, FN_FLOOR, FN_CEIL, FN_FACT, FN_NCR, FN_NPR,
+    FN_GCD, FN_LCM,
+    FN_COUNT
+} FuncId;
+
+// Where a function meets the angle mode: its argument or its result is
+// converted between degrees and radians around the kernel in degree mode.
+typedef enum { ANGLE_NONE, ANGLE_ARG, ANGLE_RESULT } AngleUse;
+
+typedef struct {
+    const char *name;
+    const char *alias; // second accepted spelling, or NULL
+    int arity;
+    FuncKernel kernel;
+    VecKernel vec; // column kernel, or NULL to call kernel per row
+    AngleUse angle;
+    int integer;   // integers give an integer (see Integer evaluation)
+} FuncInfo;
+
+static const FuncInfo func_info[FN_COUNT] = {
+    [FN_SIN] = {"sin", NULL, 1, fn_sin, vfn_sin, ANGLE_ARG},
+    [FN_COS] = {"cos", NULL, 1, fn_cos, vfn_cos, ANGLE_ARG},
+    [FN_TAN] = {"tan", NULL, 1, fn_tan, vfn_tan, ANGLE_ARG},
+    [FN_ASIN] = {"asin", NULL, 1, fn_asin, vfn_asin, ANGLE_RESULT},
+    [FN_ACOS] = {"acos", NULL, 1, fn_acos, vfn_acos, ANGLE_RESULT},
+    [FN_ATAN] = {"atan", NULL, 1, fn_atan, vfn_atan, ANGLE_RESULT},
+    [FN_SINH] = {"sinh", NULL, 1, fn_sinh, vfn_sinh},
+    [FN_COSH] = {"cosh", NULL, 1, fn_cosh, vfn_cosh},
+    [FN_TANH] = {"tanh", NULL, 1, fn_tanh, vfn_tanh},
+    [FN_SQRT] = {"sqrt", NULL, 1, fn_sqrt},
+    [FN_CBRT] = {"cbrt", NULL, 1, fn_cbrt},
+    [FN_LN] = {"ln", NULL, 1, fn_ln, vfn_ln},
+    [FN_LOG] = {"log", NULL, 1, fn_log, vfn_log},
+    [FN_EXP] = {"exp", NULL, 1, fn_exp, vfn_exp},
+    [FN_POW] = {"pow", NULL, 2, fn_pow, vfn_pow, ANGLE_NONE, 1},
+    [FN_ABS] = {"abs", NULL, 1, fn_abs, NULL, ANGLE_NONE, 1},
+    [FN_FLOOR] = {"floor", NULL, 1, fn_floor, NULL, ANGLE_NONE, 1},
+    [FN_CEIL] = {"ceil", NULL, 1, fn_ceil, NULL, ANGLE_NONE, 1},
+    [FN_FACT] = {"fact", "factorial", 1, fn_fact, NULL, ANGLE_NONE, 1},
+    [FN_NCR] = {"nCr", NULL, 2, fn_ncr, NULL, ANGLE_NONE, 1},
+    [FN_NPR] = {"nPr", NULL, 2, fn_npr, NULL, ANGLE_NONE, 1},
+    [FN_GCD] = {"gcd", NULL, 2, fn_gcd, NULL, ANGLE_NONE, 1},
+    [FN_LCM] = {"lcm", NULL, 2, fn_lcm, NULL, ANGLE_NONE, 1},
+};
+
+typedef enum { CONST_PI, CONST_E, CONST_MEM, CONST_COUNT } ConstId;
+
+typedef struct {
+    const char *name;
+    double value; // unused for CONST_MEM, which reads the memory at run time
+    const char *note;
+} ConstInfo;
+
+static const ConstInfo const_info[CONST_COUNT] = {
+    [CONST_PI] = {"pi", M_PI, NULL},
+    [CONST_E] = {"e", M_E, NULL},
+    [CONST_MEM] = {"M", 0.0, "memory recall"},
+};
+
+typedef enum { SYM_NONE, SYM_FUNCTION, SYM_CONSTANT } SymbolKind;
+
+typedef struct {
+    SymbolKind kind;
+    int id; // FuncId or ConstId
+} Symbol;
+
+/*
+  Every function name, alias and constant is found through a perfect hash:
+  FNV-1a over the lowercased name starting from REGISTRY_SEED, top 6 bits
+  select a slot. registry_slots holds 1 + the index into registry_names, or
+  0 for an empty slot. Both tables are generated: after adding a name,
+  build with -DCALC_GEN_REGISTRY and run the binary to print new ones.
+*/
+
+#define REGISTRY_SEED 0xdu
+#define REGISTRY_BITS 6
+
+typedef struct {
+    const char *name;
+    SymbolKind kind;
+    int id;
+} RegistryName;
+
+static const RegistryName registry_names[] = {
+    {"sin", SYM_FUNCTION, FN_SIN}, {"cos", SYM_FUNCTION, FN_COS},
+    {"tan", SYM_FUNCTION, FN_TAN}, {"asin", SYM_FUNCTION, FN_ASIN},
+    {"acos", SYM_FUNCTION, FN_ACOS}, {"atan", SYM_FUNCTION, FN_ATAN},
+    {"sinh", SYM_FUNCTION, FN_SINH}, {"cosh", SYM_FUNCTION, FN_COSH},
+    {"tanh", SYM_FUNCTION, FN_TANH}, {"sqrt", SYM_FUNCTION, FN_SQRT},
+    {"cbrt", SYM_FUNCTION, FN_CBRT}, {"ln", SYM_FUNCTION, FN_LN},
+    {"log", SYM_FUNCTION, FN_LOG}, {"exp", SYM_FUNCTION, FN_EXP},
+    {"pow", SYM_FUNCTION, FN_POW}, {"abs", SYM_FUNCTION, FN_ABS},
+    {"floor", SYM_FUNCTION, FN_FLOOR}, {"ceil", SYM_FUNCTION, FN_CEIL},
+    {"fact", SYM_FUNCTION, FN_FACT}, {"factorial", SYM_FUNCTION, FN_FACT},
+    {"nCr", SYM_FUNCTION, FN_NCR}, {"nPr", SYM_FUNCTION, FN_NPR},
+    {"gcd", SYM_FUNCTION, FN_GCD}, {"lcm", SYM_FUNCTION, FN_LCM},
+    {"pi", SYM_CONSTANT, CONST_PI}, {"e", SYM_CONSTANT, CONST_E},
+    {"M", SYM_CONSTANT, CONST_MEM},
+};
+
+static const unsigned char registry_slots[1u << REGISTRY_BITS] = {
+     0,  4,  1,  0, 19,  0,  0,  0,  9,  0, 10,  0,  5,  0,  0,  0,
+    20, 18, 11,  0,  0,  2,  0,  0, 27, 16, 26,  0,  0, 25,  0,  7,
+    23,  0,  0,  0, 12,  0,  0,  0, 22, 21,  0, 14, 15,  0,  0,  0,
+    17,  0, 13,  0, 24,  0,  0,  0,  0,  3,  6,  8,  0,  0,  0,  0,
+};
+
+static unsigned name_hash(const char *s, size_t len, unsigned seed) {
+    unsigned h = seed;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)tolower((unsigned char)s[i]);
+        h *= 0x01000193u;
+    }
+    return h & 0xffffffffu;
+}
+
+static unsigned registry_hash(const char *s, size_t len, unsigned seed) {
+    return name_hash(s, len, seed) >> (32 - REGISTRY_BITS);
+}
+
+int span_eq_nocase(const char *s, size_t len, const char *name) {
+    for (size_t i = 0; i < len; ++i, ++name) {
+        if (*name == '\0' || tolower((unsigned char)s[i]) != tolower((unsigned char)*name)) return 0;
+    }
+    return *name == '\0';
+}
+
+// Looks up the len bytes at s, case-insensitively.
+Symbol registry_lookup(const char *s, size_t len) {
+    Symbol sym = { SYM_NONE, -1 };
+    unsigned slot = registry_slots[registry_hash(s, len, REGISTRY_SEED)];
+    if (slot == 0) return sym;
+    const RegistryName *r = &registry_names[slot - 1];
+    if (!span_eq_nocase(s, len, r->name)) return sym;
+    sym.kind = r->kind;
+    sym.id = r->id;
+    return sym;
+}
+
+#ifdef CALC_GEN_REGISTRY
+// Finds a seed that places every registry name in its own slot and prints
+// the tables to paste above.
+int main(void) {
+    const size_t n = sizeof(registry_names)/sizeof(registry_names[0]);
+    for (unsigned seed = 1; seed != 0; ++seed) {
+        unsigned char slots[1u << REGISTRY_BITS] = {0};
+        size_t i;
+        for (i = 0; i < n; ++i) {
+            const char *name = registry_names[i].name;
+            unsigned h = registry_hash(name, strlen(name), seed);
+            if (slots[h]) break;
+            slots[h] = (unsigned char)(i + 1);
+        }
+        if (i < n) continue;
+        printf("#define REGISTRY_SEED 0x%xu\n", seed);
+        for (i = 0; i < (1u << REGISTRY_BITS); ++i)
+            printf("%s%2u,%s", (i % 16 == 0) ? "    " : " ", slots[i], (i % 16 == 15) ? "\n" : "");
+        return 0;
+    }
+    fprintf(stderr, "No perfect seed; raise REGISTRY_BITS\n");
+    return 1;
+}
+#define main calculator_main
+#endif
+
+/* ---------- Variables ---------- */
+
+/*
+  User variables live in numbered slots, and compiled programs load and
+  store them by slot index. Names reach slots through an open-addressing
+  hash table (the registry's case-insensitive FNV-1a) holding slot + 1, or
+  0 for an empty entry. Compiling an assignment creates the slot; lookups
+  only see it once a value has been stored.
+*/
+
+#define VAR_INIT_CAP 16
+#define VAR_HASH_SEED 0x811c9dc5u
+
+typedef struct {
+    char **names;
+    double *values;
+    unsigned char *defined;
+    int count;
+    int capacity;
+    int *index;
+    unsigned index_mask;
+} VarTable;
+
+static int var_find(const VarTable *t, const char *s, size_t len) {
+    if (!t->index) return -1;
+    for (unsigned i = name_hash(s, len, VAR_HASH_SEED) & t->index_mask; t->index[i]; i = (i + 1) & t->index_mask) {
+        int slot = t->index[i] - 1;
+        if (span_eq_nocase(s, len, t->names[slot])) return slot;
+    }
+    return -1;
+}
+
+// Slot of an assigned variable, or -1.
+int var_lookup(const VarTable *t, const char *s, size_t len) {
+    int slot = var_find(t, s, len);
+    return slot >= 0 && t->defined[slot] ? slot : -1;
+}
+
+static void var_index_insert(VarTable *t, int slot) {
+    const char *name = t->names[slot];
+    unsigned i = name_hash(name, strlen(name), VAR_HASH_SEED) & t->index_mask;
+    while (t->index[i]) i = (i + 1) & t->index_mask;
+    t->index[i] = slot + 1;
+}
+
+// Slot for the name, created (unassigned) if it is new.
+int var_intern(VarTable *t, const char *s, size_t len) {
+    int slot = var_find(t, s, len);
+    if (slot >= 0) return slot;
+    if (t->count == t->capacity) {
+        t->capacity = t->capacity ? t->capacity * 2 : VAR_INIT_CAP;
+        t->names = (char**)realloc(t->names, sizeof(char*) * t->capacity);
+        t->values = (double*)realloc(t->values, sizeof(double) * t->capacity);
+        t->defined = (unsigned char*)realloc(t->defined, t->capacity);
+        if (!t->names || !t->values || !t->defined) { perror("realloc"); exit(1); }
+    }
+    // keep the index at most half full
+    if (!t->index || (unsigned)(t->count + 1) * 2 > t->index_mask + 1) {
+        unsigned size = t->index ? (t->index_mask + 1) * 2 : VAR_INIT_CAP * 2;
+        free(t->index);
+        t->index = (int*)calloc(size, sizeof(int));
+        if (!t->index) { perror("calloc"); exit(1); }
+        t->index_mask = size - 1;
+        for (int i = 0; i < t->count; ++i) var_index_insert(t, i);
+    }
+    slot = t->count++;
+    t->names[slot] = (char*)malloc(len + 1);
+    if (!t->names[slot]) { perror("malloc"); exit(1); }
+    memcpy(t->names[slot], s, len);
+    t->names[slot][len] = '\0';
+    t->values[slot] = 0.0;
+    t->defined[slot] = 0;
+    var_index_insert(t, slot);
+    return slot;
+}
+
+// Makes dst an independent copy of src, with the same slots.
+void var_copy(VarTable *dst, const VarTable *src) {
+    memset(dst, 0, sizeof(*dst));
+    if (!src->capacity) return;
+    dst->count = src->count;
+    dst->capacity = src->capacity;
+    dst->index_mask = src->index_mask;
+    dst->names = (char**)malloc(sizeof(char*) * src->capacity);
+    dst->values = (double*)malloc(sizeof(double) * src->capacity);
+    dst->defined = (unsigned char*)malloc(src->capacity);
+    dst->index = (int*)malloc(sizeof(int) * (src->index_mask + 1));
+    if (!dst->names || !dst->values || !dst->defined || !dst->index) { perror("malloc"); exit(1); }
+    for (int i = 0; i < src->count; ++i) {
+        dst->names[i] = strdup(src->names[i]);
+        if (!dst->names[i]) { perror("strdup"); exit(1); }
+    }
+    memcpy(dst->values, src->values, sizeof(double) * src->count);
+    memcpy(dst->defined, src->defined, src->count);
+    memcpy(dst->index, src->index, sizeof(int) * (src->index_mask + 1));
+}
+
+void var_free(VarTable *t) {
+    for (int i = 0; i < t->count; ++i) free(t->names[i]);
+    free(t->names);
+    free(t->values);
+    free(t->defined);
+    free(t->index);
+    memset(t, 0, sizeof(*t));
+}
+
+/*
+  If line (leading blanks skipped) reads "name = expr", returns the length
+  of name, stores where it starts in *name and where expr starts in *expr.
+  Returns 0 for anything else, including "==".
+*/
+size_t assignment_target(const char *line, const char **name, const char **expr) {
+    const char *p = line;
+    while (isspace((unsigned char)*p)) p++;
+    if (!is_identifier_char(*p)) return 0;
+    const char *start = p;
+    while (is_identifier_char(*p) || isdigit((unsigned char)*p) || *p == '.') p++;
+    size_t len = (size_t)(p - start);
+    while (isspace((unsigned char)*p)) p++;
+    if (*p != '=' || p[1] == '=') return 0;
+    if (name) *name = start;
+    if (expr) *expr = p + 1;
+    return len;
+}
+
+/* ---------- Number scanner ---------- */
+
+/*
+  Literals are converted straight from the input line. Decimal literals with
+  at most 19 significant digits take Clinger's exact path (mantissa <= 2^53,
+  |exponent| <= 22) or the Eisel-Lemire algorithm below; anything they cannot
+  decide exactly (more digits, subnormals, halfway ties) falls back to strtod,
+  so every literal is correctly rounded.
+*/
+
+static const double exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define POW5_MIN_EXP (-342)
+#define POW5_MAX_EXP 308
+
+/*
+  5^q for q in [POW5_MIN_EXP, POW5_MAX_EXP], normalized so the top bit is set
+  and kept to 128 bits (high word first). Positive powers are truncated,
+  negative ones are 2^b / 5^-q rounded up, as in Lemire's "Number Parsing at
+  a Gigabyte per Second".
+*/
+static const uint64_t pow5_128[POW5_MAX_EXP - POW5_MIN_EXP + 1][2] = {
+    {0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL},
+    {0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL},
+    {0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL},
+    {0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL},
+    {0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL},
+    {0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL},
+    {0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL},
+    {0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL},
+    {0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL},
+    {0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL},
+    {0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL},
+    {0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL},
+    {0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL},
+    {0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL},
+    {0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL},
+    {0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL},
+    {0x84a57695fe98746dULL, 0x014bb630f7604b57ULL},
+    {0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL},
+    {0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL},
+    {0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL},
+    {0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL},
+    {0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL},
+    {0xfd00b897478238d0ULL, 0x8920b098955522b4ULL},
+    {0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL},
+    {0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL},
+    {0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL},
+    {0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL},
+    {0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL},
+    {0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL},
+    {0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL},
+    {0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL},
+    {0xeba09271e88d976bULL, 0xf7864a44c633682eULL},
+    {0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL},
+    {0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL},
+    {0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL},
+    {0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL},
+    {0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL},
+    {0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL},
+    {0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL},
+    {0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL},
+    {0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL},
+    {0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL},
+    {0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL},
+    {0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL},
+    {0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL},
+    {0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL},
+    {0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL},
+    {0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL},
+    {0xa37fce126597973cULL, 0xe50ff107bab528a0ULL},
+    {0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL},
+    {0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL},
+    {0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL},
+    {0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL},
+    {0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL},
+    {0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL},
+    {0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL},
+    {0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL},
+    {0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL},
+    {0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL},
+    {0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL},
+    {0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL},
+    {0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL},
+    {0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL},
+    {0x91376c36d99995beULL, 0x23100809b9c21fa1ULL},
+    {0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL},
+    {0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL},
+    {0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL},
+    {0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL},
+    {0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL},
+    {0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL},
+    {0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL},
+    {0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL},
+    {0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL},
+    {0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL},
+    {0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL},
+    {0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL},
+    {0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL},
+    {0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL},
+    {0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL},
+    {0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL},
+    {0xc987434744ac874eULL, 0xa327ffb266b56220ULL},
+    {0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL},
+    {0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL},
+    {0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL},
+    {0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL},
+    {0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL},
+    {0xc0314325637a1939ULL, 0xfa911155fefb5308ULL},
+    {0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL},
+    {0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL},
+    {0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL},
+    {0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL},
+    {0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL},
+    {0xb749faed14125d36ULL, 0xcef980ec671f667bULL},
+    {0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL},
+    {0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL},
+    {0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL},
+    {0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL},
+    {0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL},
+    {0xaecc49914078536dULL, 0x58fae9f773886e18ULL},
+    {0xda7f5bf590966848ULL, 0xaf39a475506a899eULL},
+    {0x888f99797a5e012dULL, 0x6d8406c952429603ULL},
+    {0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL},
+    {0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL},
+    {0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL},
+    {0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL},
+    {0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL},
+    {0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL},
+    {0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL},
+    {0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL},
+    {0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL},
+    {0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL},
+    {0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL},
+    {0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL},
+    {0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL},
+    {0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL},
+    {0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL},
+    {0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL},
+    {0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL},
+    {0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL},
+    {0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL},
+    {0xb913179899f68584ULL, 0x28e2557b59846e3fULL},
+    {0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL},
+    {0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL},
+    {0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL},
+    {0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL},
+    {0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL},
+    {0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL},
+    {0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL},
+    {0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL},
+    {0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL},
+    {0xd77485cb25823ac7ULL, 0x7d633293366b828bULL},
+    {0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL},
+    {0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL},
+    {0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL},
+    {0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL},
+    {0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL},
+    {0xcd795be870516656ULL, 0x67902e276c921f8bULL},
+    {0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL},
+    {0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL},
+    {0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL},
+    {0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL},
+    {0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL},
+    {0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL},
+    {0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL},
+    {0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL},
+    {0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL},
+    {0xef340a98172aace4ULL, 0x86fb897116c87c34ULL},
+    {0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL},
+    {0xbae0a846d2195712ULL, 0x8974836059cca109ULL},
+    {0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL},
+    {0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL},
+    {0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL},
+    {0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL},
+    {0x8e938662882af53eULL, 0x547eb47b7282ee9cULL},
+    {0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL},
+    {0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL},
+    {0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL},
+    {0xae0b158b4738705eULL, 0x9624ab50b148d445ULL},
+    {0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL},
+    {0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL},
+    {0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL},
+    {0xd47487cc8470652bULL, 0x7647c3200069671fULL},
+    {0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL},
+    {0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL},
+    {0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL},
+    {0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL},
+    {0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL},
+    {0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL},
+    {0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL},
+    {0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL},
+    {0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL},
+    {0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL},
+    {0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL},
+    {0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL},
+    {0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL},
+    {0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL},
+    {0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL},
+    {0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL},
+    {0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL},
+    {0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL},
+    {0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL},
+    {0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL},
+    {0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL},
+    {0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL},
+    {0x8c974f7383725573ULL, 0x1e414218c73a13fbULL},
+    {0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL},
+    {0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL},
+    {0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL},
+    {0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL},
+    {0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL},
+    {0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL},
+    {0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL},
+    {0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL},
+    {0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL},
+    {0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL},
+    {0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL},
+    {0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL},
+    {0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL},
+    {0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL},
+    {0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL},
+    {0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL},
+    {0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL},
+    {0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL},
+    {0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL},
+    {0xbe89523386091465ULL, 0xf6bbb397f1135823ULL},
+    {0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL},
+    {0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL},
+    {0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL},
+    {0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL},
+    {0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL},
+    {0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL},
+    {0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL},
+    {0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL},
+    {0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL},
+    {0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL},
+    {0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL},
+    {0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL},
+    {0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL},
+    {0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL},
+    {0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL},
+    {0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL},
+    {0x843610cb4bf160cbULL, 0xcedf722a585139baULL},
+    {0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL},
+    {0xce947a3da6a9273eULL, 0x733d226229feea32ULL},
+    {0x811ccc668829b887ULL, 0x0806357d5a3f525fULL},
+    {0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL},
+    {0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL},
+    {0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL},
+    {0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL},
+    {0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL},
+    {0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL},
+    {0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL},
+    {0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL},
+    {0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL},
+    {0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL},
+    {0xbbe226efb628afeaULL, 0x890489f70a55368bULL},
+    {0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL},
+    {0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL},
+    {0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL},
+    {0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL},
+    {0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL},
+    {0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL},
+    {0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL},
+    {0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL},
+    {0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL},
+    {0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL},
+    {0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL},
+    {0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL},
+    {0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL},
+    {0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL},
+    {0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL},
+    {0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL},
+    {0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL},
+    {0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL},
+    {0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL},
+    {0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL},
+    {0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL},
+    {0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL},
+    {0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL},
+    {0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL},
+    {0xc24452da229b021bULL, 0xfbe85badce996168ULL},
+    {0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL},
+    {0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL},
+    {0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL},
+    {0xed246723473e3813ULL, 0x290123e9aab23b68ULL},
+    {0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL},
+    {0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL},
+    {0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL},
+    {0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL},
+    {0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL},
+    {0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL},
+    {0x8d590723948a535fULL, 0x579c487e5a38ad0eULL},
+    {0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL},
+    {0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL},
+    {0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL},
+    {0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL},
+    {0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL},
+    {0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL},
+    {0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL},
+    {0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL},
+    {0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL},
+    {0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL},
+    {0xcdb02555653131b6ULL, 0x3792f412cb06794dULL},
+    {0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL},
+    {0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL},
+    {0xc8de047564d20a8bULL, 0xf245825a5a445275ULL},
+    {0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL},
+    {0x9ced737bb6c4183dULL, 0x55464dd69685606bULL},
+    {0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL},
+    {0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL},
+    {0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL},
+    {0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL},
+    {0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL},
+    {0x95a8637627989aadULL, 0xdde7001379a44aa8ULL},
+    {0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL},
+    {0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL},
+    {0x9226712162ab070dULL, 0xcab3961304ca70e8ULL},
+    {0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL},
+    {0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL},
+    {0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL},
+    {0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL},
+    {0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL},
+    {0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL},
+    {0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL},
+    {0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL},
+    {0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL},
+    {0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL},
+    {0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL},
+    {0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL},
+    {0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL},
+    {0xcfb11ead453994baULL, 0x67de18eda5814af2ULL},
+    {0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL},
+    {0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL},
+    {0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL},
+    {0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL},
+    {0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL},
+    {0xc612062576589ddaULL, 0x95364afe032a819eULL},
+    {0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL},
+    {0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL},
+    {0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL},
+    {0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL},
+    {0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL},
+    {0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL},
+    {0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL},
+    {0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL},
+    {0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL},
+    {0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL},
+    {0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL},
+    {0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL},
+    {0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL},
+    {0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL},
+    {0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL},
+    {0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL},
+    {0x89705f4136b4a597ULL, 0x31680a88f8953031ULL},
+    {0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL},
+    {0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL},
+    {0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL},
+    {0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL},
+    {0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL},
+    {0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL},
+    {0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL},
+    {0xccccccccccccccccULL, 0xcccccccccccccccdULL},
+    {0x8000000000000000ULL, 0x0000000000000000ULL},
+    {0xa000000000000000ULL, 0x0000000000000000ULL},
+    {0xc800000000000000ULL, 0x0000000000000000ULL},
+    {0xfa00000000000000ULL, 0x0000000000000000ULL},
+    {0x9c40000000000000ULL, 0x0000000000000000ULL},
+    {0xc350000000000000ULL, 0x0000000000000000ULL},
+    {0xf424000000000000ULL, 0x0000000000000000ULL},
+    {0x9896800000000000ULL, 0x0000000000000000ULL},
+    {0xbebc200000000000ULL, 0x0000000000000000ULL},
+    {0xee6b280000000000ULL, 0x0000000000000000ULL},
+    {0x9502f90000000000ULL, 0x0000000000000000ULL},
+    {0xba43b74000000000ULL, 0x0000000000000000ULL},
+    {0xe8d4a51000000000ULL, 0x0000000000000000ULL},
+    {0x9184e72a00000000ULL, 0x0000000000000000ULL},
+    {0xb5e620f480000000ULL, 0x0000000000000000ULL},
+    {0xe35fa931a0000000ULL, 0x0000000000000000ULL},
+    {0x8e1bc9bf04000000ULL, 0x0000000000000000ULL},
+    {0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL},
+    {0xde0b6b3a76400000ULL, 0x0000000000000000ULL},
+    {0x8ac7230489e80000ULL, 0x0000000000000000ULL},
+    {0xad78ebc5ac620000ULL, 0x0000000000000000ULL},
+    {0xd8d726b7177a8000ULL, 0x0000000000000000ULL},
+    {0x878678326eac9000ULL, 0x0000000000000000ULL},
+    {0xa968163f0a57b400ULL, 0x0000000000000000ULL},
+    {0xd3c21bcecceda100ULL, 0x0000000000000000ULL},
+    {0x84595161401484a0ULL, 0x0000000000000000ULL},
+    {0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL},
+    {0xcecb8f27f4200f3aULL, 0x0000000000000000ULL},
+    {0x813f3978f8940984ULL, 0x4000000000000000ULL},
+    {0xa18f07d736b90be5ULL, 0x5000000000000000ULL},
+    {0xc9f2c9cd04674edeULL, 0xa400000000000000ULL},
+    {0xfc6f7c4045812296ULL, 0x4d00000000000000ULL},
+    {0x9dc5ada82b70b59dULL, 0xf020000000000000ULL},
+    {0xc5371912364ce305ULL, 0x6c28000000000000ULL},
+    {0xf684df56c3e01bc6ULL, 0xc732000000000000ULL},
+    {0x9a130b963a6c115cULL, 0x3c7f400000000000ULL},
+    {0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL},
+    {0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL},
+    {0x96769950b50d88f4ULL, 0x1314448000000000ULL},
+    {0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL},
+    {0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL},
+    {0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL},
+    {0xb7abc627050305adULL, 0xf14a3d9e40000000ULL},
+    {0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL},
+    {0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL},
+    {0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL},
+    {0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL},
+    {0x8c213d9da502de45ULL, 0x4526f422cc340000ULL},
+    {0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL},
+    {0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL},
+    {0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL},
+    {0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL},
+    {0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL},
+    {0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL},
+    {0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL},
+    {0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL},
+    {0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL},
+    {0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL},
+    {0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL},
+    {0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL},
+    {0x9f4f2726179a2245ULL, 0x01d762422c946590ULL},
+    {0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL},
+    {0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL},
+    {0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL},
+    {0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL},
+    {0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL},
+    {0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL},
+    {0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL},
+    {0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL},
+    {0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL},
+    {0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL},
+    {0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL},
+    {0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL},
+    {0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL},
+    {0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL},
+    {0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL},
+    {0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL},
+    {0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL},
+    {0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL},
+    {0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL},
+    {0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL},
+    {0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL},
+    {0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL},
+    {0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL},
+    {0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL},
+    {0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL},
+    {0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL},
+    {0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL},
+    {0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL},
+    {0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL},
+    {0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL},
+    {0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL},
+    {0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL},
+    {0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL},
+    {0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL},
+    {0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL},
+    {0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL},
+    {0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL},
+    {0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL},
+    {0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL},
+    {0x924d692ca61be758ULL, 0x593c2626705f9c56ULL},
+    {0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL},
+    {0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL},
+    {0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL},
+    {0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL},
+    {0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL},
+    {0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL},
+    {0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL},
+    {0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL},
+    {0x884134fe908658b2ULL, 0x3109058d147fdcddULL},
+    {0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL},
+    {0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL},
+    {0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL},
+    {0xa6539930bf6bff45ULL, 0x84db8346b786151cULL},
+    {0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL},
+    {0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL},
+    {0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL},
+    {0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL},
+    {0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL},
+    {0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL},
+    {0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL},
+    {0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL},
+    {0x9ae757596946075fULL, 0x3375788de9b06958ULL},
+    {0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL},
+    {0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL},
+    {0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL},
+    {0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL},
+    {0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL},
+    {0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL},
+    {0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL},
+    {0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL},
+    {0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL},
+    {0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL},
+    {0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL},
+    {0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL},
+    {0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL},
+    {0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL},
+    {0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL},
+    {0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL},
+    {0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL},
+    {0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL},
+    {0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL},
+    {0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL},
+    {0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL},
+    {0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL},
+    {0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL},
+    {0x802221226be55a64ULL, 0xc2494954da2c9789ULL},
+    {0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL},
+    {0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL},
+    {0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL},
+    {0x9c69a97284b578d7ULL, 0xff2a760414536efbULL},
+    {0xc38413cf25e2d70dULL, 0xfef5138519684abaULL},
+    {0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL},
+    {0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL},
+    {0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL},
+    {0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL},
+    {0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL},
+    {0xba756174393d88dfULL, 0x94f971119aeef9e4ULL},
+    {0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL},
+    {0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL},
+    {0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL},
+    {0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL},
+    {0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL},
+    {0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL},
+    {0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL},
+    {0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL},
+    {0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL},
+    {0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL},
+    {0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL},
+    {0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL},
+    {0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL},
+    {0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL},
+    {0xa59bc234db398c25ULL, 0x43fab9837e699095ULL},
+    {0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL},
+    {0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL},
+    {0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL},
+    {0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL},
+    {0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL},
+    {0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL},
+    {0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL},
+    {0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL},
+    {0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL},
+    {0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL},
+    {0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL},
+    {0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL},
+    {0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL},
+    {0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL},
+    {0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL},
+    {0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL},
+    {0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL},
+    {0x8fa475791a569d10ULL, 0xf96e017d694487bcULL},
+    {0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL},
+    {0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL},
+    {0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL},
+    {0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL},
+    {0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL},
+    {0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL},
+    {0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL},
+    {0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL},
+    {0x85c7056562757456ULL, 0xf6872d5667844e49ULL},
+    {0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL},
+    {0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL},
+    {0x82a45b450226b39cULL, 0xecc0024661173473ULL},
+    {0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL},
+    {0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL},
+    {0xff290242c83396ceULL, 0x7e67047175a15271ULL},
+    {0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL},
+    {0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL},
+    {0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL},
+    {0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL},
+    {0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL},
+    {0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL},
+    {0x98165af37b2153deULL, 0xc3727a337a8b704aULL},
+    {0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL},
+    {0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL},
+    {0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL},
+    {0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL},
+    {0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL},
+    {0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL},
+    {0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL},
+    {0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL},
+    {0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL},
+    {0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL},
+    {0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL},
+    {0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL},
+    {0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL},
+    {0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL},
+    {0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL},
+    {0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL},
+    {0xd31045a8341ca07cULL, 0x1ede48111209a050ULL},
+    {0x83ea2b892091e44dULL, 0x934aed0aab460432ULL},
+    {0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL},
+    {0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL},
+    {0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL},
+    {0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL},
+    {0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL},
+    {0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL},
+    {0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL},
+    {0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL},
+    {0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL},
+    {0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL},
+    {0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL},
+    {0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL},
+    {0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL},
+    {0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL},
+    {0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL},
+    {0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL},
+    {0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL},
+    {0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL},
+    {0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL},
+    {0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL},
+    {0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL},
+    {0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL},
+    {0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL},
+    {0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL},
+    {0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL},
+    {0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL},
+    {0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL},
+    {0x8533285c936b35deULL, 0xd53a88958f87275fULL},
+    {0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL},
+    {0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL},
+    {0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL},
+    {0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL},
+    {0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL},
+    {0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL},
+    {0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL},
+    {0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL},
+    {0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL},
+    {0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL},
+    {0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL},
+    {0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL},
+    {0x976e41088617ca01ULL, 0xd5be0503e085d813ULL},
+    {0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL},
+    {0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL},
+    {0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL},
+    {0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL},
+    {0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL},
+    {0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL},
+    {0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL},
+    {0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL},
+    {0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL},
+    {0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL},
+    {0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL},
+    {0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL},
+    {0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL},
+    {0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL},
+    {0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL},
+    {0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL},
+    {0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL},
+    {0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL},
+    {0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL},
+    {0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL},
+    {0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL},
+    {0xa0555e361951c366ULL, 0xd7e105bcc332621fULL},
+    {0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL},
+    {0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL},
+    {0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL},
+    {0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL},
+    {0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL},
+    {0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL},
+    {0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL},
+    {0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL},
+    {0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL},
+    {0xbaa718e68396cffdULL, 0xd30560258f54e6baULL},
+    {0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL},
+    {0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL},
+    {0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL},
+    {0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL},
+    {0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL},};
+
+static uint64_t mul_u64(uint64_t a, uint64_t b, uint64_t *hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    *hi = (uint64_t)(p >> 64);
+    return (uint64_t)p;
+#else
+    uint64_t al = a & 0xffffffffu, ah = a >> 32;
+    uint64_t bl = b & 0xffffffffu, bh = b >> 32;
+    uint64_t ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xffffffffu);
+#endif
+}
+
+static int clz_u64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & 0x8000000000000000ULL)) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+// w * 10^q for nonzero w; returns 0 when the result must come from strtod
+static int eisel_lemire(uint64_t w, int q, double *out) {
+    const uint64_t *t = pow5_128[q - POW5_MIN_EXP];
+    int lz = clz_u64(w);
+    int64_t exponent = (((152170 + 65536) * (int64_t)q) >> 16) + 1024 + 63;
+    uint64_t upper, lower, mantissa, bits, upperbit;
+    w <<= lz;
+    lower = mul_u64(w, t[0], &upper);
+    if ((upper & 0x1ff) == 0x1ff && lower + w < lower) {
+        // the truncated product is too close to a boundary: add the low word
+        uint64_t mid2, low = mul_u64(w, t[1], &mid2);
+        uint64_t mid = lower + mid2;
+        if (mid < lower) upper++;
+        if (mid + 1 == 0 && (upper & 0x1ff) == 0x1ff && low + w < low) return 0;
+        lower = mid;
+    }
+    upperbit = upper >> 63;
+    mantissa = upper >> (upperbit + 9);
+    lz += (int)(1 ^ upperbit);
+    if (lower == 0 && (upper & 0x1ff) == 0 && (mantissa & 3) == 1) return 0; // possible tie
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (1ULL << 53)) {
+        mantissa = 1ULL << 52;
+        lz--;
+    }
+    mantissa &= ~(1ULL << 52);
+    exponent -= lz;
+    if (exponent < 1 || exponent > 2046) return 0;               // subnormal or overflow
+    bits = mantissa | ((uint64_t)exponent << 52);
+    memcpy(out, &bits, sizeof bits);
+    return 1;
+}
+
+// correctly rounded slow path; only literals with separators or hex digits are copied
+static double number_fallback(const char *s, size_t n, int copy) {
+    char small[MAX_TOKEN_LEN];
+    char *buf;
+    size_t i, k = 0;
+    double v;
+    if (!copy) return strtod(s, NULL);
+    buf = n < sizeof small ? small : malloc(n + 1);
+    if (!buf) return strtod(s, NULL);
+    for (i = 0; i < n; i++) if (s[i] != '_') buf[k++] = s[i];
+    buf[k] = '\0';
+    v = strtod(buf, NULL);
+    if (buf != small) free(buf);
+    return v;
+}
+
+static int digit_separator(const char *s, size_t i, size_t n, int (*is_digit)(int)) {
+    return s[i] == '_' && i > 0 && is_digit((unsigned char)s[i-1]) && i+1 < n && is_digit((unsigned char)s[i+1]);
+}
+
+static size_t scan_hex(const char *s, size_t n, double *value) {
+    uint64_t w = 0;
+    int digits = 0;
+    size_t i = 2;
+    while (i < n) {
+        int c = (unsigned char)s[i];
+        if (isxdigit(c)) {
+            w = w * 16 + (uint64_t)(isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+            if (w) digits++;
+            i++;
+        } else if (digit_separator(s, i, n, isxdigit)) {
+            i++;
+        } else break;
+    }
+    // up to 16 digits fit in w, and the conversion to double rounds correctly
+    *value = digits <= 16 ? (double)w : number_fallback(s, i, 1);
+    return i;
+}
+
+static double decimal_to_double(uint64_t w, long exp10, int truncated) {
+    double v;
+    if (w == 0) return 0.0;
+    if (truncated) return -1.0;
+    if (w <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+        return exp10 < 0 ? (double)w / exact_pow10[-exp10] : (double)w * exact_pow10[exp10];
+    if (exp10 < POW5_MIN_EXP) return 0.0;   // below half the smallest subnormal
+    if (exp10 > POW5_MAX_EXP) return HUGE_VAL;
+    return eisel_lemire(w, (int)exp10, &v) ? v : -1.0;
+}
+
+/*
+  Scans the literal at s (at most n bytes): decimal digits with an optional
+  fraction and exponent, or 0x followed by hex digits. '_' may separate two
+  digits. An 'e' not followed by a digit ends the literal and is read as the
+  constant e. Returns the number of bytes consumed.
+*/
+size_t scan_number(const char *s, size_t n, double *value) {
+    uint64_t w = 0;
+    int digits = 0, truncated = 0, separators = 0, fraction = 0;
+    long exp10 = 0;
+    size_t i = 0;
+    if (n > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X') && isxdigit((unsigned char)s[2]))
+        return scan_hex(s, n, value);
+    while (i < n) {
+        char c = s[i];
+        if (isdigit((unsigned char)c)) {
+            int d = c - '0';
+            if (digits < 19) {
+                w = w * 10 + (uint64_t)d;
+                if (w) digits++;          // leading zeros are not significant
+                if (fraction) exp10--;
+            } else {
+                truncated |= d != 0;
+                if (!fraction) exp10++;
+            }
+            i++;
+        } else if (c == '.' && !fraction) {
+            fraction = 1;
+            i++;
+        } else if (digit_separator(s, i, n, isdigit)) {
+            separators = 1;
+            i++;
+        } else break;
+    }
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        size_t j = i + 1;
+        int neg = 0;
+        if (j < n && (s[j] == '+' || s[j] == '-')) neg = s[j++] == '-';
+        if (j < n && isdigit((unsigned char)s[j])) {
+            long e = 0;
+            while (j < n) {
+                if (isdigit((unsigned char)s[j])) {
+                    if (e < 100000) e = e * 10 + (s[j] - '0');
+                } else if (digit_separator(s, j, n, isdigit)) {
+                    separators = 1;
+                } else break;
+                j++;
+            }
+            exp10 += neg ? -e : e;
+            i = j;
+        }
+    }
+    *value = decimal_to_double(w, exp10, truncated);
+    if (*value < 0) *value = number_fallback(s, i, separators);
+    return i;
+}
+
+/* ---------- Number formatting ---------- */
+
+/*
+  Results are printed either as the shortest decimal that reads back as the
+  same double (Ryu, Ulf Adams 2018) or rounded to a fixed number of
+  significant digits. Both use the %g layout: plain notation unless the
+  decimal exponent is below -4 or reaches the precision (17 for shortest).
+*/
+
+typedef enum { FMT_SHORTEST, FMT_DIGITS } FormatMode;
+
+typedef struct {
+    FormatMode mode;
+    int digits;          // significant digits for FMT_DIGITS, 1..17
+} NumberFormat;
+
+#define FORMAT_BUF_LEN 32
+#define FORMAT_MAX_DIGITS 17
+
+#define RYU_POW5_INV_BITS 125
+#define RYU_POW5_BITS 125
+
+// floor(2^(bits(5^i) - 1 + 125) / 5^i) + 1, high word first
+static const uint64_t ryu_pow5_inv[342][2] = {
+    {0x2000000000000000ULL, 0x0000000000000001ULL},
+    {0x1999999999999999ULL, 0x999999999999999aULL},
+    {0x147ae147ae147ae1ULL, 0x47ae147ae147ae15ULL},
+    {0x10624dd2f1a9fbe7ULL, 0x6c8b4395810624deULL},
+    {0x1a36e2eb1c432ca5ULL, 0x7a786c226809d496ULL},
+    {0x14f8b588e368f084ULL, 0x61f9f01b866e43abULL},
+    {0x10c6f7a0b5ed8d36ULL, 0xb4c7f34938583622ULL},
+    {0x1ad7f29abcaf4857ULL, 0x87a6520ec08d236aULL},
+    {0x15798ee2308c39dfULL, 0x9fb841a566d74f88ULL},
+    {0x112e0be826d694b2ULL, 0xe62d01511f12a607ULL},
+    {0x1b7cdfd9d7bdbab7ULL, 0xd6ae6881cb5109a4ULL},
+    {0x15fd7fe17964955fULL, 0xdef1ed34a2a73aeaULL},
+    {0x119799812dea1119ULL, 0x7f27f0f6e885c8bbULL},
+    {0x1c25c268497681c2ULL, 0x650cb4be40d60df8ULL},
+    {0x16849b86a12b9b01ULL, 0xea70909833de7193ULL},
+    {0x1203af9ee756159bULL, 0x21f3a6e0297ec143ULL},
+    {0x1cd2b297d889bc2bULL, 0x6985d7cd0f313537ULL},
+    {0x170ef54646d49689ULL, 0x2137dfd73f5a90f9ULL},
+    {0x12725dd1d243aba0ULL, 0xe75fe645cc4873faULL},
+    {0x1d83c94fb6d2ac34ULL, 0xa5663d3c7a0d865dULL},
+    {0x179ca10c9242235dULL, 0x511e976394d79eb1ULL},
+    {0x12e3b40a0e9b4f7dULL, 0xda7edf82dd794bc1ULL},
+    {0x1e392010175ee596ULL, 0x2a6498d1625bac68ULL},
+    {0x182db34012b25144ULL, 0xeeb6e0a781e2f053ULL},
+    {0x1357c299a88ea76aULL, 0x58924d52ce4f26a9ULL},
+    {0x1ef2d0f5da7dd8aaULL, 0x27507bb7b07ea441ULL},
+    {0x18c240c4aecb13bbULL, 0x52a6c95fc0655034ULL},
+    {0x13ce9a36f23c0fc9ULL, 0x0eebd44c99eaa690ULL},
+    {0x1fb0f6be50601941ULL, 0xb17953adc3110a80ULL},
+    {0x195a5efea6b34767ULL, 0xc12ddc8b02740867ULL},
+    {0x14484bfeebc29f86ULL, 0x3424b06f3529a052ULL},
+    {0x1039d66589687f9eULL, 0x901d59f290ee19dbULL},
+    {0x19f623d5a8a73297ULL, 0x4cfbc31db4b0295fULL},
+    {0x14c4e977ba1f5bacULL, 0x3d9635b15d59bab2ULL},
+    {0x109d8792fb4c4956ULL, 0x97ab5e277de16228ULL},
+    {0x1a95a5b7f87a0ef0ULL, 0xf2abc9d8c9689d0dULL},
+    {0x154484932d2e725aULL, 0x5bbca17a3aba173eULL},
+    {0x11039d428a8b8eaeULL, 0xafca1ac82efb45cbULL},
+    {0x1b38fb9daa78e44aULL, 0xb2dcf7a6b1920945ULL},
+    {0x15c72fb1552d836eULL, 0xf57d92ebc141a104ULL},
+    {0x116c262777579c58ULL, 0xc46475896767b403ULL},
+    {0x1be03d0bf225c6f4ULL, 0x6d6d88dbd8a5ecd2ULL},
+    {0x164cfda3281e38c3ULL, 0x8abe071646eb23dbULL},
+    {0x11d7314f534b609cULL, 0x6efe6c11d255b649ULL},
+    {0x1c8b821885456760ULL, 0xb197134fb6ef8a0eULL},
+    {0x16d601ad376ab91aULL, 0x27ac0f72f8bfa1a5ULL},
+    {0x1244ce242c5560e1ULL, 0xb95672c260994e1eULL},
+    {0x1d3ae36d13bbce35ULL, 0xf5571e03cdc21695ULL},
+    {0x17624f8a762fd82bULL, 0x2aac18030b01ababULL},
+    {0x12b50c6ec4f31355ULL, 0xbbbce0026f348956ULL},
+    {0x1dee7a4ad4b81eefULL, 0x92c7ccd0b1eda889ULL},
+    {0x17f1fb6f10934bf2ULL, 0xdbd30a408e57ba07ULL},
+    {0x1327fc58da0f6ff5ULL, 0x7ca8d50071dfc806ULL},
+    {0x1ea6608e29b24cbbULL, 0xfaa7bb33e9660cd6ULL},
+    {0x18851a0b548ea3c9ULL, 0x9552fc298784d711ULL},
+    {0x139dae6f76d88307ULL, 0xaaa8c9bad2d0ac0eULL},
+    {0x1f62b0b257c0d1a5ULL, 0xdddadc5e1e1aace3ULL},
+    {0x191bc08eac9a4151ULL, 0x7e48b04b4b488a4fULL},
+    {0x141633a556e1cddaULL, 0xcb6d59d5d5d3a1d9ULL},
+    {0x1011c2eaabe7d7e2ULL, 0x3c577b1177dc817bULL},
+    {0x19b604aaaca62636ULL, 0xc6f25e825960cf2aULL},
+    {0x14919d5556eb51c5ULL, 0x6bf518684780a5bbULL},
+    {0x10747ddddf22a7d1ULL, 0x232a79ed06008496ULL},
+    {0x1a53fc9631d10c81ULL, 0xd1dd8fe1a3340756ULL},
+    {0x150ffd44f4a73d34ULL, 0xa7e4731ae8f66c45ULL},
+    {0x10d9976a5d52975dULL, 0x531d28e253f8569eULL},
+    {0x1af5bf109550f22eULL, 0xeb61db03b98d5762ULL},
+    {0x159165a6ddda5b58ULL, 0xbc4e48cfc7a445e8ULL},
+    {0x11411e1f17e1e2adULL, 0x6371d3d96c836b20ULL},
+    {0x1b9b6364f3030448ULL, 0x9f1c8628ad9f11cdULL},
+    {0x1615e91d8f359d06ULL, 0xe5b06b53be18db0bULL},
+    {0x11ab20e472914a6bULL, 0xeaf3890fcb4715a2ULL},
+    {0x1c45016d841baa46ULL, 0x44b8db4c7871bc37ULL},
+    {0x169d9abe03495505ULL, 0x03c715d6c6c1635fULL},
+    {0x1217aefe69077737ULL, 0x3638de456bcde919ULL},
+    {0x1cf2b1970e725858ULL, 0x56c163a2461641c1ULL},
+    {0x17288e1271f51379ULL, 0xdf011c81d1ab67ceULL},
+    {0x1286d80ec190dc61ULL, 0x7f3416ce4155eca5ULL},
+    {0x1da48ce468e7c702ULL, 0x6520247d3556476eULL},
+    {0x17b6d71d20b96c01ULL, 0xea801d30f7783925ULL},
+    {0x12f8ac174d612334ULL, 0xbb99b0f3f92cfa84ULL},
+    {0x1e5aacf215683854ULL, 0x5f5c4e532847f739ULL},
+    {0x18488a5b44536043ULL, 0x7f7d0b75b9d32c2eULL},
+    {0x136d3b7c36a919cfULL, 0x9930d5f7c7dc2358ULL},
+    {0x1f152bf9f10e8fb2ULL, 0x8eb4898c72f9d226ULL},
+    {0x18ddbcc7f40ba628ULL, 0x722a07a38f2e41b8ULL},
+    {0x13e497065cd61e86ULL, 0xc1bb394fa5be9afaULL},
+    {0x1fd424d6faf030d7ULL, 0x9c5ec2190930f7f6ULL},
+    {0x197683df2f268d79ULL, 0x49e56814075a5ff8ULL},
+    {0x145ecfe5bf520ac7ULL, 0x6e51201005e1e660ULL},
+    {0x104bd984990e6f05ULL, 0xf1da800cd181851aULL},
+    {0x1a12f5a0f4e3e4d6ULL, 0x4fc400148268d4f5ULL},
+    {0x14dbf7b3f71cb711ULL, 0xd96999aa01ed772bULL},
+    {0x10aff95cc5b09274ULL, 0xadee1488018ac5bcULL},
+    {0x1ab328946f80ea54ULL, 0x497ceda668de092cULL},
+    {0x155c2076bf9a5510ULL, 0x3aca57b853e4d424ULL},
+    {0x1116805effaeaa73ULL, 0x623b7960431d7683ULL},
+    {0x1b5733cb32b110b8ULL, 0x9d2bf566d1c8bd9eULL},
+    {0x15df5ca28ef40d60ULL, 0x7dbcc452416d647fULL},
+    {0x117f7d4ed8c33de6ULL, 0xcafd69db678ab6ccULL},
+    {0x1bff2ee48e052fd7ULL, 0xab2f0fc572778adfULL},
+    {0x1665bf1d3e6a8cacULL, 0x88f273045b92d580ULL},
+    {0x11eaff4a98553d56ULL, 0xd3f528d049424466ULL},
+    {0x1cab3210f3bb9557ULL, 0xb988414d4203a0a3ULL},
+    {0x16ef5b40c2fc7779ULL, 0x6139cdd76802e6e9ULL},
+    {0x125915cd68c9f92dULL, 0xe761717920025254ULL},
+    {0x1d5b561574765b7cULL, 0xa568b58e999d5086ULL},
+    {0x177c44ddf6c515fdULL, 0x5120913ee14aa6d2ULL},
+    {0x12c9d0b1923744caULL, 0xa74d40ff1aa21f0eULL},
+    {0x1e0fb44f50586e11ULL, 0x0baece64f769cb4aULL},
+    {0x180c903f7379f1a7ULL, 0x3c8bd850c5ee3c3bULL},
+    {0x133d4032c2c7f485ULL, 0xca0979da37f1c9c9ULL},
+    {0x1ec866b79e0cba6fULL, 0xa9a8c2f6bfe942dbULL},
+    {0x18a0522c7e709526ULL, 0x2153cf2bccba9be3ULL},
+    {0x13b374f06526ddb8ULL, 0x1aa9728970954982ULL},
+    {0x1f8587e7083e2f8cULL, 0xf775840f1a88759dULL},
+    {0x19379fec0698260aULL, 0x5f9136727ba05e17ULL},
+    {0x142c7ff0054684d5ULL, 0x1940f85b9619e4dfULL},
+    {0x1023998cd1053710ULL, 0xe100c6afab47ea4cULL},
+    {0x19d28f47b4d524e7ULL, 0xce67a44c453fdd47ULL},
+    {0x14a8729fc3ddb71fULL, 0xd852e9d69dccb106ULL},
+    {0x1086c219697e2c19ULL, 0x79dbee454b0a2738ULL},
+    {0x1a71368f0f30468fULL, 0x295fe3a211a9d859ULL},
+    {0x15275ed8d8f36ba5ULL, 0xbab31c81a7bb137aULL},
+    {0x10ec4be0ad8f8951ULL, 0x6228e39aec95a92fULL},
+    {0x1b13ac9aaf4c0ee8ULL, 0x9d0e38f7e0ef7517ULL},
+    {0x15a956e225d67253ULL, 0xb0d82d931a592a79ULL},
+    {0x11544581b7dec1dcULL, 0x8d79be0f4847552eULL},
+    {0x1bba08cf8c979c94ULL, 0x158f967eda0bbb7cULL},
+    {0x162e6d72d6dfb076ULL, 0x77a611ff14d62f97ULL},
+    {0x11bebdf578b2f391ULL, 0xf951a7ff43de8c79ULL},
+    {0x1c6463225ab7ec1cULL, 0xc21c3ffed2fdad8eULL},
+    {0x16b6b5b5155ff017ULL, 0x01b0333242648ad8ULL},
+    {0x122bc490dde659acULL, 0x0159c28e9b83a246ULL},
+    {0x1d12d41afca3c2acULL, 0xcef604175f3903a3ULL},
+    {0x17424348ca1c9bbdULL, 0x725e69ac4c2d9c83ULL},
+    {0x129b69070816e2fdULL, 0xf5185489d68ae39cULL},
+    {0x1dc574d80cf16b2fULL, 0xee8d540fbdab05c6ULL},
+    {0x17d12a4670c1228cULL, 0xbed77672fe226b05ULL},
+    {0x130dbb6b8d674ed6ULL, 0xff12c528cb4ebc04ULL},
+    {0x1e7c5f127bd87e24ULL, 0xcb513b74787df9a0ULL},
+    {0x18637f41fcad31b7ULL, 0x090dc929f9fe614dULL},
+    {0x1382cc34ca2427c5ULL, 0xa0d7d42194cb810aULL},
+    {0x1f37ad21436d0c6fULL, 0x67bfb9cf5478ce77ULL},
+    {0x18f9574dcf8a7059ULL, 0x1fcc94a5dd2d71f9ULL},
+    {0x13faac3e3fa1f37aULL, 0x7fd6dd517dbdf4c7ULL},
+    {0x1ff779fd329cb8c3ULL, 0xffbe2ee8c92fee0bULL},
+    {0x1992c7fdc216fa36ULL, 0x6631bf20a0f324d6ULL},
+    {0x14756ccb01abfb5eULL, 0xb827cc1a1a5c1d78ULL},
+    {0x105df0a267bcc918ULL, 0x935309ae7b7ce460ULL},
+    {0x1a2fe76a3f9474f4ULL, 0x1eeb42b0c594a099ULL},
+    {0x14f31f8832dd2a5cULL, 0xe58902270476e6e1ULL},
+    {0x10c27fa028b0eeb0ULL, 0xb7a0ce859d2bebe7ULL},
+    {0x1ad0cc33744e4ab4ULL, 0x59014a6f61dfdfd8ULL},
+    {0x1573d68f903ea229ULL, 0xe0cdd525e7e64cadULL},
+    {0x11297872d9cbb4eeULL, 0x4d7177518651d6f1ULL},
+    {0x1b758d848fac54b0ULL, 0x7be8bee8d6e957e8ULL},
+    {0x15f7a46a0c89dd59ULL, 0xfcba3253df211320ULL},
+    {0x1192e9ee706e4aaeULL, 0x63c8284318e74280ULL},
+    {0x1c1e43171a4a1117ULL, 0x060d0d3827d86a66ULL},
+    {0x167e9c127b6e7412ULL, 0x6b3da42cecad21ebULL},
+    {0x11fee341fc585cdbULL, 0x88fe1cf0bd574e56ULL},
+    {0x1ccb0536608d615fULL, 0x419694b462254a23ULL},
+    {0x1708d0f84d3de77fULL, 0x67abaa29e81dd4e9ULL},
+    {0x126d73f9d764b932ULL, 0xb95621bb2017dd87ULL},
+    {0x1d7becc2f23ac1eaULL, 0xc223692b668c95a5ULL},
+    {0x179657025b6234bbULL, 0xce82ba891ed6de1dULL},
+    {0x12deac01e2b4f6fcULL, 0xa53562074bdf1818ULL},
+    {0x1e3113363787f194ULL, 0x3b889cd87964f359ULL},
+    {0x18274291c6065adcULL, 0xfc6d4a46c783f5e1ULL},
+    {0x13529ba7d19eaf17ULL, 0x30576e9f06032b1aULL},
+    {0x1eea92a61c311825ULL, 0x1a257dcb3cd1de90ULL},
+    {0x18bba884e35a79b7ULL, 0x481dfe3c30a7e540ULL},
+    {0x13c9539d82aec7c5ULL, 0xd34b31c9c0865100ULL},
+    {0x1fa885c8d117a609ULL, 0x5211e942cda3b4cdULL},
+    {0x19539e3a40dfb807ULL, 0x74db21023e1c90a4ULL},
+    {0x1442e4fb67196005ULL, 0xf715b401cb4a0d50ULL},
+    {0x103583fc527ab337ULL, 0xf8de299b09080aa7ULL},
+    {0x19ef3993b72ab859ULL, 0x8e304291a80cddd7ULL},
+    {0x14bf6142f8eef9e1ULL, 0x3e8d020e200a4b13ULL},
+    {0x10991a9bfa58c7e7ULL, 0x653d9b3e80083c0fULL},
+    {0x1a8e90f9908e0ca5ULL, 0x6ec8f864000d2ce4ULL},
+    {0x153eda614071a3b7ULL, 0x8bd3f9e999a423eaULL},
+    {0x10ff151a99f482f9ULL, 0x3ca994bae1501cbbULL},
+    {0x1b31bb5dc320d18eULL, 0xc775bac49bb3612bULL},
+    {0x15c162b168e70e0bULL, 0xd2c4956a16291a89ULL},
+    {0x11678227871f3e6fULL, 0xdbd0778811ba7ba1ULL},
+    {0x1bd8d03f3e9863e6ULL, 0x2c80bf401c5d929bULL},
+    {0x16470cff6546b651ULL, 0xbd33cc3349e47549ULL},
+    {0x11d270cc51055ea7ULL, 0xca8fd68f6e505dd4ULL},
+    {0x1c83e7ad4e6efdd9ULL, 0x4419574be3b3c953ULL},
+    {0x16cfec8aa52597e1ULL, 0x0347790982f63aa9ULL},
+    {0x123ff06eea847980ULL, 0xcf6c60d468c4fbbaULL},
+    {0x1d331a4b10d3f59aULL, 0xe57a34870e07f92aULL},
+    {0x175c1508da432ae2ULL, 0x512e906c0b399422ULL},
+    {0x12b010d3e1cf5581ULL, 0xda8ba6bcd5c7a9b5ULL},
+    {0x1de6815302e5559cULL, 0x90df712e22d90f87ULL},
+    {0x17eb9aa8cf1dde16ULL, 0xda4c5a8b4f140c6cULL},
+    {0x1322e220a5b17e78ULL, 0xaea37ba2a5a9a38aULL},
+    {0x1e9e369aa2b59727ULL, 0x7dd25f6aa2a905a9ULL},
+    {0x187e92154ef7ac1fULL, 0x97db7f888220d154ULL},
+    {0x139874ddd8c6234cULL, 0x797c6606ce80a777ULL},
+    {0x1f5a549627a36badULL, 0x8f2d700ae4010bf1ULL},
+    {0x191510781fb5efbeULL, 0x0c2459a25000d65aULL},
+    {0x1410d9f9b2f7f2feULL, 0x701d1481d99a4515ULL},
+    {0x100d7b2e28c65bfeULL, 0xc017439b147b6a77ULL},
+    {0x19af2b7d0e0a2ccaULL, 0xccf205c4ed9243f2ULL},
+    {0x148c22ca71a1bd6fULL, 0x0a5b37d0be0e9cc2ULL},
+    {0x10701bd527b4978cULL, 0x0848f973cb3ee3ceULL},
+    {0x1a4cf9550c5425acULL, 0xda0e5bec78649fb0ULL},
+    {0x150a6110d6a9b7bdULL, 0x7b3eaff060507fc0ULL},
+    {0x10d51a73deee2c97ULL, 0x95cbbff380406633ULL},
+    {0x1aee90b964b04758ULL, 0xefac665266cd7052ULL},
+    {0x158ba6fab6f36c47ULL, 0x2623850eb8a459dbULL},
+    {0x113c85955f29236cULL, 0x1e82d0d893b6ae49ULL},
+    {0x1b9408eefea838acULL, 0xfd9e1af41f8ab075ULL},
+    {0x16100725988693bdULL, 0x97b1af29b2d559f7ULL},
+    {0x11a66c1e139edc97ULL, 0xac8e25baf5777b2cULL},
+    {0x1c3d79c9b8fe2dbfULL, 0x7a7d092b2258c513ULL},
+    {0x169794a160cb57ccULL, 0x61fda0ef4ead6a76ULL},
+    {0x1212dd4de7091309ULL, 0xe7fe1a590bbdeec5ULL},
+    {0x1ceafbafd80e84dcULL, 0xa6635d5b45fcb13aULL},
+    {0x172262f3133ed0b0ULL, 0x851c4aaf6b308dc8ULL},
+    {0x1281e8c275cbda26ULL, 0xd0e36ef2bc26d7d4ULL},
+    {0x1d9ca79d894629d7ULL, 0xb49f17eac6a48c86ULL},
+    {0x17b08617a104ee46ULL, 0x2a18dfef0550706bULL},
+    {0x12f39e794d9d8b6bULL, 0x54e0b3259dd9f389ULL},
+    {0x1e5297287c2f4578ULL, 0x87cdeb6f62f65274ULL},
+    {0x18421286c9bf6ac6ULL, 0xd30b22bf825ea85dULL},
+    {0x13680ed23aff889fULL, 0x0f3c1bcc684bb9e4ULL},
+    {0x1f0ce4839198da98ULL, 0x18602c7a4079296dULL},
+    {0x18d71d360e13e213ULL, 0x46b356c833942124ULL},
+    {0x13df4a91a4dcb4dcULL, 0x388f78a029434db6ULL},
+    {0x1fcbaa82a1612160ULL, 0x5a7f2766a86baf8aULL},
+    {0x196fbb9bb44db44dULL, 0x153285ebb9efbfa2ULL},
+    {0x145962e2f6a4903dULL, 0xaa8ed189618c994eULL},
+    {0x1047824f2bb6d9caULL, 0xeed8a7a11ad6e10cULL},
+    {0x1a0c03b1df8af611ULL, 0x7e27729b5e249b45ULL},
+    {0x14d6695b193bf80dULL, 0xfe85f549181d4904ULL},
+    {0x10ab877c142ff9a4ULL, 0xcb9e5dd4134aa0d0ULL},
+    {0x1aac0bf9b9e65c3aULL, 0xdf63c9535211014dULL},
+    {0x15566ffafb1eb02fULL, 0x191ca10f74da6771ULL},
+    {0x1111f32f2f4bc025ULL, 0xadb080d92a4852c1ULL},
+    {0x1b4feb7eb212cd09ULL, 0x15e7348eaa0d5134ULL},
+    {0x15d98932280f0a6dULL, 0xab1f5d3eee710dc4ULL},
+    {0x117ad428200c0857ULL, 0xbc1917658b8da49dULL},
+    {0x1bf7b9d9cce00d59ULL, 0x2cf4f23c127c3a94ULL},
+    {0x165fc7e170b33de0ULL, 0xf0c3f4fcdb969543ULL},
+    {0x11e6398126f5cb1aULL, 0x5a365d9716121103ULL},
+    {0x1ca38f350b22de90ULL, 0x9056fc24f01ce804ULL},
+    {0x16e93f5da2824ba6ULL, 0xd9df301d8ce3ecd0ULL},
+    {0x125432b14ecea2ebULL, 0xe17f59b13d8323daULL},
+    {0x1d53844ee47dd179ULL, 0x68cbc2b52f38395cULL},
+    {0x177603725064a794ULL, 0x53d6355dbf602de3ULL},
+    {0x12c4cf8ea6b6ec76ULL, 0xa9782ab165e68b1cULL},
+    {0x1e07b27dd78b13f1ULL, 0x0f26aab56fd744faULL},
+    {0x18062864ac6f4327ULL, 0x3f52222abfdf6a62ULL},
+    {0x1338205089f29c1fULL, 0x65db4e88997f884eULL},
+    {0x1ec033b40fea9365ULL, 0x6fc54a7428cc0d4aULL},
+    {0x1899c2f673220f84ULL, 0x596aa1f68709a43bULL},
+    {0x13ae3591f5b4d936ULL, 0xadeee7f86c07b696ULL},
+    {0x1f7d228322baf524ULL, 0x497e3ff3e00c5756ULL},
+    {0x1930e868e89590e9ULL, 0xd464fff64cd6ac45ULL},
+    {0x14272053ed4473eeULL, 0x4383fff83d7889d1ULL},
+    {0x101f4d0ff1038ff1ULL, 0xcf9cccc69793a174ULL},
+    {0x19cbae7fe805b31cULL, 0x7f6147a425b90252ULL},
+    {0x14a2f1ffecd15c16ULL, 0xcc4dd2e9b7c7350fULL},
+    {0x10825b3323dab012ULL, 0x3d0b0f215fd290d9ULL},
+    {0x1a6a2b85062ab350ULL, 0x61ab4b689950e7c1ULL},
+    {0x1521bc6a6b555c40ULL, 0x4e22a2ba1440b967ULL},
+    {0x10e7c9eebc4449cdULL, 0x0b4ee894dd009453ULL},
+    {0x1b0c764ac6d3a948ULL, 0x1217da87c800ed51ULL},
+    {0x15a391d56bdc876cULL, 0xdb46486ca000bddaULL},
+    {0x114fa7ddefe39f8aULL, 0x490506bd4ccd64afULL},
+    {0x1bb2a62fe638ff43ULL, 0xa8080ac87ae23ab1ULL},
+    {0x162884f31e93ff69ULL, 0x5339a239fbe82ef4ULL},
+    {0x11ba03f5b20fff87ULL, 0x75c7b4fb2fecf25dULL},
+    {0x1c5cd322b67fff3fULL, 0x22d92191e647ea2eULL},
+    {0x16b0a8e891ffff65ULL, 0xb57a8141850654f2ULL},
+    {0x1226ed86db3332b7ULL, 0xc4620101373843f5ULL},
+    {0x1d0b15a491eb8459ULL, 0x3a366801f1f39feeULL},
+    {0x173c115074bc69e0ULL, 0xfb5eb99b27f6198bULL},
+    {0x129674405d6387e7ULL, 0x2f7efae2865e7ad6ULL},
+    {0x1dbd86cd6238d971ULL, 0xe597f7d0d6fd9156ULL},
+    {0x17cad23de82d7ac1ULL, 0x8479930d78cadaabULL},
+    {0x1308a831868ac89aULL, 0xd06142712d6f1556ULL},
+    {0x1e74404f3daada91ULL, 0x4d686a4eaf182222ULL},
+    {0x185d003f6488aedaULL, 0xa453883ef279b4e8ULL},
+    {0x137d99cc506d58aeULL, 0xe9dc6cff28615d87ULL},
+    {0x1f2f5c7a1a488de4ULL, 0xa960ae650d6895a4ULL},
+    {0x18f2b061aea07183ULL, 0xbab3beb73ded4483ULL},
+    {0x13f559e7bee6c136ULL, 0x2ef6322c318a9d36ULL},
+    {0x1feef63f97d79b89ULL, 0xe4bd1d13827761f0ULL},
+    {0x198bf832dfdfafa1ULL, 0x83ca7da9352c4e5aULL},
+    {0x146ff9c24cb2f2e7ULL, 0x9ca1fe20f756a515ULL},
+    {0x1059949b708f28b9ULL, 0x4a1b31b3f9121daaULL},
+    {0x1a28edc580e50df5ULL, 0x435eb5ecc1b695ddULL},
+    {0x14ed8b04671da4c4ULL, 0x35e55e57015ede4aULL},
+    {0x10be08d0527e1d69ULL, 0xc4b77eac0118b1d5ULL},
+    {0x1ac9a7b3b7302f0fULL, 0xa12597799b5ab622ULL},
+    {0x156e1fc2f8f358d9ULL, 0x4db7ac6149155e81ULL},
+    {0x1124e63593f5e0adULL, 0xd7c6238107444b9bULL},
+    {0x1b6e3d2286563449ULL, 0x593d059b3ed3ac2bULL},
+    {0x15f1ca820511c36dULL, 0xe0fd9e15cbdc89bcULL},
+    {0x118e3b9b37416924ULL, 0xb3fe18116fe3a163ULL},
+    {0x1c16c5c525357507ULL, 0x866359b57fd29bd1ULL},
+    {0x16789e3750f790d2ULL, 0xd1e91491330ee30eULL},
+    {0x11fa182c40c60d75ULL, 0x74ba76da8f3f1c0bULL},
+    {0x1cc359e067a348bbULL, 0xedf72490e531c678ULL},
+    {0x1702ae4d1fb5d3c9ULL, 0x8b2c1d40b75b052dULL},
+    {0x12688b70e62b0fd4ULL, 0x6f567dcd5f7c0424ULL},
+    {0x1d74124e3d11b2edULL, 0x7ef0c94898c66d06ULL},
+    {0x17900ea4fda7c257ULL, 0x98c0a106e09ebd9fULL},
+    {0x12d9a550caec9b79ULL, 0x470080d24d4bcae6ULL},
+    {0x1e29088144adc58eULL, 0xd800ce1d487944a2ULL},
+    {0x1820d39a9d57d13fULL, 0x1333d8176d2dd082ULL},
+    {0x134d76154aaca765ULL, 0xa8f646792424a6ceULL},
+    {0x1ee25688777aa56fULL, 0x74bd3d8ea03aa47dULL},
+    {0x18b51206c5fbb78cULL, 0x5d64313ee6955064ULL},
+    {0x13c40e6bd1962c70ULL, 0x4ab68dcbebaaa6b7ULL},
+    {0x1fa01712e8f0471aULL, 0x1124161312aaa457ULL},
+    {0x194cdf4253f36c14ULL, 0xda8344dc0eeee9dfULL},
+    {0x143d7f6843292343ULL, 0xe2029d7cd8bf2180ULL},
+    {0x103132b9cf541c36ULL, 0x4e687dfd7a328133ULL},
+    {0x19e851294bb9c6bdULL, 0x4a40c9959050ceb8ULL},
+    {0x14b9da876fc7d231ULL, 0x0833d477a6a70bc6ULL},
+    {0x1094aed2bfd30e8dULL, 0xa02976c61eec096bULL},
+    {0x1a877e1dffb81749ULL, 0x004257a364acdbdfULL},
+    {0x153931b1996012a0ULL, 0xcd01dfb5ea23e319ULL},
+    {0x10fa8e27ade6754dULL, 0x70ce4c91881cb5aeULL},
+    {0x1b2a7d0c4970bbafULL, 0x1ae3adb5a69455e2ULL},
+    {0x15bb973d078d62f2ULL, 0x7be957c4854377e8ULL},
+    {0x1162df64060ab58eULL, 0xc987796a0435f987ULL},
+    {0x1bd1656cd67788e4ULL, 0x75a58f1006bcc271ULL},
+    {0x16411df0ab92d3e9ULL, 0xf7b7a5a66bca3527ULL},
+    {0x11cdb18d560f0feeULL, 0x5fc61e1ebca1c41fULL},
+    {0x1c7c4f4889b1b316ULL, 0xffa363646102d365ULL},
+    {0x16c9d906d48e28dfULL, 0x32e91c504d9bdc51ULL},
+    {0x123b140576d820b2ULL, 0x8f20e37371497d0eULL},
+    {0x1d2b533bf159cdeaULL, 0x7e9b0585820f2e7cULL},
+    {0x1755dc2ff447d7eeULL, 0xcbaf379e01a5becaULL},
+    {0x12ab168cc36cacbfULL, 0x0958f94b348498a1ULL},};
+
+// 5^i scaled to exactly 125 bits, high word first
+static const uint64_t ryu_pow5[326][2] = {
+    {0x1000000000000000ULL, 0x0000000000000000ULL},
+    {0x1400000000000000ULL, 0x0000000000000000ULL},
+    {0x1900000000000000ULL, 0x0000000000000000ULL},
+    {0x1f40000000000000ULL, 0x0000000000000000ULL},
+    {0x1388000000000000ULL, 0x0000000000000000ULL},
+    {0x186a000000000000ULL, 0x0000000000000000ULL},
+    {0x1e84800000000000ULL, 0x0000000000000000ULL},
+    {0x1312d00000000000ULL, 0x0000000000000000ULL},
+    {0x17d7840000000000ULL, 0x0000000000000000ULL},
+    {0x1dcd650000000000ULL, 0x0000000000000000ULL},
+    {0x12a05f2000000000ULL, 0x0000000000000000ULL},
+    {0x174876e800000000ULL, 0x0000000000000000ULL},
+    {0x1d1a94a200000000ULL, 0x0000000000000000ULL},
+    {0x12309ce540000000ULL, 0x0000000000000000ULL},
+    {0x16bcc41e90000000ULL, 0x0000000000000000ULL},
+    {0x1c6bf52634000000ULL, 0x0000000000000000ULL},
+    {0x11c37937e0800000ULL, 0x0000000000000000ULL},
+    {0x16345785d8a00000ULL, 0x0000000000000000ULL},
+    {0x1bc16d674ec80000ULL, 0x0000000000000000ULL},
+    {0x1158e460913d0000ULL, 0x0000000000000000ULL},
+    {0x15af1d78b58c4000ULL, 0x0000000000000000ULL},
+    {0x1b1ae4d6e2ef5000ULL, 0x0000000000000000ULL},
+    {0x10f0cf064dd59200ULL, 0x0000000000000000ULL},
+    {0x152d02c7e14af680ULL, 0x0000000000000000ULL},
+    {0x1a784379d99db420ULL, 0x0000000000000000ULL},
+    {0x108b2a2c28029094ULL, 0x0000000000000000ULL},
+    {0x14adf4b7320334b9ULL, 0x0000000000000000ULL},
+    {0x19d971e4fe8401e7ULL, 0x4000000000000000ULL},
+    {0x1027e72f1f128130ULL, 0x8800000000000000ULL},
+    {0x1431e0fae6d7217cULL, 0xaa00000000000000ULL},
+    {0x193e5939a08ce9dbULL, 0xd480000000000000ULL},
+    {0x1f8def8808b02452ULL, 0xc9a0000000000000ULL},
+    {0x13b8b5b5056e16b3ULL, 0xbe04000000000000ULL},
+    {0x18a6e32246c99c60ULL, 0xad85000000000000ULL},
+    {0x1ed09bead87c0378ULL, 0xd8e6400000000000ULL},
+    {0x13426172c74d822bULL, 0x878fe80000000000ULL},
+    {0x1812f9cf7920e2b6ULL, 0x6973e20000000000ULL},
+    {0x1e17b84357691b64ULL, 0x03d0da8000000000ULL},
+    {0x12ced32a16a1b11eULL, 0x8262889000000000ULL},
+    {0x178287f49c4a1d66ULL, 0x22fb2ab400000000ULL},
+    {0x1d6329f1c35ca4bfULL, 0xabb9f56100000000ULL},
+    {0x125dfa371a19e6f7ULL, 0xcb54395ca0000000ULL},
+    {0x16f578c4e0a060b5ULL, 0xbe2947b3c8000000ULL},
+    {0x1cb2d6f618c878e3ULL, 0x2db399a0ba000000ULL},
+    {0x11efc659cf7d4b8dULL, 0xfc90400474400000ULL},
+    {0x166bb7f0435c9e71ULL, 0x7bb4500591500000ULL},
+    {0x1c06a5ec5433c60dULL, 0xdaa16406f5a40000ULL},
+    {0x118427b3b4a05bc8ULL, 0xa8a4de8459868000ULL},
+    {0x15e531a0a1c872baULL, 0xd2ce16256fe82000ULL},
+    {0x1b5e7e08ca3a8f69ULL, 0x87819baecbe22800ULL},
+    {0x111b0ec57e6499a1ULL, 0xf4b1014d3f6d5900ULL},
+    {0x1561d276ddfdc00aULL, 0x71dd41a08f48af40ULL},
+    {0x1aba4714957d300dULL, 0x0e549208b31adb10ULL},
+    {0x10b46c6cdd6e3e08ULL, 0x28f4db456ff0c8eaULL},
+    {0x14e1878814c9cd8aULL, 0x33321216cbecfb24ULL},
+    {0x1a19e96a19fc40ecULL, 0xbffe969c7ee839edULL},
+    {0x105031e2503da893ULL, 0xf7ff1e21cf512434ULL},
+    {0x14643e5ae44d12b8ULL, 0xf5fee5aa43256d41ULL},
+    {0x197d4df19d605767ULL, 0x337e9f14d3eec892ULL},
+    {0x1fdca16e04b86d41ULL, 0x005e46da08ea7ab6ULL},
+    {0x13e9e4e4c2f34448ULL, 0xa03aec4845928cb2ULL},
+    {0x18e45e1df3b0155aULL, 0xc849a75a56f72fdeULL},
+    {0x1f1d75a5709c1ab1ULL, 0x7a5c1130ecb4fbd6ULL},
+    {0x13726987666190aeULL, 0xec798abe93f11d65ULL},
+    {0x184f03e93ff9f4daULL, 0xa797ed6e38ed64bfULL},
+    {0x1e62c4e38ff87211ULL, 0x517de8c9c728bdefULL},
+    {0x12fdbb0e39fb474aULL, 0xd2eeb17e1c7976b5ULL},
+    {0x17bd29d1c87a191dULL, 0x87aa5ddda397d462ULL},
+    {0x1dac74463a989f64ULL, 0xe994f5550c7dc97bULL},
+    {0x128bc8abe49f639fULL, 0x11fd195527ce9dedULL},
+    {0x172ebad6ddc73c86ULL, 0xd67c5faa71c24568ULL},
+    {0x1cfa698c95390ba8ULL, 0x8c1b77950e32d6c2ULL},
+    {0x121c81f7dd43a749ULL, 0x57912abd28dfc639ULL},
+    {0x16a3a275d494911bULL, 0xad75756c7317b7c8ULL},
+    {0x1c4c8b1349b9b562ULL, 0x98d2d2c78fdda5baULL},
+    {0x11afd6ec0e14115dULL, 0x9f83c3bcb9ea8794ULL},
+    {0x161bcca7119915b5ULL, 0x0764b4abe8652979ULL},
+    {0x1ba2bfd0d5ff5b22ULL, 0x493de1d6e27e73d7ULL},
+    {0x1145b7e285bf98f5ULL, 0x6dc6ad264d8f0866ULL},
+    {0x159725db272f7f32ULL, 0xc938586fe0f2ca80ULL},
+    {0x1afcef51f0fb5effULL, 0x7b866e8bd92f7d20ULL},
+    {0x10de1593369d1b5fULL, 0xad34051767bdae34ULL},
+    {0x15159af804446237ULL, 0x9881065d41ad19c1ULL},
+    {0x1a5b01b605557ac5ULL, 0x7ea147f492186032ULL},
+    {0x1078e111c3556cbbULL, 0x6f24ccf8db4f3c1fULL},
+    {0x14971956342ac7eaULL, 0x4aee003712230b27ULL},
+    {0x19bcdfabc13579e4ULL, 0xdda98044d6abcdf0ULL},
+    {0x10160bcb58c16c2fULL, 0x0a89f02b062b60b6ULL},
+    {0x141b8ebe2ef1c73aULL, 0xcd2c6c35c7b638e4ULL},
+    {0x1922726dbaae3909ULL, 0x8077874339a3c71dULL},
+    {0x1f6b0f092959c74bULL, 0xe0956914080cb8e4ULL},
+    {0x13a2e965b9d81c8fULL, 0x6c5d61ac8507f38eULL},
+    {0x188ba3bf284e23b3ULL, 0x4774ba17a649f072ULL},
+    {0x1eae8caef261aca0ULL, 0x1951e89d8fdc6c8fULL},
+    {0x132d17ed577d0be4ULL, 0x0fd3316279e9c3d9ULL},
+    {0x17f85de8ad5c4eddULL, 0x13c7fdbb186434cfULL},
+    {0x1df67562d8b36294ULL, 0x58b9fd29de7d4203ULL},
+    {0x12ba095dc7701d9cULL, 0xb7743e3a2b0e4942ULL},
+    {0x17688bb5394c2503ULL, 0xe5514dc8b5d1db92ULL},
+    {0x1d42aea2879f2e44ULL, 0xdea5a13ae3465277ULL},
+    {0x1249ad2594c37cebULL, 0x0b2784c4ce0bf38aULL},
+    {0x16dc186ef9f45c25ULL, 0xcdf165f6018ef06dULL},
+    {0x1c931e8ab871732fULL, 0x416dbf7381f2ac88ULL},
+    {0x11dbf316b346e7fdULL, 0x88e497a83137abd5ULL},
+    {0x1652efdc6018a1fcULL, 0xeb1dbd923d8596caULL},
+    {0x1be7abd3781eca7cULL, 0x25e52cf6cce6fc7dULL},
+    {0x1170cb642b133e8dULL, 0x97af3c1a40105dceULL},
+    {0x15ccfe3d35d80e30ULL, 0xfd9b0b20d0147542ULL},
+    {0x1b403dcc834e11bdULL, 0x3d01cde904199292ULL},
+    {0x1108269fd210cb16ULL, 0x462120b1a28ffb9bULL},
+    {0x154a3047c694fddbULL, 0xd7a968de0b33fa82ULL},
+    {0x1a9cbc59b83a3d52ULL, 0xcd93c3158e00f923ULL},
+    {0x10a1f5b813246653ULL, 0xc07c59ed78c09bb6ULL},
+    {0x14ca732617ed7fe8ULL, 0xb09b7068d6f0c2a3ULL},
+    {0x19fd0fef9de8dfe2ULL, 0xdcc24c830cacf34cULL},
+    {0x103e29f5c2b18bedULL, 0xc9f96fd1e7ec180fULL},
+    {0x144db473335deee9ULL, 0x3c77cbc661e71e13ULL},
+    {0x1961219000356aa3ULL, 0x8b95beb7fa60e598ULL},
+    {0x1fb969f40042c54cULL, 0x6e7b2e65f8f91efeULL},
+    {0x13d3e2388029bb4fULL, 0xc50cfcffbb9bb35fULL},
+    {0x18c8dac6a0342a23ULL, 0xb6503c3faa82a037ULL},
+    {0x1efb1178484134acULL, 0xa3e44b4f95234844ULL},
+    {0x135ceaeb2d28c0ebULL, 0xe66eaf11bd360d2bULL},
+    {0x183425a5f872f126ULL, 0xe00a5ad62c839075ULL},
+    {0x1e412f0f768fad70ULL, 0x980cf18bb7a47493ULL},
+    {0x12e8bd69aa19cc66ULL, 0x5f0816f752c6c8dcULL},
+    {0x17a2ecc414a03f7fULL, 0xf6ca1cb527787b13ULL},
+    {0x1d8ba7f519c84f5fULL, 0xf47ca3e2715699d7ULL},
+    {0x127748f9301d319bULL, 0xf8cde66d86d62026ULL},
+    {0x17151b377c247e02ULL, 0xf7016008e88ba830ULL},
+    {0x1cda62055b2d9d83ULL, 0xb4c1b80b22ae923cULL},
+    {0x12087d4358fc8272ULL, 0x50f91306f5ad1b65ULL},
+    {0x168a9c942f3ba30eULL, 0xe53757c8b318623fULL},
+    {0x1c2d43b93b0a8bd2ULL, 0x9e852dbadfde7acfULL},
+    {0x119c4a53c4e69763ULL, 0xa3133c94cbeb0cc1ULL},
+    {0x16035ce8b6203d3cULL, 0x8bd80bb9fee5cff1ULL},
+    {0x1b843422e3a84c8bULL, 0xaece0ea87e9f43eeULL},
+    {0x1132a095ce492fd7ULL, 0x4d40c9294f238a75ULL},
+    {0x157f48bb41db7bcdULL, 0x2090fb73a2ec6d12ULL},
+    {0x1adf1aea12525ac0ULL, 0x68b53a508ba78856ULL},
+    {0x10cb70d24b7378b8ULL, 0x417144725748b536ULL},
+    {0x14fe4d06de5056e6ULL, 0x51cd958eed1ae283ULL},
+    {0x1a3de04895e46c9fULL, 0xe640faf2a8619b24ULL},
+    {0x1066ac2d5daec3e3ULL, 0xefe89cd7a93d00f7ULL},
+    {0x14805738b51a74dcULL, 0xebe2c40d938c4134ULL},
+    {0x19a06d06e2611214ULL, 0x26db7510f86f5181ULL},
+    {0x100444244d7cab4cULL, 0x9849292a9b4592f1ULL},
+    {0x1405552d60dbd61fULL, 0xbe5b73754216f7adULL},
+    {0x1906aa78b912cba7ULL, 0xadf25052929cb598ULL},
+    {0x1f485516e7577e91ULL, 0x996ee4673743e2ffULL},
+    {0x138d352e5096af1aULL, 0xffe54ec0828a6ddfULL},
+    {0x18708279e4bc5ae1ULL, 0xbfdea270a32d0957ULL},
+    {0x1e8ca3185deb719aULL, 0x2fd64b0ccbf84badULL},
+    {0x1317e5ef3ab32700ULL, 0x5de5eee7ff7b2f4cULL},
+    {0x17dddf6b095ff0c0ULL, 0x755f6aa1ff59fb1fULL},
+    {0x1dd55745cbb7ecf0ULL, 0x92b7454a7f3079e7ULL},
+    {0x12a5568b9f52f416ULL, 0x5bb28b4e8f7e4c30ULL},
+    {0x174eac2e8727b11bULL, 0xf29f2e22335ddf3cULL},
+    {0x1d22573a28f19d62ULL, 0xef46f9aac035570bULL},
+    {0x123576845997025dULL, 0xd58c5c0ab8215667ULL},
+    {0x16c2d4256ffcc2f5ULL, 0x4aef730d6629ac01ULL},
+    {0x1c73892ecbfbf3b2ULL, 0x9dab4fd0bfb41701ULL},
+    {0x11c835bd3f7d784fULL, 0xa28b11e277d08e60ULL},
+    {0x163a432c8f5cd663ULL, 0x8b2dd65b15c4b1f9ULL},
+    {0x1bc8d3f7b3340bfcULL, 0x6df94bf1db35de77ULL},
+    {0x115d847ad000877dULL, 0xc4bbcf772901ab0aULL},
+    {0x15b4e5998400a95dULL, 0x35eac354f34215cdULL},
+    {0x1b221effe500d3b4ULL, 0x8365742a30129b40ULL},
+    {0x10f5535fef208450ULL, 0xd21f689a5e0ba108ULL},
+    {0x1532a837eae8a565ULL, 0x06a742c0f58e894aULL},
+    {0x1a7f5245e5a2cebeULL, 0x4851137132f22b9dULL},
+    {0x108f936baf85c136ULL, 0xed32ac26bfd75b42ULL},
+    {0x14b378469b673184ULL, 0xa87f57306fcd3212ULL},
+    {0x19e056584240fde5ULL, 0xd29f2cfc8bc07e97ULL},
+    {0x102c35f729689eafULL, 0xa3a37c1dd7584f1eULL},
+    {0x14374374f3c2c65bULL, 0x8c8c5b254d2e62e6ULL},
+    {0x1945145230b377f2ULL, 0x6faf71eea079fb9fULL},
+    {0x1f965966bce055efULL, 0x0b9b4e6a48987a87ULL},
+    {0x13bdf7e0360c35b5ULL, 0x674111026d5f4c94ULL},
+    {0x18ad75d8438f4322ULL, 0xc111554308b71fbaULL},
+    {0x1ed8d34e547313ebULL, 0x7155aa93cae4e7a8ULL},
+    {0x13478410f4c7ec73ULL, 0x26d58a9c5ecf10c9ULL},
+    {0x1819651531f9e78fULL, 0xf08aed437682d4fbULL},
+    {0x1e1fbe5a7e786173ULL, 0xecada89454238a3aULL},
+    {0x12d3d6f88f0b3ce8ULL, 0x73ec895cb4963664ULL},
+    {0x1788ccb6b2ce0c22ULL, 0x90e7abb3e1bbc3fdULL},
+    {0x1d6affe45f818f2bULL, 0x352196a0da2ab4fdULL},
+    {0x1262dfeebbb0f97bULL, 0x0134fe24885ab11eULL},
+    {0x16fb97ea6a9d37d9ULL, 0xc1823dadaa715d65ULL},
+    {0x1cba7de5054485d0ULL, 0x31e2cd19150db4bfULL},
+    {0x11f48eaf234ad3a2ULL, 0x1f2dc02fad2890f7ULL},
+    {0x1671b25aec1d888aULL, 0xa6f9303b9872b535ULL},
+    {0x1c0e1ef1a724eaadULL, 0x50b77c4a7e8f6282ULL},
+    {0x1188d357087712acULL, 0x5272adae8f199d91ULL},
+    {0x15eb082cca94d757ULL, 0x670f591a32e004f6ULL},
+    {0x1b65ca37fd3a0d2dULL, 0x40d32f60bf980633ULL},
+    {0x111f9e62fe44483cULL, 0x4883fd9c77bf03e0ULL},
+    {0x156785fbbdd55a4bULL, 0x5aa4fd0395aec4d8ULL},
+    {0x1ac1677aad4ab0deULL, 0x314e3c447b1a760eULL},
+    {0x10b8e0acac4eae8aULL, 0xded0e5aaccf089c9ULL},
+    {0x14e718d7d7625a2dULL, 0x96851f15802cac3bULL},
+    {0x1a20df0dcd3af0b8ULL, 0xfc2666dae037d74aULL},
+    {0x10548b68a044d673ULL, 0x9d980048cc22e68eULL},
+    {0x1469ae42c8560c10ULL, 0x84fe005aff2ba032ULL},
+    {0x198419d37a6b8f14ULL, 0xa63d8071bef6883eULL},
+    {0x1fe52048590672d9ULL, 0xcfcce08e2eb42a4eULL},
+    {0x13ef342d37a407c8ULL, 0x21e00c58dd309a70ULL},
+    {0x18eb0138858d09baULL, 0x2a580f6f147cc10dULL},
+    {0x1f25c186a6f04c28ULL, 0xb4ee134ad99bf150ULL},
+    {0x137798f428562f99ULL, 0x7114cc0ec80176d2ULL},
+    {0x18557f31326bbb7fULL, 0xcd59ff127a01d486ULL},
+    {0x1e6adefd7f06aa5fULL, 0xc0b07ed7188249a8ULL},
+    {0x1302cb5e6f642a7bULL, 0xd86e4f466f516e09ULL},
+    {0x17c37e360b3d351aULL, 0xce89e3180b25c98bULL},
+    {0x1db45dc38e0c8261ULL, 0x822c5bde0def3beeULL},
+    {0x1290ba9a38c7d17cULL, 0xf15bb96ac8b58575ULL},
+    {0x1734e940c6f9c5dcULL, 0x2db2a7c57ae2e6d2ULL},
+    {0x1d022390f8b83753ULL, 0x391f51b6d99ba086ULL},
+    {0x1221563a9b732294ULL, 0x03b3931248014454ULL},
+    {0x16a9abc9424feb39ULL, 0x04a077d6da019569ULL},
+    {0x1c5416bb92e3e607ULL, 0x45c895cc9081fac3ULL},
+    {0x11b48e353bce6fc4ULL, 0x8b9d5d9fda513cbaULL},
+    {0x1621b1c28ac20bb5ULL, 0xae84b507d0e58be8ULL},
+    {0x1baa1e332d728ea3ULL, 0x1a25e249c51eeee3ULL},
+    {0x114a52dffc679925ULL, 0xf057ad6e1b33554dULL},
+    {0x159ce797fb817f6fULL, 0x6c6d98c9a2002aa1ULL},
+    {0x1b04217dfa61df4bULL, 0x4788fefc0a803549ULL},
+    {0x10e294eebc7d2b8fULL, 0x0cb59f5d8690214eULL},
+    {0x151b3a2a6b9c7672ULL, 0xcfe30734e83429a1ULL},
+    {0x1a6208b50683940fULL, 0x83dbc9022241340aULL},
+    {0x107d457124123c89ULL, 0xb2695da15568c086ULL},
+    {0x149c96cd6d16cbacULL, 0x1f03b509aac2f0a7ULL},
+    {0x19c3bc80c85c7e97ULL, 0x26c4a24c1573acd1ULL},
+    {0x101a55d07d39cf1eULL, 0x783ae56f8d684c03ULL},
+    {0x1420eb449c8842e6ULL, 0x16499ecb70c25f03ULL},
+    {0x19292615c3aa539fULL, 0x9bdc067e4cf2f6c4ULL},
+    {0x1f736f9b3494e887ULL, 0x82d3081de02fb476ULL},
+    {0x13a825c100dd1154ULL, 0xb1c3e512ac1dd0c9ULL},
+    {0x18922f31411455a9ULL, 0xde34de57572544fcULL},
+    {0x1eb6bafd91596b14ULL, 0x55c215ed2cee963bULL},
+    {0x133234de7ad7e2ecULL, 0xb5994db43c151de5ULL},
+    {0x17fec216198ddba7ULL, 0xe2ffa1214b1a655eULL},
+    {0x1dfe729b9ff15291ULL, 0xdbbf89699de0feb6ULL},
+    {0x12bf07a143f6d39bULL, 0x2957b5e202ac9f31ULL},
+    {0x176ec98994f48881ULL, 0xf3ada35a8357c6feULL},
+    {0x1d4a7bebfa31aaa2ULL, 0x70990c31242db8bdULL},
+    {0x124e8d737c5f0aa5ULL, 0x865fa79eb69c9376ULL},
+    {0x16e230d05b76cd4eULL, 0xe7f791866443b854ULL},
+    {0x1c9abd04725480a2ULL, 0xa1f575e7fd54a669ULL},
+    {0x11e0b622c774d065ULL, 0xa53969b0fe54e801ULL},
+    {0x1658e3ab7952047fULL, 0x0e87c41d3dea2202ULL},
+    {0x1bef1c9657a6859eULL, 0xd229b5248d64aa82ULL},
+    {0x117571ddf6c81383ULL, 0x435a1136d85eea91ULL},
+    {0x15d2ce55747a1864ULL, 0x143095848e76a536ULL},
+    {0x1b4781ead1989e7dULL, 0x193cbae5b2144e83ULL},
+    {0x110cb132c2ff630eULL, 0x2fc5f4cf8f4cb112ULL},
+    {0x154fdd7f73bf3bd1ULL, 0xbbb77203731fdd56ULL},
+    {0x1aa3d4df50af0ac6ULL, 0x2aa54e844fe7d4acULL},
+    {0x10a6650b926d66bbULL, 0xdaa75112b1f0e4ebULL},
+    {0x14cffe4e7708c06aULL, 0xd15125575e6d1e26ULL},
+    {0x1a03fde214caf085ULL, 0x85a56ead360865b0ULL},
+    {0x10427ead4cfed653ULL, 0x7387652c41c53f8eULL},
+    {0x14531e58a03e8be8ULL, 0x50693e7752368f71ULL},
+    {0x1967e5eec84e2ee2ULL, 0x64838e1526c4334eULL},
+    {0x1fc1df6a7a61ba9aULL, 0xfda4719a70754022ULL},
+    {0x13d92ba28c7d14a0ULL, 0xde86c70086494815ULL},
+    {0x18cf768b2f9c59c9ULL, 0x162878c0a7db9a1aULL},
+    {0x1f03542dfb83703bULL, 0x5bb296f0d1d280a1ULL},
+    {0x1362149cbd322625ULL, 0x194f9e5683239064ULL},
+    {0x183a99c3ec7eafaeULL, 0x5fa385ec23ec747eULL},
+    {0x1e494034e79e5b99ULL, 0xf78c67672ce7919dULL},
+    {0x12edc82110c2f940ULL, 0x3ab7c0a07c10bb02ULL},
+    {0x17a93a2954f3b790ULL, 0x4965b0c89b14e9c3ULL},
+    {0x1d9388b3aa30a574ULL, 0x5bbf1cfac1da2433ULL},
+    {0x127c35704a5e6768ULL, 0xb957721cb92856a0ULL},
+    {0x171b42cc5cf60142ULL, 0xe7ad4ea3e7726c48ULL},
+    {0x1ce2137f74338193ULL, 0xa198a24ce14f075aULL},
+    {0x120d4c2fa8a030fcULL, 0x44ff65700cd16498ULL},
+    {0x16909f3b92c83d3bULL, 0x563f3ecc1005bdbeULL},
+    {0x1c34c70a777a4c8aULL, 0x2bcf0e7f14072d2eULL},
+    {0x11a0fc668aac6fd6ULL, 0x5b61690f6c847c3dULL},
+    {0x16093b802d578bcbULL, 0xf239c35347a59b4cULL},
+    {0x1b8b8a6038ad6ebeULL, 0xeec83428198f021fULL},
+    {0x1137367c236c6537ULL, 0x553d20990ff96153ULL},
+    {0x1585041b2c477e85ULL, 0x2a8c68bf53f7b9a8ULL},
+    {0x1ae64521f7595e26ULL, 0x752f82ef28f5a812ULL},
+    {0x10cfeb353a97dad8ULL, 0x093db1d57999890bULL},
+    {0x1503e602893dd18eULL, 0x0b8d1e4ad7ffeb4eULL},
+    {0x1a44df832b8d45f1ULL, 0x8e7065dd8dffe622ULL},
+    {0x106b0bb1fb384bb6ULL, 0xf9063faa78bfefd5ULL},
+    {0x1485ce9e7a065ea4ULL, 0xb747cf9516efebcaULL},
+    {0x19a742461887f64dULL, 0xe519c37a5cabe6bdULL},
+    {0x1008896bcf54f9f0ULL, 0xaf301a2c79eb7036ULL},
+    {0x140aabc6c32a386cULL, 0xdafc20b798664c43ULL},
+    {0x190d56b873f4c688ULL, 0x11bb28e57e7fdf54ULL},
+    {0x1f50ac6690f1f82aULL, 0x1629f31ede1fd72aULL},
+    {0x13926bc01a973b1aULL, 0x4dda37f34ad3e67aULL},
+    {0x187706b0213d09e0ULL, 0xe150c5f01d88e019ULL},
+    {0x1e94c85c298c4c59ULL, 0x19a4f76c24eb181fULL},
+    {0x131cfd3999f7afb7ULL, 0xb0071aa39712ef13ULL},
+    {0x17e43c8800759ba5ULL, 0x9c08e14c7cd7aad8ULL},
+    {0x1ddd4baa0093028fULL, 0x030b199f9c0d958eULL},
+    {0x12aa4f4a405be199ULL, 0x61e6f003c1887d79ULL},
+    {0x1754e31cd072d9ffULL, 0xba60ac04b1ea9cd7ULL},
+    {0x1d2a1be4048f907fULL, 0xa8f8d705de65440dULL},
+    {0x123a516e82d9ba4fULL, 0xc99b8663aaff4a88ULL},
+    {0x16c8e5ca239028e3ULL, 0xbc0267fc95bf1d2aULL},
+    {0x1c7b1f3cac74331cULL, 0xab0301fbbb2ee474ULL},
+    {0x11ccf385ebc89ff1ULL, 0xeae1e13d54fd4ec9ULL},
+    {0x1640306766bac7eeULL, 0x659a598caa3ca27bULL},
+    {0x1bd03c81406979e9ULL, 0xff00efefd4cbcb1aULL},
+    {0x116225d0c841ec32ULL, 0x3f6095f5e4ff5ef0ULL},
+    {0x15baaf44fa52673eULL, 0xcf38bb735e3f36acULL},
+    {0x1b295b1638e7010eULL, 0x8306ea5035cf0457ULL},
+    {0x10f9d8ede39060a9ULL, 0x11e4527221a162b6ULL},
+    {0x15384f295c7478d3ULL, 0x565d670eaa09bb64ULL},
+    {0x1a8662f3b3919708ULL, 0x2bf4c0d2548c2a3dULL},
+    {0x1093fdd8503afe65ULL, 0x1b78f88374d79a66ULL},
+    {0x14b8fd4e6449bdfeULL, 0x625736a4520d8100ULL},
+    {0x19e73ca1fd5c2d7dULL, 0xfaed044d6690e140ULL},
+    {0x103085e53e599c6eULL, 0xbcd422b0601a8cc8ULL},
+    {0x143ca75e8df0038aULL, 0x6c092b5c78212ffaULL},
+    {0x194bd136316c046dULL, 0x070b763396297bf8ULL},
+    {0x1f9ec583bdc70588ULL, 0x48ce53c07bb3daf6ULL},
+    {0x13c33b72569c6375ULL, 0x2d80f4584d5068daULL},
+    {0x18b40a4eec437c52ULL, 0x78e1316e60a48310ULL},};
+
+static int pow5_bits(int e) { return (int)(((uint32_t)e * 1217359) >> 19) + 1; }
+static int log10_pow2(int e) { return (int)(((uint32_t)e * 78913) >> 18); }
+static int log10_pow5(int e) { return (int)(((uint32_t)e * 732923) >> 20); }
+
+static int multiple_of_pow5(uint64_t v, int p) {
+    int count = 0;
+    while (v % 5 == 0) { v /= 5; count++; }
+    return count >= p;
+}
+
+// (m * mul) >> j for a 125-bit table entry, 64 <= j < 128
+static uint64_t mul_shift(uint64_t m, const uint64_t *mul, int j) {
+    uint64_t hi0, hi1, lo1;
+    mul_u64(m, mul[1], &hi0);
+    lo1 = mul_u64(m, mul[0], &hi1);
+    lo1 += hi0;
+    hi1 += lo1 < hi0;
+    j -= 64;
+    return j ? (lo1 >> j) | (hi1 << (64 - j)) : lo1;
+}
+
+/*
+  Shortest decimal digits of the finite, nonzero |v|: returns the digits as
+  an integer and stores the power of ten of its last digit in *e10. Among
+  the shortest candidates the one closest to v wins, ties to even.
+*/
+static uint64_t shortest_decimal(double v, int *e10) {
+    uint64_t bits, ieee_mantissa, m2, mv, vr, vp, vm, output;
+    int ieee_exponent, e2, q, removed = 0, accept_bounds;
+    int vm_trailing_zeros = 0, vr_trailing_zeros = 0;
+    unsigned mm_shift, last_removed = 0;
+    memcpy(&bits, &v, sizeof bits);
+    ieee_mantissa = bits & ((1ULL << 52) - 1);
+    ieee_exponent = (int)((bits >> 52) & 0x7ff);
+    if (ieee_exponent == 0) {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    } else {
+        e2 = ieee_exponent - 1023 - 52 - 2;
+        m2 = (1ULL << 52) | ieee_mantissa;
+    }
+    accept_bounds = (m2 & 1) == 0;
+
+    // the interval of decimals that read back as v is (4*m2 - 1 - mm_shift, 4*m2 + 2) * 2^e2
+    mv = 4 * m2;
+    mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+    if (e2 >= 0) {
+        q = log10_pow2(e2) - (e2 > 3);
+        *e10 = q;
+        int j = -e2 + q + RYU_POW5_INV_BITS + pow5_bits(q) - 1;
+        vr = mul_shift(4 * m2, ryu_pow5_inv[q], j);
+        vp = mul_shift(4 * m2 + 2, ryu_pow5_inv[q], j);
+        vm = mul_shift(4 * m2 - 1 - mm_shift, ryu_pow5_inv[q], j);
+        if (q <= 21) {
+            // at most one of the three bounds can be a multiple of 5
+            if (mv % 5 == 0) vr_trailing_zeros = multiple_of_pow5(mv, q);
+            else if (accept_bounds) vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+            else vp -= multiple_of_pow5(mv + 2, q);
+        }
+    } else {
+        q = log10_pow5(-e2) - (-e2 > 1);
+        *e10 = q + e2;
+        int i = -e2 - q;
+        int j = q - (pow5_bits(i) - RYU_POW5_BITS);
+        vr = mul_shift(4 * m2, ryu_pow5[i], j);
+        vp = mul_shift(4 * m2 + 2, ryu_pow5[i], j);
+        vm = mul_shift(4 * m2 - 1 - mm_shift, ryu_pow5[i], j);
+        if (q <= 1) {
+            vr_trailing_zeros = 1;
+            if (accept_bounds) vm_trailing_zeros = mm_shift == 1;
+            else vp--;
+        } else if (q < 63) {
+            vr_trailing_zeros = (mv & ((1ULL << q) - 1)) == 0;
+        }
+    }
+
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        // rare: the exact bounds matter, so track every removed digit
+        while (vp / 10 > vm / 10) {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (unsigned)(vr % 10);
+            vr /= 10; vp /= 10; vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (unsigned)(vr % 10);
+                vr /= 10; vp /= 10; vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) last_removed = 4;
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    } else {
+        int round_up = 0;
+        if (vp / 100 > vm / 100) {
+            round_up = vr % 100 >= 50;
+            vr /= 100; vp /= 100; vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            round_up = vr % 10 >= 5;
+            vr /= 10; vp /= 10; vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+    *e10 += removed;
+    return output;
+}
+
+// Decimal digits of n > 0 into d; returns how many.
+static int decimal_digits(uint64_t n, char *d) {
+    char tmp[20];
+    int k = 0, i;
+    while (n) { tmp[k++] = (char)('0' + n % 10); n /= 10; }
+    for (i = 0; i < k; i++) d[i] = tmp[k-1-i];
+    return k;
+}
+
+/*
+  Lays out digits d[0, k) with d[0] in the 10^x place the way %.<prec>g
+  would. d has no trailing zeros unless it is an integer printed in full.
+*/
+static size_t layout_g(char *buf, int neg, const char *d, int k, int x, int prec) {
+    char *p = buf;
+    if (neg) *p++ = '-';
+    if (x < -4 || x >= prec) {
+        *p++ = d[0];
+        if (k > 1) {
+            *p++ = '.';
+            memcpy(p, d + 1, (size_t)(k - 1));
+            p += k - 1;
+        }
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        if (x < 0) x = -x;
+        if (x >= 1000) {
+            p += sprintf(p, "%d", x); // big floats only
+        } else {
+            if (x >= 100) *p++ = (char)('0' + x / 100);
+            *p++ = (char)('0' + x / 10 % 10);
+            *p++ = (char)('0' + x % 10);
+        }
+    } else if (x >= 0) {
+        if (k <= x + 1) {
+            memcpy(p, d, (size_t)k);
+            p += k;
+            for (int i = k; i <= x; i++) *p++ = '0';
+        } else {
+            memcpy(p, d, (size_t)(x + 1));
+            p += x + 1;
+            *p++ = '.';
+            memcpy(p, d + x + 1, (size_t)(k - x - 1));
+            p += k - x - 1;
+        }
+    } else {
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = -1; i > x; i--) *p++ = '0';
+        memcpy(p, d, (size_t)k);
+        p += k;
+    }
+    *p = '\0';
+    return (size_t)(p - buf);
+}
+
+/*
+  Formats v into buf (at least FORMAT_BUF_LEN bytes, NUL-terminated) and
+  returns the length. Integers below 2^53 are printed directly. FMT_DIGITS
+  defers to snprintf above 15 digits, for subnormals (whose shortest form
+  can be shorter than the rounded one) and for exact ties.
+*/
+size_t format_double(char *buf, double v, const NumberFormat *fmt) {
+    char d[FORMAT_BUF_LEN];
+    int neg = signbit(v) != 0, k, x, e10;
+    double a = fabs(v);
+    if (isnan(v)) { strcpy(buf, neg ? "-nan" : "nan"); return strlen(buf); }
+    if (isinf(v)) { strcpy(buf, neg ? "-inf" : "inf"); return strlen(buf); }
+    if (a == 0.0) { strcpy(buf, neg ? "-0" : "0"); return strlen(buf); }
+    if (fmt->mode == FMT_DIGITS && (fmt->digits > 15 || a < DBL_MIN))
+        return (size_t)snprintf(buf, FORMAT_BUF_LEN, "%.*g", fmt->digits, v);
+
+    if (a < 9007199254740992.0 && a == (double)(uint64_t)a) {
+        k = decimal_digits((uint64_t)a, d);
+        if (fmt->mode == FMT_SHORTEST || k <= fmt->digits)
+            return layout_g(buf, neg, d, k, k - 1, k);
+    }
+
+    k = decimal_digits(shortest_decimal(a, &e10), d);
+    x = e10 + k - 1;
+    if (fmt->mode == FMT_SHORTEST) return layout_g(buf, neg, d, k, x, FORMAT_MAX_DIGITS);
+
+    /*
+      Rounding the shortest digits again is exact: a rounding midpoint
+      strictly between v and its shortest form would itself be a shorter or
+      closer round-trip candidate. Only a shortest form that is the midpoint
+      leaves the direction open.
+    */
+    if (k > fmt->digits) {
+        int n = fmt->digits;
+        if (k == n + 1 && d[n] == '5')
+            return (size_t)snprintf(buf, FORMAT_BUF_LEN, "%.*g", n, v);
+        if (d[n] >= '5') {
+            int i = n - 1;
+            while (i >= 0 && d[i] == '9') d[i--] = '0';
+            if (i >= 0) d[i]++;
+            else { d[0] = '1'; x++; }
+        }
+        k = n;
+        while (k > 1 && d[k-1] == '0') k--;
+    }
+    return layout_g(buf, neg, d, k, x, fmt->digits);
+}
+
+/*
+  A line's result. A line evaluated on integers (see Integer evaluation)
+  also has its exact value, which may not fit a double.
+*/
+typedef struct {
+    double value;
+    int64_t integer;
+    int exact; // integer holds the value
+} CalcValue;
+
+// An exact integer, in full whatever the format says.
+size_t format_integer(char *buf, int64_t v) {
+    uint64_t m = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+    char *p = buf;
+    if (v < 0) *p++ = '-';
+    if (m) p += decimal_digits(m, p);
+    else *p++ = '0';
+    *p = '\0';
+    return (size_t)(p - buf);
+}
+
+size_t format_value(char *buf, const CalcValue *v, const NumberFormat *fmt) {
+    return v->exact ? format_integer(buf, v->integer) : format_double(buf, v->value, fmt);
+}
+
+/* ---------- Big integers ---------- */
+
+/*
+  Integers of any size, for exact mode: a sign and a magnitude in 32-bit
+  limbs, least significant first, with no leading zero limbs (zero has
+  n == 0 and is never negative). Every value must be big_init'ed. Results
+  are built apart and then moved into place, so a result may alias an
+  operand.
+
+  Products use schoolbook multiplication below KARATSUBA_THRESHOLD limbs,
+  Karatsuba below TOOM3_THRESHOLD and Toom-3 (with Bodrato's
+  interpolation) above; operands of very different sizes are multiplied
+  in slices of the smaller one. Division is Knuth's algorithm D and gcd
+  is Stein's binary algorithm. Factorials and binomials multiply their
+  factors as balanced product trees, so the large products meet operands
+  of similar size, where the fast algorithms pay off.
+*/
+
+#define KARATSUBA_THRESHOLD 32
+#define TOOM3_THRESHOLD 256
+#define BIG_PRODUCT_LEAF 16
+#define DECIMAL_SPLIT_LIMBS 32
+#define BINOMIAL_SIEVE_MAX (1u << 22)
+
+typedef struct {
+    uint32_t *d;
+    int n;   // limbs in use
+    int cap; // limbs allocated
+    int neg;
+} BigInt;
+
+void big_init(BigInt *a) {
+    a->d = NULL;
+    a->n = a->cap = 0;
+    a->neg = 0;
+}
+
+void big_free(BigInt *a) {
+    free(a->d);
+    big_init(a);
+}
+
+static void big_reserve(BigInt *a, int cap) {
+    if (cap <= a->cap) return;
+    uint32_t *d = (uint32_t*)realloc(a->d, sizeof(uint32_t) * (size_t)cap);
+    if (!d) { perror("realloc"); exit(1); }
+    a->d = d;
+    a->cap = cap;
+}
+
+static void big_trim(BigInt *a) {
+    while (a->n && a->d[a->n-1] == 0) a->n--;
+    if (!a->n) a->neg = 0;
+}
+
+// Frees *r and hands it t's limbs.
+static void big_move(BigInt *r, BigInt *t) {
+    free(r->d);
+    *r = *t;
+}
+
+static int clz_u32(uint32_t x) { return clz_u64(x) - 32; }
+
+static int ctz_u32(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+// The low 64 bits of |a|.
+static uint64_t big_low_u64(const BigInt *a) {
+    if (!a->n) return 0;
+    return a->d[0] | (a->n > 1 ? (uint64_t)a->d[1] << 32 : 0);
+}
+
+void big_set_u64(BigInt *a, uint64_t v) {
+    big_reserve(a, 2);
+    a->d[0] = (uint32_t)v;
+    a->d[1] = (uint32_t)(v >> 32);
+    a->n = 2;
+    a->neg = 0;
+    big_trim(a);
+}
+
+void big_copy(BigInt *r, const BigInt *a) {
+    if (r == a) return;
+    big_reserve(r, a->n);
+    if (a->n) memcpy(r->d, a->d, sizeof(uint32_t) * (size_t)a->n);
+    r->n = a->n;
+    r->neg = a->neg;
+}
+
+size_t big_bits(const BigInt *a) {
+    return a->n ? 32 * (size_t)a->n - (size_t)clz_u32(a->d[a->n-1]) : 0;
+}
+
+// Trailing zero bits of a nonzero a.
+static size_t big_ctz(const BigInt *a) {
+    int i = 0;
+    while (!a->d[i]) i++;
+    return 32 * (size_t)i + (size_t)ctz_u32(a->d[i]);
+}
+
+// r = a * 2^bits
+void big_shl(BigInt *r, const BigInt *a, size_t bits) {
+    BigInt t;
+    big_init(&t);
+    if (a->n) {
+        int limbs = (int)(bits / 32), s = (int)(bits % 32);
+        big_reserve(&t, a->n + limbs + 1);
+        memset(t.d, 0, sizeof(uint32_t) * (size_t)limbs);
+        uint32_t carry = 0;
+        for (int i = 0; i < a->n; ++i) {
+            t.d[limbs + i] = (a->d[i] << s) | carry;
+            carry = s ? a->d[i] >> (32 - s) : 0;
+        }
+        t.d[limbs + a->n] = carry;
+        t.n = a->n + limbs + 1;
+        t.neg = a->neg;
+        big_trim(&t);
+    }
+    big_move(r, &t);
+}
+
+// r = a / 2^bits, the magnitude rounded down
+void big_shr(BigInt *r, const BigInt *a, size_t bits) {
+    big_copy(r, a);
+    size_t limbs = bits / 32;
+    int s = (int)(bits % 32);
+    if (limbs >= (size_t)r->n) { r->n = 0; r->neg = 0; return; }
+    int n = r->n - (int)limbs;
+    for (int i = 0; i < n; ++i) {
+        uint32_t lo = r->d[i + limbs] >> s;
+        uint32_t hi = s && i + 1 < n ? r->d[i + limbs + 1] << (32 - s) : 0;
+        r->d[i] = lo | hi;
+    }
+    r->n = n;
+    big_trim(r);
+}
+
+// Sets a to v, which must be finite and integral.
+void big_set_double(BigInt *a, double v) {
+    int e;
+    double m = frexp(fabs(v), &e); // |v| = m * 2^e, 1/2 <= m < 1
+    if (e <= 64) {
+        big_set_u64(a, (uint64_t)fabs(v));
+    } else {
+        big_set_u64(a, (uint64_t)ldexp(m, 64));
+        big_shl(a, a, (size_t)(e - 64));
+    }
+    a->neg = v < 0 && a->n;
+}
+
+// a rounded to the nearest double (inf when out of range).
+double big_to_double(const BigInt *a) {
+    size_t bits = big_bits(a);
+    double v;
+    if (bits <= 64) {
+        uint64_t m = 0;
+        for (int i = a->n - 1; i >= 0; --i) m = (m << 32) | a->d[i];
+        v = (double)m;
+    } else if (bits > DBL_MAX_EXP + 64) {
+        v = INFINITY;
+    } else {
+        // the top 64 bits, with the rest folded into a sticky low bit so
+        // that the conversion rounds once, correctly
+        BigInt t;
+        big_init(&t);
+        big_shr(&t, a, bits - 64);
+        uint64_t m = t.d[0] | (uint64_t)t.d[1] << 32;
+        if (big_ctz(a) < bits - 64) m |= 1;
+        big_free(&t);
+        v = ldexp((double)m, (int)(bits - 64));
+    }
+    return a->neg ? -v : v;
+}
+
+// log2 |a| for nonzero a, to a few digits.
+double big_log2(const BigInt *a) {
+    size_t bits = big_bits(a);
+    if (bits <= 64) return log2(fabs(big_to_double(a)));
+    BigInt t;
+    big_init(&t);
+    big_shr(&t, a, bits - 64);
+    t.neg = 0;
+    double top = big_to_double(&t);
+    big_free(&t);
+    return log2(top) + (double)(bits - 64);
+}
+
+static int mag_cmp(const uint32_t *a, int an, const uint32_t *b, int bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (int i = an - 1; i >= 0; --i)
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+int big_cmp(const BigInt *a, const BigInt *b) {
+    if (a->neg != b->neg) return a->neg ? -1 : 1;
+    int c = mag_cmp(a->d, a->n, b->d, b->n);
+    return a->neg ? -c : c;
+}
+
+// r[0, an) = a + b for an >= bn; returns the carry out. r may be a.
+static uint32_t mag_add(uint32_t *r, const uint32_t *a, int an, const uint32_t *b, int bn) {
+    uint64_t c = 0;
+    int i = 0;
+    for (; i < bn; ++i) { c += (uint64_t)a[i] + b[i]; r[i] = (uint32_t)c; c >>= 32; }
+    for (; i < an; ++i) { c += a[i]; r[i] = (uint32_t)c; c >>= 32; }
+    return (uint32_t)c;
+}
+
+// r[0, an) = a - b for a >= b, an >= bn. r may be a.
+static void mag_sub(uint32_t *r, const uint32_t *a, int an, const uint32_t *b, int bn) {
+    uint32_t borrow = 0;
+    int i = 0;
+    for (; i < bn; ++i) {
+        uint64_t d = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 63);
+    }
+    for (; i < an; ++i) {
+        uint64_t d = (uint64_t)a[i] - borrow;
+        r[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 63);
+    }
+}
+
+// r[0, an+bn) = a * b
+static void mag_mul_school(uint32_t *r, const uint32_t *a, int an, const uint32_t *b, int bn) {
+    memset(r, 0, sizeof(uint32_t) * (size_t)(an + bn));
+    for (int j = 0; j < bn; ++j) {
+        uint64_t c = 0, bj = b[j];
+        if (!bj) continue;
+        for (int i = 0; i < an; ++i) {
+            c += (uint64_t)a[i] * bj + r[i + j];
+            r[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        r[an + j] = (uint32_t)c;
+    }
+}
+
+// Scratch limbs mag_karatsuba needs for n-limb operands.
+static size_t karatsuba_scratch(int n) {
+    size_t s = 0;
+    while (n >= KARATSUBA_THRESHOLD) {
+        int h = n - n / 2;
+        s += 4 * (size_t)(h + 1);
+        n = h + 1;
+    }
+    return s;
+}
+
+// r[0, 2n) = a * b for n-limb a and b; t has karatsuba_scratch(n) limbs.
+static void mag_karatsuba(uint32_t *r, const uint32_t *a, const uint32_t *b, int n, uint32_t *t) {
+    if (n < KARATSUBA_THRESHOLD) { mag_mul_school(r, a, n, b, n); return; }
+    // a = a1 B^m + a0: a0 b0 goes below limb 2m and a1 b1 above
+    int m = n / 2, h = n - m;
+    mag_karatsuba(r, a, b, m, t);
+    mag_karatsuba(r + 2*m, a + m, b + m, h, t);
+    uint32_t *sa = t, *sb = t + (h + 1), *z = t + 2*(h + 1);
+    sa[h] = mag_add(sa, a + m, h, a, m);
+    sb[h] = mag_add(sb, b + m, h, b, m);
+    mag_karatsuba(z, sa, sb, h + 1, z + 2*(h + 1));
+    // z = (a0 + a1)(b0 + b1) - a0 b0 - a1 b1 = a0 b1 + a1 b0 < B^(n+1)
+    mag_sub(z, z, 2*(h + 1), r, 2*m);
+    mag_sub(z, z, 2*(h + 1), r + 2*m, 2*h);
+    mag_add(r + m, r + m, 2*n - m, z, n + 1);
+}
+
+// r[0, an+bn) = a * b; r must not overlap a or b.
+static void mag_mul(uint32_t *r, const uint32_t *a, int an, const uint32_t *b, int bn) {
+    if (an < bn) {
+        const uint32_t *p = a; a = b; b = p;
+        int k = an; an = bn; bn = k;
+    }
+    if (bn < KARATSUBA_THRESHOLD) { mag_mul_school(r, a, an, b, bn); return; }
+    size_t scratch = karatsuba_scratch(bn);
+    uint32_t *t = (uint32_t*)malloc(sizeof(uint32_t) * (scratch + 2 * (size_t)bn));
+    if (!t) { perror("malloc"); exit(1); }
+    uint32_t *part = t + scratch;
+    memset(r, 0, sizeof(uint32_t) * (size_t)(an + bn));
+    // a in bn-limb slices, each a square product with b
+    for (int off = 0; off < an; off += bn) {
+        int len = an - off < bn ? an - off : bn;
+        if (len == bn) mag_karatsuba(part, a + off, b, bn, t);
+        else mag_mul(part, b, bn, a + off, len);
+        mag_add(r + off, r + off, an + bn - off, part, len + bn);
+    }
+    free(t);
+}
+
+static void big_add_signed(BigInt *r, const BigInt *a, const BigInt *b, int bneg) {
+    BigInt t;
+    big_init(&t);
+    if (a->neg == bneg) {
+        const BigInt *x = a->n >= b->n ? a : b, *y = x == a ? b : a;
+        big_reserve(&t, x->n + 1);
+        t.d[x->n] = mag_add(t.d, x->d, x->n, y->d, y->n);
+        t.n = x->n + 1;
+        t.neg = bneg;
+    } else {
+        int swap = mag_cmp(a->d, a->n, b->d, b->n) < 0;
+        const BigInt *x = swap ? b : a, *y = swap ? a : b;
+        big_reserve(&t, x->n);
+        mag_sub(t.d, x->d, x->n, y->d, y->n);
+        t.n = x->n;
+        t.neg = swap ? bneg : a->neg;
+    }
+    big_trim(&t);
+    big_move(r, &t);
+}
+
+void big_add(BigInt *r, const BigInt *a, const BigInt *b) { big_add_signed(r, a, b, b->neg); }
+void big_sub(BigInt *r, const BigInt *a, const BigInt *b) { big_add_signed(r, a, b, !b->neg); }
+
+// a = |a| * m + c, in place
+void big_mul_add_small(BigInt *a, uint32_t m, uint32_t c) {
+    uint64_t carry = c;
+    for (int i = 0; i < a->n; ++i) {
+        carry += (uint64_t)a->d[i] * m;
+        a->d[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry) {
+        big_reserve(a, a->n + 1);
+        a->d[a->n++] = (uint32_t)carry;
+    }
+    big_trim(a);
+}
+
+// a /= m in place, on the magnitude; returns the remainder.
+uint32_t big_div_small(BigInt *a, uint32_t m) {
+    uint64_t rem = 0;
+    for (int i = a->n - 1; i >= 0; --i) {
+        uint64_t cur = (rem << 32) | a->d[i];
+        a->d[i] = (uint32_t)(cur / m);
+        rem = cur % m;
+    }
+    big_trim(a);
+    return (uint32_t)rem;
+}
+
+// A view of limbs [from, from + k) of a's magnitude; never freed or written.
+static BigInt big_slice(const BigInt *a, int from, int k) {
+    BigInt s;
+    s.d = a->d + from;
+    s.n = from >= a->n ? 0 : (a->n - from < k ? a->n - from : k);
+    s.cap = 0;
+    s.neg = 0;
+    big_trim(&s);
+    return s;
+}
+
+void big_mul(BigInt *r, const BigInt *a, const BigInt *b);
+
+// r += a * B^limbs
+static void big_add_shifted(BigInt *r, const BigInt *a, int limbs) {
+    BigInt t;
+    big_init(&t);
+    big_shl(&t, a, 32 * (size_t)limbs);
+    big_add(r, r, &t);
+    big_free(&t);
+}
+
+// p = a2 x^2 + a1 x + a0 at x = 1, -1 and -2
+static void toom3_evaluate(BigInt *p1, BigInt *pm1, BigInt *pm2, const BigInt *a0, const BigInt *a1, const BigInt *a2) {
+    big_add(p1, a0, a2);
+    big_sub(pm1, p1, a1);
+    big_add(p1, p1, a1);
+    big_add(pm2, pm1, a2);
+    big_shl(pm2, pm2, 1);
+    big_sub(pm2, pm2, a0);
+}
+
+// r = |a| * |b|, splitting both into three parts
+static void big_toom3(BigInt *r, const BigInt *a, const BigInt *b) {
+    int k = ((a->n > b->n ? a->n : b->n) + 2) / 3;
+    BigInt a0 = big_slice(a, 0, k), a1 = big_slice(a, k, k), a2 = big_slice(a, 2*k, k);
+    BigInt b0 = big_slice(b, 0, k), b1 = big_slice(b, k, k), b2 = big_slice(b, 2*k, k);
+    BigInt p1, pm1, pm2, q1, qm1, qm2, r0, r1, rm1, rm2, rinf;
+    BigInt *all[] = { &p1, &pm1, &pm2, &q1, &qm1, &qm2, &r0, &r1, &rm1, &rm2, &rinf };
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) big_init(all[i]);
+
+    toom3_evaluate(&p1, &pm1, &pm2, &a0, &a1, &a2);
+    toom3_evaluate(&q1, &qm1, &qm2, &b0, &b1, &b2);
+    big_mul(&r0, &a0, &b0);
+    big_mul(&r1, &p1, &q1);
+    big_mul(&rm1, &pm1, &qm1);
+    big_mul(&rm2, &pm2, &qm2);
+    big_mul(&rinf, &a2, &b2);
+
+    // rm2, r1 and rm1 become the coefficients of x^3, x and x^2
+    big_sub(&rm2, &rm2, &r1);
+    big_div_small(&rm2, 3);
+    big_sub(&r1, &r1, &rm1);
+    big_shr(&r1, &r1, 1);
+    big_sub(&rm1, &rm1, &r0);
+    big_sub(&rm2, &rm1, &rm2);
+    big_shr(&rm2, &rm2, 1);
+    big_shl(&q1, &rinf, 1);
+    big_add(&rm2, &rm2, &q1);
+    big_add(&rm1, &rm1, &r1);
+    big_sub(&rm1, &rm1, &rinf);
+    big_sub(&r1, &r1, &rm2);
+
+    big_add_shifted(&r0, &r1, k);
+    big_add_shifted(&r0, &rm1, 2*k);
+    big_add_shifted(&r0, &rm2, 3*k);
+    big_add_shifted(&r0, &rinf, 4*k);
+    big_move(r, &r0);
+    big_init(&r0);
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) big_free(all[i]);
+}
+
+void big_mul(BigInt *r, const BigInt *a, const BigInt *b) {
+    BigInt t;
+    big_init(&t);
+    if (a->n && b->n) {
+        int lo = a->n < b->n ? a->n : b->n, hi = a->n ^ b->n ^ lo;
+        if (lo >= TOOM3_THRESHOLD && 2 * lo > hi) {
+            big_toom3(&t, a, b);
+        } else {
+            big_reserve(&t, a->n + b->n);
+            mag_mul(t.d, a->d, a->n, b->d, b->n);
+            t.n = a->n + b->n;
+        }
+        t.neg = a->neg ^ b->neg;
+        big_trim(&t);
+    }
+    big_move(r, &t);
+}
+
+/*
+  q = a / b and m = a % b, truncating toward zero as C does (m takes a's
+  sign); b must not be zero. Either result may be NULL.
+*/
+void big_divmod(BigInt *q, BigInt *m, const BigInt *a, const BigInt *b) {
+    BigInt qt, rt;
+    big_init(&qt);
+    big_init(&rt);
+    if (mag_cmp(a->d, a->n, b->d, b->n) < 0) {
+        big_copy(&rt, a);
+    } else if (b->n == 1) {
+        big_copy(&qt, a);
+        big_set_u64(&rt, big_div_small(&qt, b->d[0]));
+    } else {
+        // algorithm D on the magnitudes, scaled so that the divisor's top
+        // bit is set
+        int s = clz_u32(b->d[b->n-1]);
+        BigInt u, v, ua = *a, vb = *b;
+        ua.neg = vb.neg = 0;
+        big_init(&u);
+        big_init(&v);
+        big_shl(&u, &ua, (size_t)s);
+        big_shl(&v, &vb, (size_t)s);
+        int n = v.n, len = a->n - n;
+        big_reserve(&u, a->n + 1);
+        if (u.n == a->n) u.d[a->n] = 0;
+        big_reserve(&qt, len + 1);
+        qt.n = len + 1;
+        const uint64_t base = (uint64_t)1 << 32;
+        for (int j = len; j >= 0; --j) {
+            uint64_t num = ((uint64_t)u.d[j+n] << 32) | u.d[j+n-1];
+            uint64_t qhat = num / v.d[n-1], rhat = num % v.d[n-1];
+            while (qhat >= base || qhat * v.d[n-2] > ((rhat << 32) | u.d[j+n-2])) {
+                qhat--;
+                rhat += v.d[n-1];
+                if (rhat >= base) break;
+            }
+            int64_t borrow = 0, t;
+            for (int i = 0; i < n; ++i) {
+                uint64_t p = qhat * v.d[i];
+                t = (int64_t)u.d[i+j] - borrow - (int64_t)(p & 0xffffffffu);
+                u.d[i+j] = (uint32_t)t;
+                borrow = (int64_t)(p >> 32) - (t >> 32);
+            }
+            t = (int64_t)u.d[j+n] - borrow;
+            u.d[j+n] = (uint32_t)t;
+            if (t < 0) {
+                // qhat was one too large: add v back
+                qhat--;
+                uint64_t c = 0;
+                for (int i = 0; i < n; ++i) {
+                    c += (uint64_t)u.d[i+j] + v.d[i];
+                    u.d[i+j] = (uint32_t)c;
+                    c >>= 32;
+                }
+                u.d[j+n] += (uint32_t)c;
+            }
+            qt.d[j] = (uint32_t)qhat;
+        }
+        u.n = n;
+        big_trim(&u);
+        big_shr(&rt, &u, (size_t)s);
+        big_free(&u);
+        big_free(&v);
+    }
+    qt.neg = a->neg ^ b->neg;
+    rt.neg = a->neg;
+    big_trim(&qt);
+    big_trim(&rt);
+    if (q) big_move(q, &qt); else big_free(&qt);
+    if (m) big_move(m, &rt); else big_free(&rt);
+}
+
+// r = gcd(|a|, |b|), by Stein's algorithm after one division to even out the sizes
+void big_gcd(BigInt *r, const BigInt *a, const BigInt *b) {
+    if (a->n <= 2 && b->n <= 2) {
+        big_set_u64(r, gcd_u64(big_low_u64(a), big_low_u64(b)));
+        return;
+    }
+    BigInt u, v;
+    big_init(&u);
+    big_init(&v);
+    if (mag_cmp(a->d, a->n, b->d, b->n) < 0) { const BigInt *t = a; a = b; b = t; }
+    big_copy(&v, b);
+    if (b->n) big_divmod(NULL, &u, a, b);
+    else big_copy(&u, a);
+    u.neg = v.neg = 0;
+    if (!u.n || !v.n) {
+        big_move(r, u.n ? &u : &v);
+        big_free(u.n ? &v : &u);
+        return;
+    }
+    size_t zu = big_ctz(&u), zv = big_ctz(&v), shift = zu < zv ? zu : zv;
+    big_shr(&u, &u, zu);
+    big_shr(&v, &v, zv);
+    for (;;) {
+        if (u.n <= 2 && v.n <= 2) {
+            big_set_u64(&u, gcd_u64(big_low_u64(&u), big_low_u64(&v)));
+            break;
+        }
+        int c = mag_cmp(u.d, u.n, v.d, v.n);
+        if (c == 0) break;
+        if (c < 0) { BigInt t = u; u = v; v = t; }
+        if (u.n > v.n + 1) {
+            // far apart: one division does the work of many subtractions
+            big_divmod(NULL, &u, &u, &v);
+            if (!u.n) { big_move(&u, &v); big_init(&v); break; }
+        } else {
+            // both odd: the difference is even and the larger can be replaced by it
+            mag_sub(u.d, u.d, u.n, v.d, v.n);
+            big_trim(&u);
+        }
+        big_shr(&u, &u, big_ctz(&u));
+    }
+    big_shl(r, &u, shift);
+    big_free(&u);
+    big_free(&v);
+}
+
+// r = a^e
+void big_pow(BigInt *r, const BigInt *a, uint64_t e) {
+    BigInt base, acc;
+    big_init(&base);
+    big_init(&acc);
+    big_copy(&base, a);
+    big_set_u64(&acc, 1);
+    while (e) {
+        if (e & 1) big_mul(&acc, &acc, &base);
+        e >>= 1;
+        if (e) big_mul(&base, &base, &base);
+    }
+    big_move(r, &acc);
+    big_free(&base);
+}
+
+// Sets a to the decimal digits in s[0, n); anything else is skipped.
+void big_from_decimal(BigInt *a, const char *s, size_t n) {
+    big_set_u64(a, 0);
+    uint32_t chunk = 0, scale = 1;
+    for (size_t i = 0; i < n; ++i) {
+        if (!isdigit((unsigned char)s[i])) continue;
+        chunk = chunk * 10 + (uint32_t)(s[i] - '0');
+        scale *= 10;
+        if (scale == 1000000000u) {
+            big_mul_add_small(a, scale, chunk);
+            chunk = 0;
+            scale = 1;
+        }
+    }
+    if (scale > 1) big_mul_add_small(a, scale, chunk);
+}
+
+// Writes |a| < 10^width as exactly width digits at s, width a multiple of 9.
+static void decimal_groups(const BigInt *a, char *s, size_t width) {
+    BigInt t;
+    big_init(&t);
+    big_copy(&t, a);
+    for (size_t k = width; k > 0; k -= 9) {
+        // big_div_small by a constant, which compiles to multiplications
+        uint64_t rem = 0;
+        for (int i = t.n - 1; i >= 0; --i) {
+            uint64_t cur = (rem << 32) | t.d[i];
+            t.d[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        big_trim(&t);
+        uint32_t v = (uint32_t)rem;
+        for (int i = 8; i >= 0; --i) { s[k - 9 + (size_t)i] = (char)('0' + v % 10); v /= 10; }
+    }
+    big_free(&t);
+}
+
+/*
+  Writes |a| < pow[level]^2 as exactly 18 * 2^level digits at s, where
+  pow[i] = 10^(9 * 2^i): dividing by pow[level] splits the digits in
+  halves, down to numbers small enough for division by 10^9.
+*/
+static void decimal_split(const BigInt *a, const BigInt *pow, int level, char *s) {
+    size_t half = (size_t)9 << level;
+    if (level == 0 || a->n <= DECIMAL_SPLIT_LIMBS) { decimal_groups(a, s, 2 * half); return; }
+    BigInt q, r;
+    big_init(&q);
+    big_init(&r);
+    big_divmod(&q, &r, a, &pow[level]);
+    decimal_split(&q, pow, level - 1, s);
+    decimal_split(&r, pow, level - 1, s + half);
+    big_free(&q);
+    big_free(&r);
+}
+
+// a in decimal, with a leading '-' if negative: a malloc'd string of *len chars.
+char *big_to_decimal(const BigInt *a, size_t *len) {
+    // pow[level] = 10^(9 * 2^level), up to the first whose square exceeds |a|
+    BigInt pow[32];
+    int level = 0;
+    big_init(&pow[0]);
+    big_set_u64(&pow[0], 1000000000u);
+    while (2 * (big_bits(&pow[level]) - 1) < big_bits(a)) {
+        big_init(&pow[level + 1]);
+        big_mul(&pow[level + 1], &pow[level], &pow[level]);
+        level++;
+    }
+    size_t width = (size_t)18 << level;
+    char *s = (char*)malloc(width + 2);
+    if (!s) { perror("malloc"); exit(1); }
+    decimal_split(a, pow, level, s + 1);
+    for (int i = 0; i <= level; ++i) big_free(&pow[i]);
+    size_t skip = 1;
+    while (skip < width && s[skip] == '0') skip++;
+    if (a->neg) s[--skip] = '-';
+    *len = width + 1 - skip;
+    memmove(s, s + skip, *len);
+    s[*len] = '\0';
+    return s;
+}
+
+// r = f[0] * f[1] * ... * f[n-1]
+void big_product(BigInt *r, const uint32_t *f, size_t n) {
+    if (n <= BIG_PRODUCT_LEAF) {
+        big_set_u64(r, 1);
+        for (size_t i = 0; i < n; ++i) big_mul_add_small(r, f[i], 0);
+        return;
+    }
+    BigInt left, right;
+    big_init(&left);
+    big_init(&right);
+    big_product(&left, f, n / 2);
+    big_product(&right, f + n / 2, n - n / 2);
+    big_mul(r, &left, &right);
+    big_free(&left);
+    big_free(&right);
+}
+
+// r = lo * (lo + 1) * ... * hi, or 1 when lo > hi
+void big_range_product(BigInt *r, uint32_t lo, uint32_t hi) {
+    if (lo > hi) { big_set_u64(r, 1); return; }
+    if (hi - lo < BIG_PRODUCT_LEAF) {
+        big_set_u64(r, lo);
+        for (uint32_t i = lo; i < hi; ) big_mul_add_small(r, ++i, 0);
+        return;
+    }
+    uint32_t mid = lo + (hi - lo) / 2;
+    BigInt left, right;
+    big_init(&left);
+    big_init(&right);
+    big_range_product(&left, lo, mid);
+    big_range_product(&right, mid + 1, hi);
+    big_mul(r, &left, &right);
+    big_free(&left);
+    big_free(&right);
+}
+
+/*
+  r = n choose k for k <= n. The prime factorization comes from a sieve:
+  by Legendre's formula p occurs sum(floor(n/p^i) - floor(k/p^i) -
+  floor((n-k)/p^i)) times, and the prime powers are multiplied as a
+  product tree. Small k, or n beyond the sieve, divide n!/(n-k)! by k!
+  instead.
+*/
+void big_binomial(BigInt *r, uint32_t n, uint32_t k) {
+    if (k > n - k) k = n - k;
+    if (k == 0) { big_set_u64(r, 1); return; }
+    if (k < 64 || n > BINOMIAL_SIEVE_MAX) {
+        BigInt d;
+        big_init(&d);
+        big_range_product(r, n - k + 1, n);
+        big_range_product(&d, 2, k);
+        big_divmod(r, NULL, r, &d);
+        big_free(&d);
+        return;
+    }
+    unsigned char *composite = (unsigned char*)calloc(n + 1, 1);
+    size_t count = 0, cap = 1024;
+    uint32_t *f = (uint32_t*)malloc(sizeof(uint32_t) * cap);
+    if (!composite || !f) { perror("malloc"); exit(1); }
+    for (uint32_t p = 2; p <= n; ++p) {
+        if (composite[p]) continue;
+        for (uint64_t m = (uint64_t)p * p; m <= n; m += p) composite[m] = 1;
+        unsigned e = 0;
+        for (uint64_t q = p; q <= n; q *= p) e += (unsigned)(n / q - k / q - (n - k) / q);
+        // p^e in factors that fit 32 bits
+        uint32_t acc = 1;
+        for (unsigned i = 0; i <= e; ++i) {
+            if (i == e || acc > UINT32_MAX / p) {
+                if (acc > 1) {
+                    if (count == cap) {
+                        cap *= 2;
+                        f = (uint32_t*)realloc(f, sizeof(uint32_t) * cap);
+                        if (!f) { perror("realloc"); exit(1); }
+                    }
+                    f[count++] = acc;
+                }
+                acc = 1;
+            }
+            if (i < e) acc *= p;
+        }
+    }
+    big_product(r, f, count);
+    free(f);
+    free(composite);
+}
+
+/* ---------- Big floats ---------- */
+
+/*
+  Binary floating point of any precision, for digits mode: m * 2^e with a
+  BigInt m. Precision is passed to each operation rather than stored, and
+  every operation rounds its result to that many bits, to nearest with
+  ties to even; operands may carry more bits.
+
+  +, -, *, / and sqrt round correctly by construction: whatever they
+  drop below the rounding position is kept as a sticky bit. exp, ln, sin
+  and cos are computed with guard bits (exp and the trigonometric
+  functions by argument reduction and a Taylor series, ln by the AGM)
+  and checked Ziv-style: a result too close to a rounding boundary for
+  its error bound is computed again with twice the guard bits. pi, e and
+  ln 2 are sums of series evaluated by binary splitting, and they and
+  ln 10 are cached per session at the highest precision asked for.
+*/
+
+typedef struct {
+    BigInt m;
+    long e;
+} BigFloat;
+
+typedef enum { FC_PI, FC_E, FC_LN2, FC_LN10, FC_COUNT } FloatConst;
+
+typedef struct {
+    BigFloat value[FC_COUNT];
+    size_t prec[FC_COUNT]; // bits value is good to, 0 if not computed yet
+} FloatConsts;
+
+void bf_init(BigFloat *x) {
+    big_init(&x->m);
+    x->e = 0;
+}
+
+void bf_free(BigFloat *x) { big_free(&x->m); }
+
+void bf_copy(BigFloat *r, const BigFloat *x) {
+    big_copy(&r->m, &x->m);
+    r->e = x->e;
+}
+
+static void bf_move(BigFloat *r, BigFloat *t) {
+    big_move(&r->m, &t->m);
+    r->e = t->e;
+}
+
+// For nonzero x, 2^(bf_top(x) - 1) <= |x| < 2^bf_top(x).
+long bf_top(const BigFloat *x) { return x->e + (long)big_bits(&x->m); }
+
+static int big_bit(const BigInt *a, size_t i) {
+    return i / 32 < (size_t)a->n && ((a->d[i / 32] >> (i % 32)) & 1);
+}
+
+void bf_round(BigFloat *x, size_t prec) {
+    size_t bits = big_bits(&x->m);
+    if (bits <= prec) return;
+    size_t drop = bits - prec;
+    int half = big_bit(&x->m, drop - 1);
+    int sticky = drop > 1 && big_ctz(&x->m) < drop - 1;
+    big_shr(&x->m, &x->m, drop);
+    x->e += (long)drop;
+    if (half && (sticky || (x->m.d[0] & 1))) {
+        big_mul_add_small(&x->m, 1, 1);
+        if (big_bits(&x->m) > prec) {
+            big_shr(&x->m, &x->m, 1);
+            x->e++;
+        }
+    }
+}
+
+void bf_set_int(BigFloat *r, const BigInt *a) {
+    big_copy(&r->m, a);
+    r->e = 0;
+}
+
+// r = v, exactly; v must be finite.
+void bf_set_double(BigFloat *r, double v) {
+    int e;
+    double m = frexp(v, &e);
+    big_set_double(&r->m, ldexp(m, 53));
+    r->e = e - 53;
+}
+
+// r = 2^e
+static void bf_set_pow2(BigFloat *r, long e) {
+    big_set_u64(&r->m, 1);
+    r->e = e;
+}
+
+double bf_to_double(const BigFloat *x) {
+    if (!x->m.n) return 0.0;
+    long top = bf_top(x);
+    if (top > DBL_MAX_EXP + 1) return x->m.neg ? -INFINITY : INFINITY;
+    if (top < DBL_MIN_EXP - DBL_MANT_DIG - 1) return x->m.neg ? -0.0 : 0.0;
+    BigFloat t;
+    bf_init(&t);
+    bf_copy(&t, x);
+    bf_round(&t, DBL_MANT_DIG);
+    double v = ldexp(big_to_double(&t.m), (int)t.e);
+    bf_free(&t);
+    return v;
+}
+
+static void bf_add_signed(BigFloat *r, const BigFloat *a, const BigFloat *b, int bneg, size_t prec) {
+    BigFloat t;
+    bf_init(&t);
+    BigFloat x = *a, y = *b; // views, never freed
+    y.m.neg = y.m.n && bneg;
+    if (!y.m.n || !x.m.n) {
+        bf_copy(&t, x.m.n ? &x : &y);
+    } else {
+        if (bf_top(&x) < bf_top(&y)) { BigFloat s = x; x = y; y = s; }
+        long floor_e = bf_top(&x) - (long)prec - 3;
+        if (x.e < floor_e) floor_e = x.e;
+        if (bf_top(&y) < floor_e) {
+            // y is below every bit of x and the rounding position: one
+            // unit of its sign, lower still, rounds the same way
+            BigInt unit;
+            big_init(&unit);
+            big_set_u64(&unit, 1);
+            unit.neg = y.m.neg;
+            big_shl(&t.m, &x.m, (size_t)(x.e - floor_e + 1));
+            big_add(&t.m, &t.m, &unit);
+            t.e = floor_e - 1;
+            big_free(&unit);
+        } else {
+            long e = x.e < y.e ? x.e : y.e;
+            BigInt u;
+            big_init(&u);
+            big_shl(&t.m, &x.m, (size_t)(x.e - e));
+            big_shl(&u, &y.m, (size_t)(y.e - e));
+            big_add(&t.m, &t.m, &u);
+            t.e = e;
+            big_free(&u);
+        }
+    }
+    bf_round(&t, prec);
+    bf_move(r, &t);
+}
+
+void bf_add(BigFloat *r, const BigFloat *a, const BigFloat *b, size_t prec) { bf_add_signed(r, a, b, b->m.neg, prec); }
+void bf_sub(BigFloat *r, const BigFloat *a, const BigFloat *b, size_t prec) { bf_add_signed(r, a, b, !b->m.neg, prec); }
+
+void bf_mul(BigFloat *r, const BigFloat *a, const BigFloat *b, size_t prec) {
+    big_mul(&r->m, &a->m, &b->m);
+    r->e = a->e + b->e;
+    bf_round(r, prec);
+}
+
+// r = a / b for nonzero b
+void bf_div(BigFloat *r, const BigFloat *a, const BigFloat *b, size_t prec) {
+    // a quotient of at least prec + 2 bits, then a sticky bit for the remainder
+    long shift = (long)prec + 2 + (long)big_bits(&b->m) - (long)big_bits(&a->m);
+    if (shift < 0) shift = 0;
+    BigFloat t;
+    BigInt n, rem;
+    bf_init(&t);
+    big_init(&n);
+    big_init(&rem);
+    big_shl(&n, &a->m, (size_t)shift);
+    big_divmod(&t.m, &rem, &n, &b->m);
+    if (rem.n) {
+        big_shl(&t.m, &t.m, 1);
+        big_mul_add_small(&t.m, 1, 1);
+        shift++;
+    }
+    t.e = a->e - b->e - shift;
+    big_free(&n);
+    big_free(&rem);
+    bf_round(&t, prec);
+    bf_move(r, &t);
+}
+
+// r = floor(sqrt(a)) for a >= 0, by Newton's method from the root of a's top half.
+static void big_isqrt(BigInt *r, const BigInt *a) {
+    size_t bits = big_bits(a);
+    if (bits <= 52) {
+        // exact in a double, and too short for the rounded root to reach the next integer
+        big_set_u64(r, (uint64_t)sqrt(big_to_double(a)));
+        return;
+    }
+    // (isqrt(a / 4^k) + 1) * 2^k is above the root and good to about half its bits
+    size_t k = (bits - 32) / 4;
+    BigInt x, y, q;
+    big_init(&x);
+    big_init(&y);
+    big_init(&q);
+    big_shr(&x, a, 2 * k);
+    big_isqrt(&x, &x);
+    big_mul_add_small(&x, 1, 1);
+    big_shl(&x, &x, k);
+    for (;;) {
+        big_divmod(&q, NULL, a, &x);
+        big_add(&y, &x, &q);
+        big_shr(&y, &y, 1);
+        if (mag_cmp(y.d, y.n, x.d, x.n) >= 0) break;
+        big_move(&x, &y);
+        big_init(&y);
+    }
+    big_move(r, &x);
+    big_free(&y);
+    big_free(&q);
+}
+
+// r = sqrt(a) for a >= 0
+void bf_sqrt(BigFloat *r, const BigFloat *a, size_t prec) {
+    // an integer root of at least prec + 2 bits from an even exponent
+    long shift = 2 * ((long)prec + 2) - (long)big_bits(&a->m) + 2;
+    if (shift < 0) shift = 0;
+    if ((a->e - shift) % 2) shift++;
+    BigFloat t;
+    BigInt n, sq;
+    bf_init(&t);
+    big_init(&n);
+    big_init(&sq);
+    big_shl(&n, &a->m, (size_t)shift);
+    big_isqrt(&t.m, &n);
+    big_mul(&sq, &t.m, &t.m);
+    if (mag_cmp(sq.d, sq.n, n.d, n.n) != 0) {
+        big_shl(&t.m, &t.m, 1);
+        big_mul_add_small(&t.m, 1, 1);
+        shift += 2;
+    }
+    t.e = (a->e - shift) / 2;
+    big_free(&n);
+    big_free(&sq);
+    bf_round(&t, prec);
+    bf_move(r, &t);
+}
+
+// r = x^n, rounded once per multiplication at prec bits
+void bf_pow_int(BigFloat *r, const BigFloat *x, uint64_t n, size_t prec) {
+    BigFloat base, acc;
+    bf_init(&base);
+    bf_init(&acc);
+    bf_copy(&base, x);
+    bf_set_pow2(&acc, 0);
+    while (n) {
+        if (n & 1) bf_mul(&acc, &acc, &base, prec);
+        n >>= 1;
+        if (n) bf_mul(&base, &base, &base, prec);
+    }
+    bf_move(r, &acc);
+    bf_free(&base);
+}
+
+/*
+  r = x rounded to an integer: toward -inf (dir < 0), +inf (dir > 0), or to
+  nearest with ties away from zero (dir == 0).
+*/
+void bf_to_int(BigInt *r, const BigFloat *x, int dir) {
+    if (x->e >= 0) {
+        big_shl(r, &x->m, (size_t)x->e);
+        return;
+    }
+    size_t frac = (size_t)-x->e;
+    int neg = x->m.neg;
+    int up;
+    if (dir == 0) up = big_bit(&x->m, frac - 1);
+    else up = (dir > 0) != neg && big_ctz(&x->m) < frac;
+    big_shr(r, &x->m, frac);
+    if (up) {
+        big_mul_add_small(r, 1, 1);
+        r->neg = neg;
+    }
+}
+
+// r = round(x * 2^fraction) as an integer, truncated
+static void bf_to_fixed(BigInt *r, const BigFloat *x, long fraction) {
+    long s = x->e + fraction;
+    if (s >= 0) big_shl(r, &x->m, (size_t)s);
+    else big_shr(r, &x->m, (size_t)-s);
+}
+
+// r = a * b / 2^fraction for fixed-point a and b
+static void fixed_mul(BigInt *r, const BigInt *a, const BigInt *b, long fraction) {
+    big_mul(r, a, b);
+    big_shr(r, r, (size_t)fraction);
+}
+
+static size_t log2_size(size_t n) {
+    size_t k = 0;
+    while (n >>= 1) k++;
+    return k;
+}
+
+/*
+  Binary splitting for sum(a(n)/b(n) * p(n1)...p(n) / (q(n1)...q(n))) over
+  n in [n1, n2): sets P, Q and B to the products of p, q and b over the
+  range and T so that the sum is T / (B Q). Halves combine as
+  T = B2 Q2 T1 + B1 P1 T2.
+*/
+typedef void (*SeriesTerm)(unsigned long n, BigInt *a, BigInt *b, BigInt *p, BigInt *q);
+
+static void series_split(SeriesTerm term, unsigned long n1, unsigned long n2,
+                         BigInt *P, BigInt *Q, BigInt *B, BigInt *T) {
+    if (n2 - n1 == 1) {
+        BigInt a;
+        big_init(&a);
+        term(n1, &a, B, P, Q);
+        big_mul(T, &a, P);
+        big_free(&a);
+        return;
+    }
+    unsigned long mid = n1 + (n2 - n1) / 2;
+    BigInt P2, Q2, B2, T2, t;
+    big_init(&P2); big_init(&Q2); big_init(&B2); big_init(&T2); big_init(&t);
+    series_split(term, n1, mid, P, Q, B, T);
+    series_split(term, mid, n2, &P2, &Q2, &B2, &T2);
+    big_mul(&t, &B2, &Q2);
+    big_mul(T, T, &t);
+    big_mul(&t, B, P);
+    big_mul(&t, &t, &T2);
+    big_add(T, T, &t);
+    big_mul(P, P, &P2);
+    big_mul(Q, Q, &Q2);
+    big_mul(B, B, &B2);
+    big_free(&P2); big_free(&Q2); big_free(&B2); big_free(&T2); big_free(&t);
+}
+
+// Chudnovsky: 1/pi = 12 / 640320^(3/2) * sum((-1)^n (6n)! (13591409 + 545140134 n) / ((3n)! n!^3 640320^3n))
+static void pi_term(unsigned long n, BigInt *a, BigInt *b, BigInt *p, BigInt *q) {
+    BigInt c;
+    big_init(&c);
+    big_set_u64(a, 545140134);
+    big_mul_add_small(a, (uint32_t)n, 0);
+    big_set_u64(&c, 13591409);
+    big_add(a, a, &c);
+    big_set_u64(b, 1);
+    if (n == 0) {
+        big_set_u64(p, 1);
+        big_set_u64(q, 1);
+    } else {
+        // p = -(6n-5)(2n-1)(6n-1), q = n^3 640320^3 / 24
+        big_set_u64(p, 6 * (uint64_t)n - 5);
+        big_set_u64(&c, (2 * (uint64_t)n - 1) * (6 * (uint64_t)n - 1));
+        big_mul(p, p, &c);
+        p->neg = 1;
+        big_set_u64(q, (uint64_t)n * n);
+        big_mul_add_small(q, (uint32_t)n, 0);
+        big_set_u64(&c, 10939058860032000ULL);
+        big_mul(q, q, &c);
+    }
+    big_free(&c);
+}
+
+// e = sum(1 / n!)
+static void e_term(unsigned long n, BigInt *a, BigInt *b, BigInt *p, BigInt *q) {
+    big_set_u64(a, 1);
+    big_set_u64(b, 1);
+    big_set_u64(p, 1);
+    big_set_u64(q, n ? n : 1);
+}
+
+// ln 2 = 2 atanh(1/3) = 2/3 sum(1 / ((2n+1) 9^n))
+static void ln2_term(unsigned long n, BigInt *a, BigInt *b, BigInt *p, BigInt *q) {
+    big_set_u64(a, 1);
+    big_set_u64(b, 2 * (uint64_t)n + 1);
+    big_set_u64(p, 1);
+    big_set_u64(q, n ? 9 : 1);
+}
+
+static void series_sum(SeriesTerm term, unsigned long terms, BigInt *P, BigInt *Q, BigInt *B, BigInt *T) {
+    big_init(P); big_init(Q); big_init(B); big_init(T);
+    series_split(term, 0, terms, P, Q, B, T);
+}
+
+static void bf_ln_raw(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w);
+
+// Computes constant id to w bits (a few units in the last place).
+static void float_const_compute(FloatConsts *fc, FloatConst id, size_t w, BigFloat *r) {
+    BigInt P, Q, B, T;
+    BigFloat num, den;
+    bf_init(&num);
+    bf_init(&den);
+    if (id == FC_PI) {
+        // pi = 426880 sqrt(10005) Q / T
+        series_sum(pi_term, (unsigned long)(w / 47 + 2), &P, &Q, &B, &T);
+        BigInt c;
+        big_init(&c);
+        big_set_u64(&c, 10005);
+        bf_set_int(&num, &c);
+        bf_sqrt(&num, &num, w);
+        big_set_u64(&c, 426880);
+        big_mul(&c, &c, &Q);
+        bf_set_int(&den, &c);
+        bf_mul(&num, &num, &den, w);
+        bf_set_int(&den, &T);
+        bf_div(r, &num, &den, w);
+        big_free(&c);
+    } else if (id == FC_E) {
+        // enough terms that 1/n! is below 2^-w
+        unsigned long n = 1;
+        for (double bits = 0; bits < (double)w + 8; bits += log2((double)++n)) {}
+        series_sum(e_term, n, &P, &Q, &B, &T);
+        bf_set_int(&num, &T);
+        bf_set_int(&den, &Q);
+        bf_div(r, &num, &den, w);
+    } else if (id == FC_LN2) {
+        series_sum(ln2_term, (unsigned long)(w / 3 + 2), &P, &Q, &B, &T);
+        big_mul_add_small(&T, 2, 0);
+        big_mul(&Q, &Q, &B);
+        big_mul_add_small(&Q, 3, 0);
+        bf_set_int(&num, &T);
+        bf_set_int(&den, &Q);
+        bf_div(r, &num, &den, w);
+    } else {
+        BigInt ten;
+        big_init(&ten);
+        big_set_u64(&ten, 10);
+        bf_set_int(&num, &ten);
+        bf_ln_raw(fc, r, &num, w);
+        bf_round(r, w);
+        big_free(&ten);
+        bf_free(&num);
+        bf_free(&den);
+        return;
+    }
+    big_free(&P); big_free(&Q); big_free(&B); big_free(&T);
+    bf_free(&num);
+    bf_free(&den);
+}
+
+// r = constant id with a relative error below 2^-w, from the cache when it holds enough bits.
+void float_const(FloatConsts *fc, FloatConst id, size_t w, BigFloat *r) {
+    if (fc->prec[id] < w + 8) {
+        size_t cw = w + 64;
+        if (cw < fc->prec[id] * 3 / 2) cw = fc->prec[id] * 3 / 2; // grow geometrically
+        float_const_compute(fc, id, cw, &fc->value[id]);
+        fc->prec[id] = cw - 4;
+    }
+    bf_copy(r, &fc->value[id]);
+    bf_round(r, w + 2);
+}
+
+void float_consts_free(FloatConsts *fc) {
+    for (int i = 0; i < FC_COUNT; ++i) bf_free(&fc->value[i]);
+}
+
+// log2 of the size of Taylor-series doubling steps for w bits
+static size_t taylor_halvings(size_t w) { return (size_t)sqrt((double)w) / 2 + 1; }
+
+/*
+  exp(x) to a relative error below 2^-w, for |x| < 2^40: x = k ln 2 + r
+  with |r| <= ln 2 / 2, the Taylor series of r / 2^s in fixed point,
+  squared s times, times 2^k. Each step costs a unit in the last place,
+  and squaring doubles relative errors, so the fixed point carries s +
+  2 log2(w) + 16 guard bits.
+*/
+static void bf_exp_raw(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w) {
+    if (!x->m.n) { bf_set_pow2(r, 0); return; }
+    long tx = bf_top(x);
+    size_t wl = w + (size_t)(tx > 0 ? tx : 0) + 16;
+    BigFloat ln2, t;
+    BigInt k, R, sum, term;
+    bf_init(&ln2); bf_init(&t);
+    big_init(&k); big_init(&R); big_init(&sum); big_init(&term);
+    float_const(fc, FC_LN2, wl, &ln2);
+    bf_div(&t, x, &ln2, 64);
+    bf_to_int(&k, &t, 0);
+    bf_set_int(&t, &k);
+    bf_mul(&t, &t, &ln2, wl + 64);
+    bf_sub(&t, x, &t, wl);
+
+    size_t s = taylor_halvings(w);
+    long W = (long)(w + s + 2 * log2_size(w) + 16);
+    bf_to_fixed(&R, &t, W - (long)s);
+    big_set_u64(&sum, 1);
+    big_shl(&sum, &sum, (size_t)W);
+    big_copy(&term, &sum);
+    for (uint32_t n = 1; term.n; ++n) {
+        fixed_mul(&term, &term, &R, W);
+        big_div_small(&term, n);
+        big_add(&sum, &sum, &term);
+    }
+    for (size_t i = 0; i < s; ++i) fixed_mul(&sum, &sum, &sum, W);
+    big_move(&r->m, &sum);
+    r->e = (long)big_to_double(&k) - W;
+    bf_free(&ln2); bf_free(&t);
+    big_free(&k); big_free(&R); big_free(&term);
+}
+
+/*
+  ln(x) to a relative error below 2^-w, for x > 0, by the AGM: with
+  s = x 2^m > 2^(w'/2), ln s = pi / (2 AGM(1, 4/s)) to w' bits, and
+  ln x = ln s - m ln 2. Near x = 1 that subtraction cancels about as many
+  bits as |x - 1| has leading zeros, so they are added to w'.
+*/
+static void bf_ln_raw(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w) {
+    BigFloat one, a, b, t, pi;
+    bf_init(&one); bf_init(&a); bf_init(&b); bf_init(&t); bf_init(&pi);
+    bf_set_pow2(&one, 0);
+    bf_sub(&t, x, &one, 64);
+    if (!t.m.n) {
+        big_set_u64(&r->m, 0);
+        r->e = 0;
+    } else {
+        long cancel = bf_top(&t) < 0 ? -bf_top(&t) : 0;
+        size_t wp = w + (size_t)cancel + 2 * log2_size(w) + 16;
+        long m = (long)wp / 2 + 4 - bf_top(x);
+        bf_set_pow2(&t, 2 - m);
+        bf_div(&b, &t, x, wp);
+        bf_copy(&a, &one);
+        // once a and b agree to half the bits, their mean is the AGM to all of them
+        for (;;) {
+            bf_sub(&t, &a, &b, wp);
+            int last = !t.m.n || bf_top(&t) < bf_top(&a) - (long)wp / 2;
+            bf_mul(&t, &a, &b, wp);
+            bf_add(&a, &a, &b, wp);
+            a.e--;
+            if (last) break;
+            bf_sqrt(&b, &t, wp);
+        }
+        float_const(fc, FC_PI, wp, &pi);
+        a.e++;
+        bf_div(&a, &pi, &a, wp);
+        float_const(fc, FC_LN2, wp + 64, &t);
+        BigInt mb;
+        big_init(&mb);
+        big_set_u64(&mb, (uint64_t)(m < 0 ? -m : m));
+        mb.neg = m < 0;
+        bf_set_int(&b, &mb);
+        bf_mul(&b, &b, &t, wp + 64);
+        bf_sub(r, &a, &b, wp);
+        big_free(&mb);
+    }
+    bf_free(&one); bf_free(&a); bf_free(&b); bf_free(&t); bf_free(&pi);
+}
+
+/*
+  sin(x) and cos(x) to a relative error below 2^-w (either may be NULL).
+  x = k pi/2 + r with |r| <= pi/4, where pi has enough bits that r keeps
+  w of its own even when x is close to a multiple of pi/2; then the
+  Taylor series of r / 2^s in fixed point, doubled s times.
+*/
+static void bf_sin_cos_raw(FloatConsts *fc, BigFloat *sin_r, BigFloat *cos_r, const BigFloat *x, size_t w) {
+    BigFloat halfpi, t, red;
+    BigInt k, R, R2, S, C, term, u;
+    bf_init(&halfpi); bf_init(&t); bf_init(&red);
+    big_init(&k); big_init(&R); big_init(&R2); big_init(&S); big_init(&C); big_init(&term); big_init(&u);
+    long tx = bf_top(x);
+    size_t wr = w + (size_t)(tx > 0 ? tx : 0) + 32;
+    for (int tries = 0; ; ++tries) {
+        float_const(fc, FC_PI, wr, &halfpi);
+        halfpi.e--;
+        bf_div(&t, x, &halfpi, (size_t)(tx > 0 ? tx : 0) + 64);
+        bf_to_int(&k, &t, 0);
+        bf_set_int(&t, &k);
+        bf_mul(&t, &t, &halfpi, wr + (size_t)(tx > 0 ? tx : 0) + 64);
+        bf_sub(&red, x, &t, wr + (size_t)(tx > 0 ? tx : 0) + 64);
+        // the absolute error is about 2^(tx - wr); r needs w bits above it
+        long need = (long)w + 16 + (tx > 0 ? tx : 0) - (red.m.n ? bf_top(&red) : -(long)wr);
+        if ((long)wr >= need || tries == 8) break;
+        wr = (size_t)need + 32;
+    }
+    long tr = red.m.n ? bf_top(&red) : 0;
+    size_t s = taylor_halvings(w);
+    long W = (long)(w + 2 * s + 2 * log2_size(w) + 16) + (tr < 0 ? -tr : 0);
+    bf_to_fixed(&R, &red, W - (long)s);
+    fixed_mul(&R2, &R, &R, W);
+    big_copy(&S, &R);
+    big_copy(&term, &R);
+    for (uint32_t n = 1; term.n; ++n) {
+        fixed_mul(&term, &term, &R2, W);
+        big_div_small(&term, (2 * n) * (2 * n + 1));
+        term.neg = term.n && !term.neg;
+        big_add(&S, &S, &term);
+    }
+    big_set_u64(&C, 1);
+    big_shl(&C, &C, (size_t)W);
+    big_copy(&term, &C);
+    for (uint32_t n = 1; term.n; ++n) {
+        fixed_mul(&term, &term, &R2, W);
+        big_div_small(&term, (2 * n - 1) * (2 * n));
+        term.neg = term.n && !term.neg;
+        big_add(&C, &C, &term);
+    }
+    // sin 2a = 2 sin a cos a, cos 2a = 1 - 2 sin^2 a
+    for (size_t i = 0; i < s; ++i) {
+        fixed_mul(&u, &S, &S, W - 1);
+        fixed_mul(&S, &S, &C, W - 1);
+        big_set_u64(&C, 1);
+        big_shl(&C, &C, (size_t)W);
+        big_sub(&C, &C, &u);
+    }
+    // the quadrant, k mod 4, picks and signs the results
+    unsigned q = k.n ? k.d[0] & 3 : 0;
+    if (k.neg) q = (4 - q) & 3;
+    BigInt *sv = (q & 1) ? &C : &S, *cv = (q & 1) ? &S : &C;
+    if (sin_r) {
+        big_copy(&sin_r->m, sv);
+        if (q >= 2) sin_r->m.neg = sin_r->m.n && !sin_r->m.neg;
+        sin_r->e = -W;
+    }
+    if (cos_r) {
+        big_copy(&cos_r->m, cv);
+        if (q == 1 || q == 2) cos_r->m.neg = cos_r->m.n && !cos_r->m.neg;
+        cos_r->e = -W;
+    }
+    bf_free(&halfpi); bf_free(&t); bf_free(&red);
+    big_free(&k); big_free(&R); big_free(&R2); big_free(&S); big_free(&C); big_free(&term); big_free(&u);
+}
+
+static void bf_sin_raw(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w) { bf_sin_cos_raw(fc, r, NULL, x, w); }
+static void bf_cos_raw(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w) { bf_sin_cos_raw(fc, NULL, r, x, w); }
+
+/*
+  atan(x) to a relative error below 2^-w: atan(x) = pi/2 - atan(1/x) for
+  |x| > 1, then s halvings atan(x) = 2 atan(x / (1 + sqrt(1 + x^2))) and
+  the Taylor series in fixed point.
+*/
+static void bf_atan_raw(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w) {
+    BigFloat y, t, one;
+    BigInt X, X2, sum, term, p;
+    bf_init(&y); bf_init(&t); bf_init(&one);
+    big_init(&X); big_init(&X2); big_init(&sum); big_init(&term); big_init(&p);
+    size_t s = taylor_halvings(w);
+    long ty = bf_top(x) < 0 ? -bf_top(x) : 0;
+    size_t wp = w + 2 * s + 2 * log2_size(w) + 16;
+    bf_set_pow2(&one, 0);
+    // |x| > 1 unless it is below 2 and a power of two
+    int invert = bf_top(x) > 1 || (bf_top(x) == 1 && big_ctz(&x->m) + 1 != big_bits(&x->m));
+    if (invert) bf_div(&y, &one, x, wp);
+    else bf_copy(&y, x);
+    for (size_t i = 0; i < s; ++i) {
+        bf_mul(&t, &y, &y, wp);
+        bf_add(&t, &t, &one, wp);
+        bf_sqrt(&t, &t, wp);
+        bf_add(&t, &t, &one, wp);
+        bf_div(&y, &y, &t, wp);
+    }
+    long W = (long)wp + ty;
+    bf_to_fixed(&X, &y, W);
+    fixed_mul(&X2, &X, &X, W);
+    big_copy(&sum, &X);
+    big_copy(&p, &X);
+    for (uint32_t n = 1; p.n; ++n) {
+        fixed_mul(&p, &p, &X2, W);
+        p.neg = p.n && !p.neg;
+        big_copy(&term, &p);
+        big_div_small(&term, 2 * n + 1);
+        big_add(&sum, &sum, &term);
+    }
+    big_move(&t.m, &sum);
+    big_init(&sum);
+    t.e = (long)s - W;
+    if (invert) {
+        float_const(fc, FC_PI, wp, &y);
+        y.e--;
+        if (x->m.neg) y.m.neg = 1;
+        bf_sub(r, &y, &t, wp);
+    } else {
+        bf_copy(r, &t);
+    }
+    bf_free(&y); bf_free(&t); bf_free(&one);
+    big_free(&X); big_free(&X2); big_free(&sum); big_free(&term); big_free(&p);
+}
+
+typedef void (*FloatFn)(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t w);
+
+/*
+  Whether y, within a relative 2^-c of some value, rounds to prec bits
+  the same way that value does: the c - prec bits below the rounding
+  position must keep clear of the halfway point by more than the error.
+*/
+static int bf_can_round(const BigFloat *y, size_t c, size_t prec) {
+    if (!y->m.n) return 1;
+    size_t bits = big_bits(&y->m), d = c - prec;
+    BigInt u, hi;
+    big_init(&u);
+    big_init(&hi);
+    if (bits >= c) big_shr(&u, &y->m, bits - c);
+    else big_shl(&u, &y->m, c - bits);
+    u.neg = 0;
+    big_shr(&hi, &u, d);
+    big_shl(&hi, &hi, d);
+    big_sub(&u, &u, &hi);
+    big_set_u64(&hi, 1);
+    big_shl(&hi, &hi, d - 1);
+    big_sub(&u, &u, &hi);
+    int ok = big_bits(&u) > 2;
+    big_free(&u);
+    big_free(&hi);
+    return ok;
+}
+
+// r = f(x) correctly rounded to prec bits: Ziv's strategy over f's error bound.
+void bf_ziv(FloatConsts *fc, FloatFn f, BigFloat *r, const BigFloat *x, size_t prec) {
+    BigFloat t;
+    bf_init(&t);
+    for (size_t g = 32; ; g *= 2) {
+        f(fc, &t, x, prec + g);
+        // exact results (sqrt-like zeros and ones) pass at once; give up on
+        // an exact tie, which these transcendental functions never produce
+        if (bf_can_round(&t, prec + g - 1, prec) || g > 4 * prec + 4096) break;
+    }
+    bf_round(&t, prec);
+    bf_move(r, &t);
+}
+
+void bf_exp(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t prec) { bf_ziv(fc, bf_exp_raw, r, x, prec); }
+void bf_ln(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t prec) { bf_ziv(fc, bf_ln_raw, r, x, prec); }
+void bf_sin(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t prec) { bf_ziv(fc, bf_sin_raw, r, x, prec); }
+void bf_cos(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t prec) { bf_ziv(fc, bf_cos_raw, r, x, prec); }
+void bf_atan(FloatConsts *fc, BigFloat *r, const BigFloat *x, size_t prec) { bf_ziv(fc, bf_atan_raw, r, x, prec); }
+
+// r = constant id correctly rounded to prec bits
+void bf_const(FloatConsts *fc, FloatConst id, BigFloat *r, size_t prec) {
+    for (size_t g = 32; ; g *= 2) {
+        float_const(fc, id, prec + g, r);
+        if (bf_can_round(r, prec + g - 1, prec) || g > 4 * prec + 4096) break;
+    }
+    bf_round(r, prec);
+}
+
+/*
+  |x| * 10^k rounded to an integer, ties to even.
+*/
+static void bf_scale_decimal(BigInt *r, const BigFloat *x, long k) {
+    BigInt num, den, ten, rem;
+    big_init(&num); big_init(&den); big_init(&ten); big_init(&rem);
+    big_copy(&num, &x->m);
+    num.neg = 0;
+    big_set_u64(&den, 1);
+    big_set_u64(&ten, 10);
+    big_pow(&ten, &ten, (uint64_t)(k < 0 ? -k : k));
+    big_mul(k >= 0 ? &num : &den, k >= 0 ? &num : &den, &ten);
+    if (x->e >= 0) big_shl(&num, &num, (size_t)x->e);
+    else big_shl(&den, &den, (size_t)-x->e);
+    big_divmod(r, &rem, &num, &den);
+    big_shl(&rem, &rem, 1);
+    int c = mag_cmp(rem.d, rem.n, den.d, den.n);
+    if (c > 0 || (c == 0 && r->n && (r->d[0] & 1))) big_mul_add_small(r, 1, 1);
+    big_free(&num); big_free(&den); big_free(&ten); big_free(&rem);
+}
+
+/*
+  x rounded to digits significant decimal digits (ties to even), laid out
+  as %g would: a malloc'd string of *len characters.
+*/
+char *bf_to_decimal(const BigFloat *x, int digits, size_t *len) {
+    char *s = (char*)malloc((size_t)digits + 48);
+    if (!s) { perror("malloc"); exit(1); }
+    if (!x->m.n) {
+        strcpy(s, "0");
+        *len = 1;
+        return s;
+    }
+    // the decimal exponent, from an estimate that can be one off
+    long x10 = (long)floor((big_log2(&x->m) + (double)x->e) * log10(2.0));
+    BigInt D, lo, hi;
+    big_init(&D); big_init(&lo); big_init(&hi);
+    big_set_u64(&lo, 10);
+    big_pow(&lo, &lo, (uint64_t)(digits - 1));
+    big_copy(&hi, &lo);
+    big_mul_add_small(&hi, 10, 0);
+    for (int tries = 0; tries < 4; ++tries) {
+        bf_scale_decimal(&D, x, digits - 1 - x10);
+        if (mag_cmp(D.d, D.n, hi.d, hi.n) >= 0) x10++;
+        else if (mag_cmp(D.d, D.n, lo.d, lo.n) < 0) x10--;
+        else break;
+    }
+    size_t n;
+    char *d = big_to_decimal(&D, &n);
+    int k = (int)n;
+    while (k > 1 && d[k-1] == '0') k--;
+    *len = layout_g(s, x->m.neg, d, k, (int)x10, digits);
+    free(d);
+    big_free(&D); big_free(&lo); big_free(&hi);
+    return s;
+}
+
+/* ---------- Command history ---------- */
+
+typedef struct {
+    char **entries;
+    int size;
+    int capacity;
+} History;
+
+void history_init(History *h) {
+    h->capacity = HISTORY_SIZE;
+    h->size = 0;
+    h->entries = (char**)malloc(sizeof(char*) * h->capacity);
+    for (int i = 0; i < h->capacity; i++) h->entries[i] = NULL;
+}
+void history_add(History *h, const char *entry) {
+    free(h->entries[h->size % h->capacity]);
+    h->entries[h->size % h->capacity] = strdup(entry);
+    h->size++;
+}
+void history_print(const History *h) {
+    for (int i = 0; i < h->size && i < h->capacity; i++) {
+        int idx = (h->size + i) % h->capacity;
+        printf("%d: %s\n", i+1, h->entries[idx]);
+    }
+}
+void history_free(History *h) {
+    for (int i = 0; i < h->capacity; i++) {
+        free(h->entries[i]);
+        h->entries[i] = NULL;
+    }
+    free(h->entries);
+    h->entries = NULL;
+    h->size = h->capacity = 0;
+}
+
+/* ---------- Calculator context ---------- */
+
+/*
+  Where a session's time goes, kept only while profiling (at the prompt,
+  or with --profile). Every stage a line passes through is timed into a
+  log-linear histogram: exact below 16 ns, then 8 buckets per power of
+  two, so percentiles are within about 6%. Worker contexts are merged into the
+  session's when they finish, counters included.
+*/
+
+typedef enum { STAGE_LOOKUP, STAGE_TOKENIZE, STAGE_RPN, STAGE_COMPILE, STAGE_EVALUATE, STAGE_FORMAT, STAGE_COUNT } Stage;
+
+#define PROFILE_SUB_BITS 3
+#define PROFILE_BUCKETS ((65 - PROFILE_SUB_BITS) << PROFILE_SUB_BITS)
+
+typedef struct {
+    unsigned long count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    unsigned long buckets[PROFILE_BUCKETS];
+} StageProfile;
+
+typedef struct {
+    StageProfile stage[STAGE_COUNT];
+    // counters of merged worker contexts
+    unsigned long expressions, cache_hits, cache_misses, heap_allocs;
+} Profile;
+
+static int profile_bucket(uint64_t ns) {
+    if (ns < (2u << PROFILE_SUB_BITS)) return (int)ns;
+    int e = 63 - __builtin_clzll(ns);
+    return ((e - PROFILE_SUB_BITS + 1) << PROFILE_SUB_BITS) + (int)((ns >> (e - PROFILE_SUB_BITS)) & ((1u << PROFILE_SUB_BITS) - 1));
+}
+
+// The middle of a bucket's range.
+static double profile_bucket_ns(int b) {
+    if (b < (2 << PROFILE_SUB_BITS)) return b;
+    int e = (b >> PROFILE_SUB_BITS) + PROFILE_SUB_BITS - 1;
+    double width = ldexp(1.0, e - PROFILE_SUB_BITS);
+    return ldexp((double)((1 << PROFILE_SUB_BITS) + (b & ((1 << PROFILE_SUB_BITS) - 1))), e - PROFILE_SUB_BITS) + width / 2;
+}
+
+// Latency below which a fraction q of the stage's samples fall.
+double profile_percentile(const StageProfile *s, double q) {
+    if (!s->count) return 0.0;
+    unsigned long rank = (unsigned long)ceil(q * (double)s->count), seen = 0;
+    if (rank < 1) rank = 1;
+    for (int b = 0; b < PROFILE_BUCKETS; ++b) {
+        seen += s->buckets[b];
+        if (seen >= rank) {
+            double ns = profile_bucket_ns(b);
+            return ns < (double)s->max_ns ? ns : (double)s->max_ns;
+        }
+    }
+    return (double)s->max_ns;
+}
+
+static void profile_record(StageProfile *s, uint64_t ns) {
+    s->count++;
+    s->total_ns += ns;
+    if (ns > s->max_ns) s->max_ns = ns;
+    s->buckets[profile_bucket(ns)]++;
+}
+
+/*
+  Per-session state handed to every pipeline stage. Everything a line can
+  read or change lives here, so separate contexts can be used from
+  separate threads at once; one context is never used by two threads at
+  a time. The process-wide settings (--cache, --jit) are only read.
+*/
+typedef struct {
+    Arena arena;               // scratch for the expression in flight
+    ProgramCache programs;     // compiled lines, see compile_line
+    AngleMode angle_mode;      // mode rad / mode deg
+    NumberMode numbers;        // mode float / mode exact / digits N
+    int digits;                // N of digits N
+    FloatConsts *floats;       // constants digits mode has computed, or NULL
+    double memory;             // m+, m-, mc; M in expressions
+    VarTable vars;             // user variables, see Variables
+    History history;           // lines entered at the prompt
+    NumberFormat format;       // how results are printed
+    unsigned long expressions; // expressions started with calc_begin
+    Profile *profile;          // stage timings, or NULL when not profiling
+    char error[CALC_ERROR_LEN]; // why the last stage failed
+} CalcContext;
+
+void calc_init(CalcContext *ctx) {
+    arena_init(&ctx->arena, ARENA_INIT_SIZE);
+    program_cache_init(&ctx->programs, program_cache_capacity);
+    ctx->angle_mode = MODE_RAD;
+    ctx->numbers = NUMBERS_FLOAT;
+    ctx->digits = 0;
+    ctx->floats = NULL;
+    ctx->memory = 0.0;
+    memset(&ctx->vars, 0, sizeof(ctx->vars));
+    history_init(&ctx->history);
+    ctx->format.mode = FMT_DIGITS;
+    ctx->format.digits = 10;
+    ctx->expressions = 0;
+    ctx->profile = NULL;
+    ctx->error[0] = '\0';
+}
+
+// Starts timing the stages of ctx's lines (see Profile).
+void calc_profile(CalcContext *ctx) {
+    if (ctx->profile) return;
+    ctx->profile = (Profile*)calloc(1, sizeof(Profile));
+    if (!ctx->profile) { perror("calloc"); exit(1); }
+}
+
+/*
+  Sets up ctx with the session state of from (angle and number modes,
+  memory, variables and format), for a worker that continues from's session.
+  History, caches and counters start empty; the copy is profiled if from
+  is.
+*/
+void calc_init_copy(CalcContext *ctx, const CalcContext *from) {
+    calc_init(ctx);
+    ctx->angle_mode = from->angle_mode;
+    ctx->numbers = from->numbers;
+    ctx->digits = from->digits;
+    ctx->memory = from->memory;
+    var_copy(&ctx->vars, &from->vars);
+    ctx->format = from->format;
+    if (from->profile) calc_profile(ctx);
+}
+
+// Starts a new expression, releasing the previous one's scratch memory.
+void calc_begin(CalcContext *ctx) {
+    arena_reset(&ctx->arena);
+    ctx->expressions++;
+    ctx->error[0] = '\0';
+}
+
+// Records why a stage failed; front ends decide where the message goes.
+void calc_error(CalcContext *ctx, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(ctx->error, sizeof(ctx->error), fmt, ap);
+    va_end(ap);
+}
+
+void calc_free(CalcContext *ctx) {
+    arena_free(&ctx->arena);
+    program_cache_free(&ctx->programs);
+    var_free(&ctx->vars);
+    history_free(&ctx->history);
+    free(ctx->profile);
+    if (ctx->floats) float_consts_free(ctx->floats);
+    free(ctx->floats);
+}
+
+// Adds what a finished worker context did to ctx's profile.
+void calc_profile_merge(CalcContext *ctx, const CalcContext *worker) {
+    Profile *p = ctx->profile;
+    const Profile *w = worker->profile;
+    if (!p || !w) return;
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        StageProfile *to = &p->stage[s];
+        const StageProfile *from = &w->stage[s];
+        to->count += from->count;
+        to->total_ns += from->total_ns;
+        if (from->max_ns > to->max_ns) to->max_ns = from->max_ns;
+        for (int b = 0; b < PROFILE_BUCKETS; ++b) to->buckets[b] += from->buckets[b];
+    }
+    p->expressions += worker->expressions + w->expressions;
+    p->cache_hits += worker->programs.hits + w->cache_hits;
+    p->cache_misses += worker->programs.misses + w->cache_misses;
+    p->heap_allocs += worker->arena.heap_allocs + worker->programs.heap_allocs + w->heap_allocs;
+}
+
+// The clock reading a stage starts from, when profiling.
+static uint64_t profile_start(const CalcContext *ctx) {
+    return ctx->profile ? now_ns() : 0;
+}
+
+// Charges the time since *since to stage, and starts the next stage.
+static void profile_lap(CalcContext *ctx, Stage stage, uint64_t *since) {
+    if (!ctx->profile) return;
+    uint64_t now = now_ns();
+    profile_record(&ctx->profile->stage[stage], now - *since);
+    *since = now;
+}
+
+/* ---------- Token arrays ---------- */
+
+typedef struct {
+    Token *data;
+    int size;
+    int capacity;
+    const char *src; // line the token spans point into
+    Arena *arena;
+} TokenArray;
+
+void token_array_init(TokenArray *arr, CalcContext *ctx, int capacity) {
+    arr->arena = &ctx->arena;
+    arr->capacity = capacity > 0 ? capacity : 1;
+    arr->size = 0;
+    arr->src = NULL;
+    arr->data = (Token*)arena_alloc(arr->arena, sizeof(Token) * arr->capacity);
+}
+void token_array_push(TokenArray *arr, Token t) {
+    if (arr->size >= arr->capacity) {
+        Token *grown = (Token*)arena_alloc(arr->arena, sizeof(Token) * arr->capacity * 2);
+        memcpy(grown, arr->data, sizeof(Token) * arr->size);
+        arr->data = grown;
+        arr->capacity *= 2;
+    }
+    arr->data[arr->size++] = t;
+}
+
+/* ---------- Tokenizer ---------- */
+
+static void push_span_token(TokenArray *arr, TokenType type, size_t offset, size_t len) {
+    Token t;
+    t.type = (unsigned char)type;
+    t.op = 0;
+    t.len = (unsigned short)(len > USHRT_MAX ? USHRT_MAX : len);
+    t.offset = (unsigned int)offset;
+    t.u.value = 0.0;
+    token_array_push(arr, t);
+}
+
+void push_number_token(TokenArray *arr, size_t offset, size_t len, double value) {
+    push_span_token(arr, TOKEN_NUMBER, offset, len);
+    arr->data[arr->size-1].u.value = value;
+}
+
+void push_operator_token(TokenArray *arr, size_t offset) {
+    push_span_token(arr, TOKEN_OPERATOR, offset, 1);
+    arr->data[arr->size-1].op = arr->src[offset];
+}
+
+// call is set when the name is followed by '('; vars resolves variables.
+void push_name_token(TokenArray *arr, const VarTable *vars, size_t offset, size_t len, int call) {
+    Symbol sym = registry_lookup(arr->src + offset, len);
+    if (sym.kind == SYM_NONE && !call) {
+        // a variable slot, or -1 for compile_rpn to reject
+        push_span_token(arr, TOKEN_IDENTIFIER, offset, len);
+        arr->data[arr->size-1].u.id = var_lookup(vars, arr->src + offset, len);
+        return;
+    }
+    // unknown calls are kept as functions and rejected by compile_rpn
+    push_span_token(arr, sym.kind == SYM_CONSTANT ? TOKEN_CONSTANT : TOKEN_FUNCTION, offset, len);
+    arr->data[arr->size-1].u.id = sym.id;
+}
+
+int tokenize_expression(CalcContext *ctx, const char *expr, TokenArray *out) {
+    size_t len = strlen(expr);
+    size_t i = 0;
+    out->src = expr;
+    while (i < len) {
+        char c = expr[i];
+        if (isspace((unsigned char)c)) { i++; continue; }
+        if (isdigit((unsigned char)c) || (c == '.' && i+1 < len && isdigit((unsigned char)expr[i+1]))) {
+            double value;
+            size_t n = scan_number(expr + i, len - i, &value);
+            push_number_token(out, i, n, value);
+            i += n;
+            continue;
+        }
+        if (is_operator_char(c)) {
+            push_operator_token(out, i);
+            i++;
+            continue;
+        }
+        if (c == '(') { push_span_token(out, TOKEN_PAREN_LEFT, i, 1); i++; continue; }
+        if (c == ')') { push_span_token(out, TOKEN_PAREN_RIGHT, i, 1); i++; continue; }
+        if (c == ',') { push_span_token(out, TOKEN_COMMA, i, 1); i++; continue; }
+        if (is_identifier_char(c)) {
+            size_t j = i;
+            while (j < len && (is_identifier_char(expr[j]) || isdigit((unsigned char)expr[j]) || expr[j]=='.')) j++;
+            size_t k = j;
+            while (k < len && isspace((unsigned char)expr[k])) k++;
+            push_name_token(out, &ctx->vars, i, j - i, k < len && expr[k] == '(');
+            i = j;
+            continue;
+        }
+        // Unknown character
+        calc_error(ctx, "Tokenizer error: unexpected character '%c'", c);
+        return 0;
+    }
+    return 1;
+}
+
+/* ---------- Shunting-yard (infix -> RPN) ---------- */
+
+typedef struct {
+    Token *data;
+    int size;
+    int capacity;
+    Arena *arena;
+} TokenStack;
+
+void tokenstack_init(TokenStack *s, CalcContext *ctx, int capacity) {
+    s->arena = &ctx->arena;
+    s->capacity = capacity > 0 ? capacity : 1;
+    s->size = 0;
+    s->data = (Token*)arena_alloc(s->arena, sizeof(Token) * s->capacity);
+}
+void tokenstack_push(TokenStack *s, Token t) {
+    if (s->size >= s->capacity) {
+        Token *grown = (Token*)arena_alloc(s->arena, sizeof(Token) * s->capacity * 2);
+        memcpy(grown, s->data, sizeof(Token) * s->size);
+        s->data = grown;
+        s->capacity *= 2;
+    }
+    s->data[s->size++] = t;
+}
+Token tokenstack_pop(TokenStack *s) {
+    if (s->size == 0) { Token t; memset(&t, 0, sizeof(t)); t.type = TOKEN_NUMBER; return t; }
+    return s->data[--s->size];
+}
+Token tokenstack_peek(TokenStack *s) {
+    if (s->size == 0) { Token t; memset(&t, 0, sizeof(t)); t.type = TOKEN_NUMBER; return t; }
+    return s->data[s->size-1];
+}
+int tokenstack_empty(TokenStack *s) { return s->size == 0; }
+
+int is_unary_operator(const TokenArray *tokens, int idx) {
+    // unary + or - when at start or after left paren, operator, or comma
+    if (tokens->data[idx].type != TOKEN_OPERATOR) return 0;
+    char op = tokens->data[idx].op;
+    if (!(op == '+' || op == '-')) return 0;
+    if (idx == 0) return 1;
+    TokenType prev = (TokenType)tokens->data[idx-1].type;
+    if (prev == TOKEN_OPERATOR || prev == TOKEN_PAREN_LEFT || prev == TOKEN_COMMA || prev == TOKEN_FUNCTION) return 1;
+    return 0;
+}
+
+int to_rpn(CalcContext *ctx, const TokenArray *in, TokenArray *out) {
+    TokenStack opstack;
+    tokenstack_init(&opstack, ctx, in->size);
+    out->src = in->src;
+
+    for (int i = 0; i < in->size; ++i) {
+        Token t = in->data[i];
+        if (t.type == TOKEN_NUMBER || t.type == TOKEN_CONSTANT || t.type == TOKEN_IDENTIFIER) {
+            token_array_push(out, t);
+        } else if (t.type == TOKEN_FUNCTION) {
+            tokenstack_push(&opstack, t);
+        } else if (t.type == TOKEN_COMMA) {
+            // pop until left paren encountered
+            int found = 0;
+            while (!tokenstack_empty(&opstack)) {
+                Token top = tokenstack_peek(&opstack);
+                if (top.type == TOKEN_PAREN_LEFT) { found = 1; break; }
+                token_array_push(out, tokenstack_pop(&opstack));
+            }
+            if (!found) { calc_error(ctx, "Error: misplaced comma or mismatched parentheses"); return 0; }
+        } else if (t.type == TOKEN_OPERATOR) {
+            // handle unary + and -
+            int unary = is_unary_operator(in, i);
+            if (unary) {
+                // unary + and - bind like functions
+                t.type = TOKEN_UNARY;
+                tokenstack_push(&opstack, t);
+                continue;
+            }
+            char op = t.op;
+            while (!tokenstack_empty(&opstack)) {
+                Token top = tokenstack_peek(&opstack);
+                if (top.type == TOKEN_OPERATOR) {
+                    char topop = top.op;
+                    int p1 = op_precedence(topop);
+                    int p2 = op_precedence(op);
+                    if ((op_right_associative(op) && p2 < p1) || (!op_right_associative(op) && p2 <= p1)) {
+                        token_array_push(out, tokenstack_pop(&opstack));
+                        continue;
+                    }
+                } else if (top.type == TOKEN_FUNCTION || top.type == TOKEN_UNARY) {
+                    // functions have higher precedence -> pop them
+                    token_array_push(out, tokenstack_pop(&opstack));
+                    continue;
+                }
+                break;
+            }
+            tokenstack_push(&opstack, t);
+        } else if (t.type == TOKEN_PAREN_LEFT) {
+            tokenstack_push(&opstack, t);
+        } else if (t.type == TOKEN_PAREN_RIGHT) {
+            int found_left = 0;
+            while (!tokenstack_empty(&opstack)) {
+                Token top = tokenstack_pop(&opstack);
+                if (top.type == TOKEN_PAREN_LEFT) { found_left = 1; break; }
+                token_array_push(out, top);
+            }
+            if (!found_left) { calc_error(ctx, "Error: mismatched parentheses"); return 0; }
+            // after popping left paren, if top of stack is function, pop it into output
+            if (!tokenstack_empty(&opstack)) {
+                Token top = tokenstack_peek(&opstack);
+                if (top.type == TOKEN_FUNCTION || top.type == TOKEN_UNARY) token_array_push(out, tokenstack_pop(&opstack));
+            }
+        } else {
+            calc_error(ctx, "Unknown token in parsing: %.*s", (int)t.len, in->src + t.offset);
+            return 0;
+        }
+    }
+
+    while (!tokenstack_empty(&opstack)) {
+        Token top = tokenstack_pop(&opstack);
+        if (top.type == TOKEN_PAREN_LEFT || top.type == TOKEN_PAREN_RIGHT) {
+            calc_error(ctx, "Error: mismatched parentheses");
+            return 0;
+        }
+        token_array_push(out, top);
+    }
+
+    return 1;
+}
+
+/* ---------- Bytecode compilation ---------- */
+
+/*
+  The RPN token stream is compiled once into a flat program: numbers and
+  the pi/e constants become immediates, functions are resolved to FuncId,
+  variables to slots, and the required stack depth is computed up front.
+  Running a program never looks at a name again.
+*/
+
+typedef enum {
+    OP_PUSH,      // push value
+    OP_LOAD_MEM,  // push the memory
+    OP_LOAD_VAR,  // push the variable in slot func
+    OP_STORE_VAR, // copy the top of the stack into slot func
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_POW,
+    OP_POWI,      // raise to the power func (2..POWI_MAX) by multiplying
+    OP_NEG,
+    OP_CALL       // call func (FuncId), pops func_info[func].arity values
+} OpCode;
+
+typedef struct {
+    OpCode op;
+    int func;
+    double value;
+} Instr;
+
+/*
+  A program translated to machine code: returns 0 with the value in
+  *result, or the index + 1 of the instruction that failed.
+*/
+typedef int (*JitFn)(const CalcContext *ctx, double *result);
+
+typedef struct {
+    Instr *code;
+    int size;
+    int capacity;
+    int max_depth; // deepest stack the program reaches
+    int integer;   // every value is an integer (see Integer evaluation)
+    JitFn jit;     // run instead of code when set (see JIT compiler)
+    Arena *arena;
+} Program;
+
+void program_init(Program *p, CalcContext *ctx, int capacity) {
+    p->arena = &ctx->arena;
+    p->capacity = capacity > 0 ? capacity : 1;
+    p->size = 0;
+    p->max_depth = 0;
+    p->integer = 0;
+    p->jit = NULL;
+    p->code = (Instr*)arena_alloc(p->arena, sizeof(Instr) * p->capacity);
+}
+void program_emit(Program *p, OpCode op, int func, double value) {
+    if (p->size >= p->capacity) {
+        Instr *grown = (Instr*)arena_alloc(p->arena, sizeof(Instr) * p->capacity * 2);
+        memcpy(grown, p->code, sizeof(Instr) * p->size);
+        p->code = grown;
+        p->capacity *= 2;
+    }
+    Instr *in = &p->code[p->size++];
+    in->op = op;
+    in->func = func;
+    in->value = value;
+}
+
+static int operator_opcode(char op, OpCode *out) {
+    switch (op) {
+        case '+': *out = OP_ADD; return 1;
+        case '-': *out = OP_SUB; return 1;
+        case '*': *out = OP_MUL; return 1;
+        case '/': *out = OP_DIV; return 1;
+        case '%': *out = OP_MOD; return 1;
+        case '^': *out = OP_POW; return 1;
+        default: return 0;
+    }
+}
+
+/*
+  Also infers whether every value is an integer (Program.integer): numbers
+  have to be exact integers and functions map integers to integers, while
+  variables and the memory are checked when the program runs. Fractions
+  otherwise only come from / and negative powers, which the integer run
+  refuses.
+*/
+int compile_rpn(CalcContext *ctx, const TokenArray *rpn, Program *out) {
+    int depth = 0, integer = 1;
+    for (int i = 0; i < rpn->size; ++i) {
+        const Token *t = &rpn->data[i];
+        const char *text = rpn->src + t->offset;
+        int pops = 0;
+        if (t->type == TOKEN_NUMBER) {
+            double x = t->u.value; // never -0
+            integer &= fabs(x) <= (double)EXACT_INT_MAX && x == (double)(int64_t)x;
+            program_emit(out, OP_PUSH, 0, t->u.value);
+        } else if (t->type == TOKEN_CONSTANT) {
+            if (t->u.id == CONST_MEM) program_emit(out, OP_LOAD_MEM, 0, 0.0);
+            else program_emit(out, OP_PUSH, 0, const_info[t->u.id].value);
+            integer &= t->u.id == CONST_MEM;
+        } else if (t->type == TOKEN_IDENTIFIER) {
+            if (t->u.id < 0) {
+                calc_error(ctx, "Unknown variable: %.*s", (int)t->len, text);
+                return 0;
+            }
+            program_emit(out, OP_LOAD_VAR, t->u.id, 0.0);
+        } else if (t->type == TOKEN_OPERATOR) {
+            OpCode op;
+            if (!operator_opcode(t->op, &op)) {
+                calc_error(ctx, "Unknown operator: %c", t->op);
+                return 0;
+            }
+            pops = 2;
+            program_emit(out, op, 0, 0.0);
+        } else if (t->type == TOKEN_UNARY) {
+            pops = 1;
+            if (t->op == '-') program_emit(out, OP_NEG, 0, 0.0); // unary plus emits nothing
+        } else if (t->type == TOKEN_FUNCTION) {
+            if (t->u.id < 0) {
+                calc_error(ctx, "Unknown function: %.*s", (int)t->len, text);
+                return 0;
+            }
+            pops = func_info[t->u.id].arity;
+            integer &= func_info[t->u.id].integer;
+            program_emit(out, OP_CALL, t->u.id, 0.0);
+        } else {
+            calc_error(ctx, "Unexpected token in RPN evaluation: %.*s", (int)t->len, text);
+            return 0;
+        }
+        if (depth < pops) {
+            calc_error(ctx, "Evaluation error: missing operand for '%.*s'", (int)t->len, text);
+            return 0;
+        }
+        depth -= pops;
+        depth++;
+        if (depth > out->max_depth) out->max_depth = depth;
+    }
+
+    if (depth != 1) {
+        calc_error(ctx, "Evaluation error: stack has %d elements after evaluation", depth);
+        return 0;
+    }
+    out->integer = integer;
+    return 1;
+}
+
+/* ---------- Integer evaluation ---------- */
+
+/*
+  Most lines are integer arithmetic, and doubles stop being exact at 2^53.
+  A program whose every value is an integer is marked when it is compiled
+  (compile_rpn) and is run on int64_t first: +, -, *, %, powers and
+  abs, floor, ceil, fact, nCr, nPr, gcd and lcm, with overflow checked on
+  every step. / stays integer when it divides evenly. Anything the integer
+  run cannot finish exactly (an overflow, a fraction, a negative power, a
+  variable that is not an integer, -0, an error) sends the line back to
+  the double program, which gives the same result as ever. A line that
+  finishes is exact and prints in full.
+*/
+
+static int int_pow(int64_t a, int64_t e, int64_t *out) {
+    int64_t r = 1;
+    if (e < 0) return 0;
+    for (;;) {
+        if ((e & 1) && __builtin_mul_overflow(r, a, &r)) return 0;
+        e >>= 1;
+        if (!e) break;
+        // a^2 is a factor of what is left, so its overflow is the result's
+        if (__builtin_mul_overflow(a, a, &a)) return 0;
+    }
+    *out = r;
+    return 1;
+}
+
+/*
+  in applied to integers, the unary ones reading args[0] only. Returns 1
+  with the exact result in *out, which may alias args, or 0 where the
+  double program has to decide: the result does not fit, is not an
+  integer or is -0, or the operation fails.
+*/
+static int int_op(const Instr *in, const int64_t *args, int64_t *out) {
+    int64_t a = args[0], b, q, r;
+    switch (in->op) {
+    case OP_NEG:
+        if (a == 0 || a == INT64_MIN) return 0; // -0, or too large
+        *out = -a;
+        return 1;
+    case OP_POWI: return int_pow(a, in->func, out);
+    case OP_CALL: break;
+    default:
+        b = args[1];
+        switch (in->op) {
+        case OP_ADD: return !__builtin_add_overflow(a, b, out);
+        case OP_SUB: return !__builtin_sub_overflow(a, b, out);
+        case OP_MUL:
+            if (__builtin_mul_overflow(a, b, &r) || (r == 0 && (a < 0 || b < 0))) return 0;
+            *out = r;
+            return 1;
+        case OP_DIV:
+        case OP_MOD:
+            if (b == 0 || a == INT64_MIN) return 0; // fails, or traps at -1
+            // 32-bit division is several times faster where it will do
+            if (b > 0 && b <= INT32_MAX && a == (int32_t)a) {
+                q = (int32_t)a / (int32_t)b;
+                r = (int32_t)a % (int32_t)b;
+            } else {
+                q = a / b;
+                r = a % b;
+            }
+            if (in->op == OP_MOD) {
+                *out = r; // the sign of a, as fmod's
+                return r != 0 || a >= 0;
+            }
+            *out = q;
+            return r == 0 && (q != 0 || b > 0); // a fraction, or 0/-b = -0
+        case OP_POW: return int_pow(a, b, out);
+        default: return 0;
+        }
+    }
+
+    switch (in->func) {
+    case FN_ABS: if (a == INT64_MIN) return 0; *out = a < 0 ? -a : a; return 1;
+    case FN_FLOOR: case FN_CEIL: *out = a; return 1;
+    case FN_FACT:
+        if (a < 0 || a > 20) return 0; // 21! overflows
+        *out = (int64_t)ldexp(fact_table[a].mant.hi, fact_table[a].exp); // exact this far
+        return 1;
+    case FN_NPR:
+        b = args[1];
+        if (b < 0 || b > a) return 0;
+        r = 1;
+        // past the first few factors of 2 or more the product overflows
+        for (int64_t i = 0; i < b; ++i)
+            if (__builtin_mul_overflow(r, a - i, &r)) return 0;
+        *out = r;
+        return 1;
+    case FN_NCR:
+        b = args[1];
+        if (b < 0 || b > a) return 0;
+        if (b > a - b) b = a - b;
+        r = 1;
+        // r = C(a-b+i, i): dividing out the gcd first keeps each step exact
+        for (int64_t i = 1; i <= b; ++i) {
+            int64_t g = (int64_t)gcd_u64((uint64_t)r, (uint64_t)i);
+            if (__builtin_mul_overflow(r / g, (a - b + i) / (i / g), &r)) return 0;
+        }
+        *out = r;
+        return 1;
+    case FN_GCD: case FN_LCM: {
+        uint64_t g = (uint64_t)ll_gcd(a, args[1]);
+        if (g > (uint64_t)INT64_MAX) return 0;
+        if (in->func == FN_GCD) { *out = (int64_t)g; return 1; }
+        if (!g) { *out = 0; return 1; }
+        if (__builtin_mul_overflow(a / (int64_t)g, args[1], &r) || r == INT64_MIN) return 0;
+        *out = r < 0 ? -r : r;
+        return 1;
+    }
+    case FN_POW: return int_pow(a, args[1], out);
+    default: return 0;
+    }
+}
+
+/*
+  Runs an integer program with room for prog->max_depth values at stack.
+  Returns 1 with the exact value in *result, or 0 if it has to be run on
+  doubles instead; stores are only made once the value is known.
+*/
+int program_exec_int(CalcContext *ctx, const Program *prog, int64_t *stack, int64_t *result) {
+    int64_t *sp = stack;
+    for (const Instr *in = prog->code, *end = in + prog->size; in < end; ++in) {
+        switch (in->op) {
+        case OP_PUSH: *sp++ = (int64_t)in->value; break;
+        case OP_LOAD_MEM: if (!int_from_double(ctx->memory, sp++)) return 0; break;
+        case OP_LOAD_VAR: if (!int_from_double(ctx->vars.values[in->func], sp++)) return 0; break;
+        case OP_ADD: sp--; if (__builtin_add_overflow(sp[-1], sp[0], &sp[-1])) return 0; break;
+        case OP_SUB: sp--; if (__builtin_sub_overflow(sp[-1], sp[0], &sp[-1])) return 0; break;
+        case OP_STORE_VAR:
+            // always last (see compile_assignment)
+            ctx->vars.values[in->func] = (double)sp[-1];
+            ctx->vars.defined[in->func] = 1;
+            break;
+        case OP_NEG:
+        case OP_POWI:
+            if (!int_op(in, sp - 1, sp - 1)) return 0;
+            break;
+        case OP_CALL:
+            sp -= func_info[in->func].arity;
+            if (!int_op(in, sp, sp)) return 0;
+            sp++;
+            break;
+        default:
+            sp--;
+            if (!int_op(in, sp - 1, sp - 1)) return 0;
+            break;
+        }
+    }
+    *result = stack[0];
+    return 1;
+}
+
+/* ---------- Program optimizer ---------- */
+
+/*
+  Rewrites a compiled program before it runs or is cached:
+
+    - operations whose operands are all constants are folded, pi and e
+      included (trigonometric calls are left alone since they read the
+      angle mode, and so is anything that would fail, so the error still
+      happens at run time);
+    - x*1, 1*x, x/1, x-0, x+(-0), x^1 become x; x*-1 and x/-1 become -x;
+      --x becomes x; x^0 and 1^x become 1 when the dropped operand cannot
+      fail;
+    - x^2, x^3 and x^4 (or pow) become OP_POWI, a multiplication chain;
+    - x/c becomes x*(1/c) when c is a power of two, where both are exact,
+      except in an integer program.
+
+  An integer program (see Integer evaluation) is folded with int_op, and
+  only where the result is exact as a double; a larger one is left for
+  the integer run. A constant fraction makes it a double program again.
+
+  Every rewrite gives the same double as the original, except that
+  OP_POWI and pow() each round correctly but for rare cases, which need
+  not be the same ones. x+0 is kept: it turns -0 into +0.
+*/
+
+#define POWI_MAX 4
+
+/*
+  x^n for 2 <= n <= POWI_MAX by multiplication. x*x is carried as a
+  double-double, so the result is rounded about as well as pow()'s
+  (to within an ulp where it is subnormal).
+*/
+VM_INLINE double powi_small(double x, int n) {
+    double lo, hi = vm_two_prod(x, x, &lo);
+    double e, p = vm_two_prod(hi, n == 3 ? x : hi, &e);
+    double r = p + (n == 3 ? e + lo * x : e + 2.0 * hi * lo);
+    r = p - p == 0.0 && p != 0.0 ? r : p; // keeps -0, and inf where the error terms are NaN
+    return n == 2 ? hi : r;
+}
+
+typedef struct {
+    int start;    // first instruction of the operand's code
+    int constant; // code is a single OP_PUSH
+    int safe;     // code cannot fail at run time
+    double value; // when constant
+} OptOperand;
+
+static int op_can_fail(const Instr *in) {
+    return in->op == OP_DIV || in->op == OP_MOD || in->op == OP_CALL;
+}
+
+// Folds op over constant operands the way run_program would; 0 if it fails.
+static int fold_op(const Instr *in, const double *args, double *out) {
+    switch (in->op) {
+    case OP_ADD: *out = args[0] + args[1]; return 1;
+    case OP_SUB: *out = args[0] - args[1]; return 1;
+    case OP_MUL: *out = args[0] * args[1]; return 1;
+    case OP_DIV: if (args[1] == 0.0) return 0; *out = args[0] / args[1]; return 1;
+    case OP_MOD: if (args[1] == 0.0) return 0; *out = fmod(args[0], args[1]); return 1;
+    case OP_POW: *out = pow(args[0], args[1]); return 1;
+    case OP_POWI: *out = powi_small(args[0], in->func); return 1;
+    case OP_NEG: *out = -args[0]; return 1;
+    case OP_CALL: {
+        if (func_info[in->func].angle != ANGLE_NONE) return 0; // the mode is only known at run time
+        double a[2] = { args[0], args[1] };
+        if (!func_info[in->func].kernel(a, a)) return 0;
+        *out = a[0];
+        return 1;
+    }
+    default: return 0;
+    }
+}
+
+// c = +-2^k with both c and 1/c normal, so x/c == x*(1/c) for every x.
+static int is_power_of_two(double c) {
+    int e;
+    double m = frexp(c, &e);
+    return (m == 0.5 || m == -0.5) && e - 1 >= -1022 && e - 1 <= 1022;
+}
+
+// Deletes code[from, to) and shifts the rest down.
+static void opt_cut(Program *p, int from, int to) {
+    memmove(p->code + from, p->code + to, sizeof(Instr) * (size_t)(p->size - to));
+    p->size -= to - from;
+}
+
+static void opt_emit(Program *p, OpCode op, int func, double value) {
+    Instr *in = &p->code[p->size++];
+    in->op = op;
+    in->func = func;
+    in->value = value;
+}
+
+/*
+  Rewrites prog in place: each instruction is re-emitted behind a write
+  cursor that never passes the read cursor, while a stack of OptOperand
+  records which code produced each value. Recomputes max_depth.
+*/
+void optimize_program(Program *prog) {
+    int n = prog->size;
+    Instr *src = prog->code;
+    OptOperand stack[64];
+    OptOperand *heap = NULL;
+    OptOperand *st = stack;
+    if (prog->max_depth > 64) {
+        heap = (OptOperand*)malloc(sizeof(OptOperand) * (size_t)prog->max_depth);
+        if (!heap) { perror("malloc"); exit(1); }
+        st = heap;
+    }
+    int sp = 0;
+    prog->size = 0;
+    for (int pc = 0; pc < n; ++pc) {
+        Instr in = src[pc]; // the write cursor may overwrite src[pc]
+        int arity = in.op == OP_PUSH || in.op == OP_LOAD_MEM || in.op == OP_LOAD_VAR ? 0
+                  : in.op == OP_STORE_VAR ? 0
+                  : in.op == OP_NEG || in.op == OP_POWI ? 1
+                  : in.op == OP_CALL ? func_info[in.func].arity : 2;
+        OpCode op = in.op;
+        int func = in.func;
+        if (op == OP_CALL && func == FN_POW) op = OP_POW; // same function as ^
+
+        OptOperand *a = &st[sp - arity];
+        OptOperand *b = arity == 2 ? &st[sp - 1] : NULL;
+        int all_constant = 1, safe = !op_can_fail(&in);
+        double args[2] = { 0.0, 0.0 };
+        for (int k = 0; k < arity; ++k) {
+            all_constant &= a[k].constant;
+            safe &= a[k].safe;
+            args[k] = a[k].value;
+        }
+
+        double folded = 0.0;
+        int fold = arity > 0 && all_constant;
+        if (fold && prog->integer) {
+            int64_t ints[2] = { (int64_t)args[0], (int64_t)args[1] }, r;
+            if (int_op(&in, ints, &r)) {
+                // beyond 2^53 only program_exec_int has the exact value
+                fold = r >= -EXACT_INT_MAX && r <= EXACT_INT_MAX;
+                folded = (double)r;
+            } else if ((fold = fold_op(&in, args, &folded))) {
+                prog->integer = 0; // a fraction or an overflow: doubles after all
+            }
+        } else if (fold) {
+            fold = fold_op(&in, args, &folded);
+        }
+        if (fold) {
+            prog->size = a->start;
+            sp -= arity;
+            opt_emit(prog, OP_PUSH, 0, folded);
+            st[sp++] = (OptOperand){ prog->size - 1, 1, 1, folded };
+            continue;
+        }
+
+        if (arity == 0) {
+            opt_emit(prog, in.op, in.func, in.value);
+            if (in.op == OP_STORE_VAR) {
+                st[sp - 1].constant = 0; // keep the store
+                continue;
+            }
+            st[sp++] = (OptOperand){ prog->size - 1, in.op == OP_PUSH, 1, in.value };
+            continue;
+        }
+
+        if (op == OP_NEG && prog->code[prog->size - 1].op == OP_NEG) {
+            prog->size--; // --x
+            a->constant = 0;
+            continue;
+        }
+
+        if (b) {
+            double bv = b->value, av = a->value;
+            int keep_a = 0, keep_b = 0, negate = 0, one = 0, powi = 0;
+            if (b->constant) {
+                if ((op == OP_MUL || op == OP_DIV || op == OP_POW) && bv == 1.0) keep_a = 1;
+                else if ((op == OP_MUL || op == OP_DIV) && bv == -1.0) keep_a = negate = 1;
+                else if (op == OP_SUB && bv == 0.0 && !signbit(bv)) keep_a = 1;
+                else if (op == OP_ADD && bv == 0.0 && signbit(bv)) keep_a = 1;
+                else if (op == OP_POW && bv == 0.0 && a->safe) one = 1;
+                else if (op == OP_POW && (bv == 2.0 || bv == 3.0 || bv == 4.0)) powi = (int)bv;
+                else if (op == OP_DIV && is_power_of_two(bv) && !prog->integer) {
+                    prog->code[b->start].value = 1.0 / bv;
+                    op = OP_MUL;
+                }
+            }
+            if (!keep_a && !negate && !one && !powi && a->constant) {
+                if (op == OP_MUL && av == 1.0) keep_b = 1;
+                else if (op == OP_MUL && av == -1.0) keep_b = negate = 1;
+                else if (op == OP_ADD && av == 0.0 && signbit(av)) keep_b = 1;
+                else if (op == OP_POW && av == 1.0 && b->safe) one = 1;
+            }
+            if (one) {
+                prog->size = a->start;
+                sp -= 2;
+                opt_emit(prog, OP_PUSH, 0, 1.0);
+                st[sp++] = (OptOperand){ prog->size - 1, 1, 1, 1.0 };
+                continue;
+            }
+            if (keep_a || powi) prog->size = b->start;
+            else if (keep_b) opt_cut(prog, a->start, b->start);
+            sp--;
+            a->constant = 0;
+            a->safe = safe;
+            if (negate) opt_emit(prog, OP_NEG, 0, 0.0);
+            else if (powi) opt_emit(prog, OP_POWI, powi, 0.0);
+            else if (!keep_a && !keep_b) opt_emit(prog, op, op == OP_CALL ? func : 0, 0.0);
+            continue;
+        }
+
+        opt_emit(prog, in.op, in.func, in.value);
+        sp -= arity - 1;
+        st[sp - 1].constant = 0;
+        st[sp - 1].safe = safe;
+    }
+
+    // the stack only got shallower
+    int depth = 0;
+    prog->max_depth = 0;
+    for (int pc = 0; pc < prog->size; ++pc) {
+        const Instr *in = &prog->code[pc];
+        if (in->op == OP_PUSH || in->op == OP_LOAD_MEM || in->op == OP_LOAD_VAR) depth++;
+        else if (in->op == OP_CALL) depth -= func_info[in->func].arity - 1;
+        else if (in->op != OP_NEG && in->op != OP_POWI && in->op != OP_STORE_VAR) depth--;
+        if (depth > prog->max_depth) prog->max_depth = depth;
+    }
+    free(heap);
+}
+
+/* ---------- JIT compiler ---------- */
+
+/*
+  Translates a program into x86-64 machine code for lines that run often
+  enough to pay for it (see compile_line). Stack slot k lives in register
+  xmm<k>, so each arithmetic instruction becomes one SSE2 instruction with
+  no dispatch and no stack traffic; xmm14 and xmm15 are scratch. Built-ins
+  that cannot fail call the C library directly, with degree conversions
+  inline, sqrt and abs are inlined, and the rest call their kernel. The
+  ABI preserves no xmm register across a call, so the slots below the
+  arguments are saved in the frame around it. The context is read when
+  the code runs, so one translation serves every mode and memory value.
+
+  The code performs exactly the operations run_program does, in the same
+  order, so results are bit-identical (--jit-check compares them). Failed
+  checks return the instruction index + 1, as column evaluation does.
+  Programs deeper than JIT_MAX_DEPTH, and assignments, stay interpreted.
+*/
+
+#ifdef CALC_HAVE_JIT
+
+#define JIT_MAX_DEPTH 14
+#define JIT_THRESHOLD_DEFAULT 16
+#define JIT_INSTR_BYTES 384 // generous bound on the code for one instruction
+#define JIT_ARGS (8 * JIT_MAX_DEPTH)     // frame offset of the kernel arguments
+#define JIT_FRAME (JIT_ARGS + 16)        // keeps rsp 16-byte aligned at calls
+
+// Cache hits after which a line is compiled to machine code (--jit).
+static int jit_threshold = JIT_THRESHOLD_DEFAULT;
+
+// rbx holds the variable values, r12 the result pointer, r13 the context.
+enum { JIT_RAX = 0, JIT_RBX = 3, JIT_RSP = 4, JIT_R12 = 12, JIT_R13 = 13, JIT_TMP = 15 };
+
+// SSE2 opcodes after the 0x0f escape, and their mandatory prefixes.
+enum {
+    SSE_LOAD = 0x10, SSE_STORE = 0x11, SSE_MOVAPD = 0x28, SSE_UCOMISD = 0x2e,
+    SSE_SQRT = 0x51, SSE_AND = 0x54, SSE_XOR = 0x57, SSE_ADD = 0x58,
+    SSE_MUL = 0x59, SSE_SUB = 0x5c, SSE_DIV = 0x5e
+};
+enum { SSE_SD = 0xf2, SSE_PD = 0x66 };
+
+// Condition codes for short jumps (0x70 + cc).
+enum { JCC_NC = 0x3, JCC_Z = 0x4, JCC_NZ = 0x5, JCC_A = 0x7, JCC_P = 0xa };
+
+typedef struct {
+    unsigned char *p; // next byte to write
+} JitBuf;
+
+static void jit_byte(JitBuf *j, unsigned b) { *j->p++ = (unsigned char)b; }
+static void jit_u32(JitBuf *j, uint32_t v) { memcpy(j->p, &v, 4); j->p += 4; }
+static void jit_u64(JitBuf *j, uint64_t v) { memcpy(j->p, &v, 8); j->p += 8; }
+
+// op xmm<dst>, xmm<src>
+static void jit_sse(JitBuf *j, unsigned prefix, unsigned op, int dst, int src) {
+    jit_byte(j, prefix);
+    if (dst > 7 || src > 7) jit_byte(j, 0x40 | (dst > 7) << 2 | (src > 7));
+    jit_byte(j, 0x0f);
+    jit_byte(j, op);
+    jit_byte(j, 0xc0 | (dst & 7) << 3 | (src & 7));
+}
+
+// movsd between xmm<reg> and [base + disp]; op is SSE_LOAD or SSE_STORE.
+static void jit_movsd(JitBuf *j, unsigned op, int reg, int base, int32_t disp) {
+    jit_byte(j, SSE_SD);
+    if (reg > 7 || base > 7) jit_byte(j, 0x40 | (reg > 7) << 2 | (base > 7));
+    jit_byte(j, 0x0f);
+    jit_byte(j, op);
+    jit_byte(j, 0x80 | (reg & 7) << 3 | (base & 7));
+    if ((base & 7) == JIT_RSP) jit_byte(j, 0x24);
+    jit_u32(j, (uint32_t)disp);
+}
+
+// mov rax, imm64
+static void jit_mov_rax(JitBuf *j, uint64_t v) {
+    jit_byte(j, 0x48);
+    jit_byte(j, 0xb8);
+    jit_u64(j, v);
+}
+
+// xmm<reg> = the double with bits v
+static void jit_constant(JitBuf *j, int reg, uint64_t v) {
+    if (v == 0) { jit_sse(j, SSE_PD, SSE_XOR, reg, reg); return; }
+    jit_mov_rax(j, v);
+    jit_byte(j, SSE_PD); // movq xmm<reg>, rax
+    jit_byte(j, 0x48 | (reg > 7) << 2);
+    jit_byte(j, 0x0f);
+    jit_byte(j, 0x6e);
+    jit_byte(j, 0xc0 | (reg & 7) << 3);
+}
+
+static void jit_call(JitBuf *j, const void *fn) {
+    jit_mov_rax(j, (uint64_t)(uintptr_t)fn);
+    jit_byte(j, 0xff); // call rax
+    jit_byte(j, 0xd0);
+}
+
+static void jit_epilogue(JitBuf *j) {
+    jit_byte(j, 0x48); jit_byte(j, 0x81); jit_byte(j, 0xc4); jit_u32(j, JIT_FRAME); // add rsp, frame
+    jit_byte(j, 0x41); jit_byte(j, 0x5d);                                          // pop r13
+    jit_byte(j, 0x41); jit_byte(j, 0x5c);                                          // pop r12
+    jit_byte(j, 0x5b);                                                             // pop rbx
+    jit_byte(j, 0xc3);                                                             // ret
+}
+
+// A short forward jump on cc; jit_land points it at the current position.
+static unsigned char *jit_jump(JitBuf *j, unsigned cc) {
+    jit_byte(j, 0x70 | cc);
+    jit_byte(j, 0);
+    return j->p;
+}
+static void jit_land(JitBuf *j, unsigned char *from) { from[-1] = (unsigned char)(j->p - from); }
+
+// Returns pc + 1 unless one of the jumps taken before it skips the exit.
+static void jit_fail(JitBuf *j, int pc) {
+    jit_byte(j, 0xb8); // mov eax, pc + 1
+    jit_u32(j, (uint32_t)(pc + 1));
+    jit_epilogue(j);
+}
+
+// Fails unless the slot compares as cc against +0 or is NaN.
+static void jit_check(JitBuf *j, int reg, unsigned cc, int pc) {
+    jit_sse(j, SSE_PD, SSE_XOR, JIT_TMP, JIT_TMP);
+    jit_sse(j, SSE_PD, SSE_UCOMISD, reg, JIT_TMP);
+    unsigned char *nan = jit_jump(j, JCC_P), *pass = jit_jump(j, cc);
+    jit_fail(j, pc);
+    jit_land(j, nan);
+    jit_land(j, pass);
+}
+
+// Saves or restores slots [0, n), which a call would clobber.
+static void jit_spill(JitBuf *j, unsigned op, int n) {
+    for (int k = 0; k < n; ++k) jit_movsd(j, op, k, JIT_RSP, 8 * k);
+}
+
+static void jit_sign_op(JitBuf *j, unsigned op, int reg, uint64_t mask) {
+    jit_constant(j, JIT_TMP, mask);
+    jit_sse(j, SSE_PD, op, reg, JIT_TMP);
+}
+
+// In degree mode, reg = reg * mul / div, as to_radians and from_radians do.
+static void jit_angle(JitBuf *j, int reg, double mul, double div) {
+    jit_byte(j, 0x41); jit_byte(j, 0x83); jit_byte(j, 0xbd); // cmp dword [r13 + mode], MODE_DEG
+    jit_u32(j, (uint32_t)offsetof(CalcContext, angle_mode));
+    jit_byte(j, MODE_DEG);
+    unsigned char *rad = jit_jump(j, JCC_NZ);
+    jit_constant(j, JIT_TMP, vm_bits(mul));
+    jit_sse(j, SSE_SD, SSE_MUL, reg, JIT_TMP);
+    jit_constant(j, JIT_TMP, vm_bits(div));
+    jit_sse(j, SSE_SD, SSE_DIV, reg, JIT_TMP);
+    jit_land(j, rad);
+}
+
+static double jit_powi(double x, int n) { return powi_small(x, n); }
+
+// Slots [d, d + arity) -> xmm0 (and xmm1), call fn, result -> slot d.
+static void jit_call_libm(JitBuf *j, const void *fn, int d, int arity) {
+    jit_spill(j, SSE_STORE, d);
+    if (d) {
+        jit_sse(j, SSE_PD, SSE_MOVAPD, 0, d);
+        if (arity > 1) jit_sse(j, SSE_PD, SSE_MOVAPD, 1, d + 1);
+    }
+    jit_call(j, fn);
+    if (d) {
+        jit_sse(j, SSE_PD, SSE_MOVAPD, d, 0);
+        jit_spill(j, SSE_LOAD, d);
+    }
+}
+
+// Built-ins that are one C library call once checked and converted.
+static double (*const jit_libm[FN_COUNT])(double) = {
+    [FN_SIN] = sin, [FN_COS] = cos, [FN_TAN] = tan, [FN_ASIN] = asin, [FN_ACOS] = acos, [FN_ATAN] = atan,
+    [FN_SINH] = sinh, [FN_COSH] = cosh, [FN_TANH] = tanh, [FN_CBRT] = cbrt,
+    [FN_LN] = log, [FN_LOG] = log10, [FN_EXP] = exp, [FN_FLOOR] = floor, [FN_CEIL] = ceil,
+};
+
+static void jit_builtin(JitBuf *j, int id, int d, int pc) {
+    const FuncInfo *f = &func_info[id];
+    switch (id) {
+    case FN_SQRT: // fails below zero, like fn_sqrt
+        jit_check(j, d, JCC_NC, pc);
+        jit_sse(j, SSE_SD, SSE_SQRT, d, d);
+        return;
+    case FN_ABS:
+        jit_sign_op(j, SSE_AND, d, 0x7fffffffffffffffULL);
+        return;
+    case FN_LN:
+    case FN_LOG: // fail at or below zero
+        jit_check(j, d, JCC_A, pc);
+        break;
+    case FN_POW:
+        jit_call_libm(j, (const void*)pow, d, 2);
+        return;
+    }
+    if (jit_libm[id]) {
+        if (f->angle == ANGLE_ARG) jit_angle(j, d, M_PI, 180.0);
+        jit_call_libm(j, (const void*)jit_libm[id], d, 1);
+        if (f->angle == ANGLE_RESULT) jit_angle(j, d, 180.0, M_PI);
+        return;
+    }
+    jit_spill(j, SSE_STORE, d);
+    for (int k = 0; k < f->arity; ++k) jit_movsd(j, SSE_STORE, d + k, JIT_RSP, JIT_ARGS + 8 * k);
+    jit_byte(j, 0x48); jit_byte(j, 0x8d); jit_byte(j, 0xbc); jit_byte(j, 0x24); jit_u32(j, JIT_ARGS); // lea rdi, [rsp + args]
+    jit_byte(j, 0x48); jit_byte(j, 0x89); jit_byte(j, 0xfe);                                       // mov rsi, rdi
+    jit_call(j, (const void*)f->kernel);
+    jit_byte(j, 0x85); jit_byte(j, 0xc0); // test eax, eax
+    unsigned char *ok = jit_jump(j, JCC_NZ);
+    jit_fail(j, pc);
+    jit_land(j, ok);
+    jit_movsd(j, SSE_LOAD, d, JIT_RSP, JIT_ARGS);
+    jit_spill(j, SSE_LOAD, d);
+}
+
+/*
+  Compiles prog into out, a fresh executable block. Returns 0, leaving
+  out empty, for programs the JIT does not take or if no executable
+  memory can be had.
+*/
+int jit_compile(const Program *prog, ExecBlock *out) {
+    out->code = NULL;
+    out->size = 0;
+    if (prog->max_depth > JIT_MAX_DEPTH || prog->size < 1) return 0;
+    for (int pc = 0; pc < prog->size; ++pc)
+        if (prog->code[pc].op == OP_STORE_VAR) return 0;
+    exec_alloc(out, 64 + (size_t)prog->size * JIT_INSTR_BYTES);
+    if (!out->code) return 0;
+
+    JitBuf jb = { out->code }, *j = &jb;
+    jit_byte(j, 0x53);                                                              // push rbx
+    jit_byte(j, 0x41); jit_byte(j, 0x54);                                           // push r12
+    jit_byte(j, 0x41); jit_byte(j, 0x55);                                           // push r13
+    jit_byte(j, 0x48); jit_byte(j, 0x81); jit_byte(j, 0xec); jit_u32(j, JIT_FRAME); // sub rsp, frame
+    jit_byte(j, 0x49); jit_byte(j, 0x89); jit_byte(j, 0xfd);                        // mov r13, rdi (ctx)
+    jit_byte(j, 0x49); jit_byte(j, 0x89); jit_byte(j, 0xf4);                        // mov r12, rsi (result)
+    jit_byte(j, 0x48); jit_byte(j, 0x8b); jit_byte(j, 0x9f);                        // mov rbx, ctx->vars.values
+    jit_u32(j, (uint32_t)(offsetof(CalcContext, vars) + offsetof(VarTable, values)));
+
+    int sp = 0;
+    for (int pc = 0; pc < prog->size; ++pc) {
+        const Instr *in = &prog->code[pc];
+        int a = sp - 2, b = sp - 1;
+        switch (in->op) {
+        case OP_PUSH: jit_constant(j, sp++, vm_bits(in->value)); break;
+        case OP_LOAD_MEM: jit_movsd(j, SSE_LOAD, sp++, JIT_R13, (int32_t)offsetof(CalcContext, memory)); break;
+        case OP_LOAD_VAR: jit_movsd(j, SSE_LOAD, sp++, JIT_RBX, 8 * in->func); break;
+        case OP_STORE_VAR: break; // never reached, see above
+        case OP_ADD: jit_sse(j, SSE_SD, SSE_ADD, a, b); sp--; break;
+        case OP_SUB: jit_sse(j, SSE_SD, SSE_SUB, a, b); sp--; break;
+        case OP_MUL: jit_sse(j, SSE_SD, SSE_MUL, a, b); sp--; break;
+        case OP_DIV:
+        case OP_MOD: {
+            // fail on +-0: ucomisd sets ZF without PF only for equal
+            jit_sse(j, SSE_PD, SSE_XOR, JIT_TMP, JIT_TMP);
+            jit_sse(j, SSE_PD, SSE_UCOMISD, b, JIT_TMP);
+            unsigned char *nan = jit_jump(j, JCC_P), *nonzero = jit_jump(j, JCC_NZ);
+            jit_fail(j, pc);
+            jit_land(j, nan);
+            jit_land(j, nonzero);
+            if (in->op == OP_DIV) jit_sse(j, SSE_SD, SSE_DIV, a, b);
+            else jit_call_libm(j, (const void*)fmod, a, 2);
+            sp--;
+            break;
+        }
+        case OP_POW: jit_call_libm(j, (const void*)pow, a, 2); sp--; break;
+        case OP_POWI:
+            if (in->func == 2) { jit_sse(j, SSE_SD, SSE_MUL, b, b); break; }
+            jit_spill(j, SSE_STORE, b);
+            if (b) jit_sse(j, SSE_PD, SSE_MOVAPD, 0, b);
+            jit_byte(j, 0xbf); // mov edi, n
+            jit_u32(j, (uint32_t)in->func);
+            jit_call(j, (const void*)jit_powi);
+            if (b) { jit_sse(j, SSE_PD, SSE_MOVAPD, b, 0); jit_spill(j, SSE_LOAD, b); }
+            break;
+        case OP_NEG: jit_sign_op(j, SSE_XOR, b, 0x8000000000000000ULL); break;
+        case OP_CALL:
+            sp -= func_info[in->func].arity;
+            jit_builtin(j, in->func, sp, pc);
+            sp++;
+            break;
+        }
+    }
+    jit_movsd(j, SSE_STORE, 0, JIT_R12, 0);   // *result = slot 0
+    jit_byte(j, 0x31); jit_byte(j, 0xc0);    // xor eax, eax
+    jit_epilogue(j);
+
+    if (!exec_seal(out)) { exec_free(out); return 0; }
+    return 1;
+}
+
+#endif
+
+/* ---------- Program interpreter ---------- */
+
+// The degree-mode conversions around a call (see FuncInfo.angle).
+static double to_radians(const CalcContext *ctx, double a) { return ctx->angle_mode == MODE_DEG ? a * M_PI / 180.0 : a; }
+static double from_radians(const CalcContext *ctx, double r) { return ctx->angle_mode == MODE_DEG ? r * 180.0 / M_PI : r; }
+
+// Sets ctx->error to what run_program reports when instruction fail - 1 fails.
+void program_error(CalcContext *ctx, const Program *prog, int fail) {
+    const Instr *in = &prog->code[fail - 1];
+    if (in->op == OP_DIV) calc_error(ctx, "Math error: division by zero");
+    else if (in->op == OP_MOD) calc_error(ctx, "Math error: modulo by zero");
+    else calc_error(ctx, "Error evaluating function: %s", func_info[in->func].name);
+}
+
+/*
+  Runs prog with room for prog->max_depth values at stack. Returns 0 with
+  the value in *result, or the index + 1 of the instruction that failed,
+  like a JitFn.
+*/
+int program_exec(CalcContext *ctx, const Program *prog, double *stack, double *result) {
+    // compile_rpn guarantees every instruction finds its operands
+    double *sp = stack;
+    for (const Instr *in = prog->code, *end = in + prog->size; in < end; ++in) {
+        switch (in->op) {
+        case OP_PUSH: *sp++ = in->value; break;
+        case OP_LOAD_MEM: *sp++ = ctx->memory; break;
+        case OP_LOAD_VAR: *sp++ = ctx->vars.values[in->func]; break;
+        case OP_STORE_VAR:
+            ctx->vars.values[in->func] = sp[-1];
+            ctx->vars.defined[in->func] = 1;
+            break;
+        case OP_ADD: sp--; sp[-1] = sp[-1] + sp[0]; break;
+        case OP_SUB: sp--; sp[-1] = sp[-1] - sp[0]; break;
+        case OP_MUL: sp--; sp[-1] = sp[-1] * sp[0]; break;
+        case OP_DIV:
+            sp--;
+            if (sp[0] == 0.0) return (int)(in - prog->code) + 1;
+            sp[-1] = sp[-1] / sp[0]; break;
+        case OP_MOD:
+            sp--;
+            if (sp[0] == 0.0) return (int)(in - prog->code) + 1;
+            sp[-1] = fmod(sp[-1], sp[0]); break;
+        case OP_POW: sp--; sp[-1] = pow(sp[-1], sp[0]); break;
+        case OP_POWI: sp[-1] = powi_small(sp[-1], in->func); break;
+        case OP_NEG: sp[-1] = -sp[-1]; break;
+        case OP_CALL: {
+            const FuncInfo *f = &func_info[in->func];
+            sp -= f->arity;
+            if (f->angle == ANGLE_ARG) sp[0] = to_radians(ctx, sp[0]);
+            if (!f->kernel(sp, sp)) return (int)(in - prog->code) + 1;
+            if (f->angle == ANGLE_RESULT) sp[0] = from_radians(ctx, sp[0]);
+            sp++;
+            break;
+        }
+        }
+    }
+    *result = stack[0];
+    return 0;
+}
+
+int run_program(CalcContext *ctx, const Program *prog, double *result) {
+    int fail = prog->jit ? prog->jit(ctx, result)
+             : program_exec(ctx, prog, (double*)arena_alloc(&ctx->arena, sizeof(double) * prog->max_depth), result);
+    if (fail) program_error(ctx, prog, fail);
+    return !fail;
+}
+
+// Runs prog on integers when it is an integer program and that works out.
+int run_program_value(CalcContext *ctx, const Program *prog, CalcValue *v) {
+    v->exact = prog->integer &&
+               program_exec_int(ctx, prog, (int64_t*)arena_alloc(&ctx->arena, sizeof(int64_t) * prog->max_depth), &v->integer);
+    if (!v->exact) return run_program(ctx, prog, &v->value);
+    v->value = (double)v->integer;
+    return 1;
+}
+
+int evaluate_rpn(CalcContext *ctx, const TokenArray *rpn, double *result) {
+    Program prog;
+    CalcValue v;
+    program_init(&prog, ctx, rpn->size);
+    if (!compile_rpn(ctx, rpn, &prog) || !run_program_value(ctx, &prog, &v)) return 0;
+    *result = v.value;
+    return 1;
+}
+
+/*
+  Appends the store for "name = expr" to a compiled expression. Built-in
+  names cannot be assigned.
+*/
+int compile_assignment(CalcContext *ctx, const char *name, size_t len, Program *prog) {
+    if (registry_lookup(name, len).kind != SYM_NONE) {
+        calc_error(ctx, "Cannot assign to built-in name: %.*s", (int)len, name);
+        return 0;
+    }
+    program_emit(prog, OP_STORE_VAR, var_intern(&ctx->vars, name, len), 0.0);
+    return 1;
+}
+
+static int is_word_char(char c) {
+    return isalnum((unsigned char)c) || c == '_' || c == '$' || c == '.';
+}
+
+/*
+  Copies line into the arena with case folded and whitespace dropped,
+  except for one space where dropping it would join two names or numbers
+  ("2 3", "1 e5"). Lines that normalize alike compile alike.
+*/
+static const char *normalize_line(CalcContext *ctx, const char *line, size_t *len) {
+    size_t n = strlen(line), k = 0;
+    char *out = (char*)arena_alloc(&ctx->arena, n + 1);
+    int gap = 0;
+    for (size_t i = 0; i < n; ++i) {
+        char c = line[i];
+        if (isspace((unsigned char)c)) { gap = 1; continue; }
+        if (gap && k && is_word_char(out[k-1]) && is_word_char(c)) out[k++] = ' ';
+        gap = 0;
+        out[k++] = (char)tolower((unsigned char)c);
+    }
+    out[k] = '\0';
+    *len = k;
+    return out;
+}
+
+/*
+  Compiles a line (an expression or an assignment) into prog, in the arena.
+  A line seen before is copied out of ctx->programs instead, with machine
+  code once it has been seen jit_threshold times. Only lines that compile
+  are cached, and a cached program stays valid: variable slots never move
+  and nothing it refers to is ever undefined.
+*/
+CalcStatus compile_line(CalcContext *ctx, const char *line, Program *prog) {
+    const char *key = NULL;
+    size_t key_len = 0;
+    uint64_t hash = 0;
+    uint64_t t = profile_start(ctx);
+    if (ctx->programs.capacity) {
+        key = normalize_line(ctx, line, &key_len);
+        hash = cache_key_hash(key, key_len);
+        CacheEntry *hit = program_cache_find(&ctx->programs, key, key_len, hash);
+        if (hit) {
+            program_init(prog, ctx, hit->count);
+            memcpy(prog->code, cache_entry_image(hit), hit->bytes);
+            prog->size = hit->count;
+            prog->max_depth = hit->max_depth;
+            prog->integer = hit->integer;
+#ifdef CALC_HAVE_JIT
+            if (hit->uses == (unsigned long)jit_threshold) jit_compile(prog, &hit->jit);
+            prog->jit = (JitFn)(void*)hit->jit.code;
+#endif
+            profile_lap(ctx, STAGE_LOOKUP, &t);
+            return CALC_OK;
+        }
+        profile_lap(ctx, STAGE_LOOKUP, &t);
+    }
+
+    // no token count can exceed the line length, so no array has to grow
+    const char *target = NULL;
+    size_t target_len = assignment_target(line, &target, &line);
+
+    TokenArray tokens;
+    token_array_init(&tokens, ctx, (int)strlen(line) + 1);
+    if (!tokenize_expression(ctx, line, &tokens)) return CALC_ERR_TOKENIZE;
+    profile_lap(ctx, STAGE_TOKENIZE, &t);
+
+    TokenArray rpn;
+    token_array_init(&rpn, ctx, tokens.size);
+    if (!to_rpn(ctx, &tokens, &rpn)) return CALC_ERR_PARSE;
+    profile_lap(ctx, STAGE_RPN, &t);
+
+    program_init(prog, ctx, rpn.size + 1);
+    if (!compile_rpn(ctx, &rpn, prog)) return CALC_ERR_EVAL;
+    optimize_program(prog);
+    if (target_len && !compile_assignment(ctx, target, target_len, prog)) return CALC_ERR_EVAL;
+    if (key)
+        program_cache_store(&ctx->programs, key, key_len, hash, prog->code,
+                            sizeof(Instr) * (size_t)prog->size, prog->size, prog->max_depth, prog->integer);
+    profile_lap(ctx, STAGE_COMPILE, &t);
+    return CALC_OK;
+}
+
+// Runs a whole line through every stage; ctx->error says why one failed.
+CalcStatus calc_evaluate(CalcContext *ctx, const char *line, CalcValue *result) {
+    calc_begin(ctx);
+    Program prog;
+    CalcStatus status = compile_line(ctx, line, &prog);
+    if (status != CALC_OK) return status;
+    uint64_t t = profile_start(ctx);
+    if (!run_program_value(ctx, &prog, result)) return CALC_ERR_EVAL;
+    profile_lap(ctx, STAGE_EVALUATE, &t);
+    return CALC_OK;
+}
+
+/* ---------- Exact evaluation ---------- */
+
+/*
+  In exact mode (mode exact) a line is not compiled but evaluated straight
+  from its RPN on tagged numbers: integers are BigInts, anything else a
+  double. Integer literals (1e30 and 2.50e1 included), integral variables
+  and the results of +, -, *, %, ^ with a non-negative exponent, abs,
+  floor, ceil, fact, nCr, nPr, gcd and lcm on integers stay exact; /
+  stays exact when it divides evenly. Everything else drops to a double
+  and goes through the ordinary kernels. Exact lines bypass the program
+  cache and the JIT, and results are capped at EXACT_MAX_BITS.
+
+  Digits mode (digits N) is exact mode with big floats of float_prec bits
+  in place of doubles: decimal fractions, pi and e, uneven division and
+  non-integer powers give floats, and so do sqrt, exp, ln, log, the
+  trigonometric and hyperbolic functions and cbrt of them (see Big
+  floats). Floats print rounded to N significant digits, as do integers
+  longer than that. What has no float version (fact of a fraction, say)
+  still goes through the double kernels.
+
+  Rational mode (mode rational) is exact mode with fractions: decimal
+  literals and uneven division give a numerator and denominator in
+  lowest terms, which +, -, *, /, % and integer powers keep exact, as do
+  abs, floor and ceil. Fractions are reduced by gcd (binary, Stein's
+  algorithm, for operands of up to 64 bits). Everything else converts to
+  a double. A fraction prints as an exact decimal when its denominator
+  has no prime factors but 2 and 5, otherwise as n/d.
+*/
+
+#define EXACT_MAX_BITS (1 << 19)
+#define DIGITS_MAX 100000
+
+typedef enum { NUM_DOUBLE, NUM_INT, NUM_FLOAT, NUM_RATIONAL } NumKind;
+
+typedef struct {
+    NumKind kind;
+    double d;   // NUM_DOUBLE
+    BigInt i;   // NUM_INT, and the numerator of NUM_RATIONAL
+    BigInt den; // NUM_RATIONAL: i / den in lowest terms, den > 1
+    BigFloat f; // NUM_FLOAT
+} Number;
+
+void number_init(Number *v) {
+    v->kind = NUM_DOUBLE;
+    v->d = 0.0;
+    big_init(&v->i);
+    big_init(&v->den);
+    bf_init(&v->f);
+}
+
+void number_free(Number *v) {
+    big_free(&v->i);
+    big_free(&v->den);
+    bf_free(&v->f);
+}
+
+double number_to_double(const Number *v) {
+    switch (v->kind) {
+    case NUM_INT: return big_to_double(&v->i);
+    case NUM_FLOAT: return bf_to_double(&v->f);
+    case NUM_RATIONAL: {
+        BigFloat n, d;
+        bf_init(&n);
+        bf_init(&d);
+        bf_set_int(&n, &v->i);
+        bf_set_int(&d, &v->den);
+        bf_div(&n, &n, &d, DBL_MANT_DIG);
+        double r = bf_to_double(&n);
+        bf_free(&n);
+        bf_free(&d);
+        return r;
+    }
+    default: return v->d;
+    }
+}
+
+static int number_is_zero(const Number *v) {
+    switch (v->kind) {
+    case NUM_INT: return !v->i.n;
+    case NUM_FLOAT: return !v->f.m.n;
+    case NUM_RATIONAL: return 0;
+    default: return v->d == 0.0;
+    }
+}
+
+// Integers and fractions, which rational mode keeps exact.
+static int number_is_ratio(const Number *v) { return v->kind == NUM_INT || v->kind == NUM_RATIONAL; }
+
+/*
+  v = *num / *den (den nonzero, either sign) in lowest terms, an integer
+  when den divides num. Takes over num's and den's limbs.
+*/
+static void number_set_ratio(Number *v, BigInt *num, BigInt *den, int reduce) {
+    if (reduce) {
+        BigInt g;
+        big_init(&g);
+        big_gcd(&g, num, den);
+        if (g.n != 1 || g.d[0] != 1) {
+            big_divmod(num, NULL, num, &g);
+            big_divmod(den, NULL, den, &g);
+        }
+        big_free(&g);
+    }
+    if (den->neg) {
+        den->neg = 0;
+        num->neg = num->n && !num->neg;
+    }
+    big_move(&v->i, num);
+    big_init(num);
+    if (den->n == 1 && den->d[0] == 1) {
+        v->kind = NUM_INT;
+        big_free(den);
+    } else {
+        v->kind = NUM_RATIONAL;
+        big_move(&v->den, den);
+        big_init(den);
+    }
+}
+
+// r = v exactly; v must not be an infinite or NaN double.
+static void number_to_float(const Number *v, BigFloat *r) {
+    if (v->kind == NUM_INT) bf_set_int(r, &v->i);
+    else if (v->kind == NUM_FLOAT) bf_copy(r, &v->f);
+    else bf_set_double(r, v->d);
+}
+
+static void number_set_double(Number *v, double d) {
+    v->kind = NUM_DOUBLE;
+    v->d = d;
+}
+
+// Integral doubles (variables, the memory, floor and ceil) become integers.
+static void number_from_double(Number *v, double d) {
+    if (isfinite(d) && d == floor(d)) {
+        v->kind = NUM_INT;
+        big_set_double(&v->i, d);
+    } else {
+        number_set_double(v, d);
+    }
+}
+
+static int exact_fits(CalcContext *ctx, double bits) {
+    if (bits <= EXACT_MAX_BITS) return 1;
+    calc_error(ctx, "Math error: result too large for exact mode (over %.0f digits)", EXACT_MAX_BITS * log10(2.0));
+    return 0;
+}
+
+// Bits of big float precision in digits mode, 0 otherwise.
+static size_t float_prec(const CalcContext *ctx) {
+    if (ctx->numbers != NUMBERS_DIGITS) return 0;
+    // guard bits, so that printing N digits rounds the true value
+    return (size_t)ceil(ctx->digits * (M_LN10 / M_LN2)) + 16;
+}
+
+static FloatConsts *float_consts(CalcContext *ctx) {
+    if (!ctx->floats) {
+        ctx->floats = (FloatConsts*)calloc(1, sizeof(FloatConsts)); // all zero is initialized
+        if (!ctx->floats) { perror("calloc"); exit(1); }
+    }
+    return ctx->floats;
+}
+
+// Whether a float of magnitude about 2^+-bits is in range for digits mode.
+static int float_fits(CalcContext *ctx, double bits) {
+    if (fabs(bits) <= EXACT_MAX_BITS) return 1;
+    calc_error(ctx, "Math error: result out of range for digits mode (beyond 1e+/-%.0f)", EXACT_MAX_BITS * log10(2.0));
+    return 0;
+}
+
+// Moves *f into v, if it is in range.
+static int number_set_float(CalcContext *ctx, Number *v, BigFloat *f) {
+    if (f->m.n && !float_fits(ctx, (double)bf_top(f))) return 0;
+    v->kind = NUM_FLOAT;
+    bf_move(&v->f, f);
+    bf_init(f);
+    return 1;
+}
+
+// log2(n!) by Stirling's series, for size checks.
+static double log2_factorial(double n) {
+    if (n < 2) return 0.0;
+    return (n * log(n) - n + 0.5 * log(2 * M_PI * n) + 1 / (12 * n)) / M_LN2;
+}
+
+/*
+  The literal s[0, n) (value is its double), exactly if it is an integer:
+  hex, or decimal digits whose fraction the exponent cancels.
+*/
+static int exact_literal(CalcContext *ctx, Number *v, const char *s, size_t n, double value) {
+    if (n > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        big_set_u64(&v->i, 0);
+        for (size_t i = 2; i < n; ++i) {
+            if (!isxdigit((unsigned char)s[i])) continue;
+            int c = tolower((unsigned char)s[i]);
+            big_mul_add_small(&v->i, 16, (uint32_t)(isdigit(c) ? c - '0' : c - 'a' + 10));
+        }
+        v->kind = NUM_INT;
+        return exact_fits(ctx, (double)big_bits(&v->i));
+    }
+    size_t mant = 0, digits = 0, frac = 0, zeros = 0;
+    int dot = 0;
+    for (; mant < n && s[mant] != 'e' && s[mant] != 'E'; ++mant) {
+        if (s[mant] == '.') { dot = 1; continue; }
+        if (!isdigit((unsigned char)s[mant])) continue;
+        digits++;
+        if (dot) frac++;
+        zeros = s[mant] == '0' ? zeros + 1 : 0;
+    }
+    long exp10 = 0;
+    if (mant < n) {
+        size_t i = mant + 1;
+        int neg = i < n && s[i] == '-';
+        if (i < n && (s[i] == '-' || s[i] == '+')) i++;
+        for (; i < n; ++i)
+            if (isdigit((unsigned char)s[i]) && exp10 < 100000000) exp10 = exp10 * 10 + (s[i] - '0');
+        if (neg) exp10 = -exp10;
+    }
+    long scale = exp10 - (long)frac;
+    size_t prec = float_prec(ctx);
+    if (zeros == digits) scale = 0;               // zero
+    else if (scale < 0 && (long)zeros < -scale) { // a fraction remains
+        if (ctx->numbers == NUMBERS_RATIONAL && digits <= 18 && scale >= -18) {
+            uint64_t num = 0, den = 1;
+            for (size_t i = 0; i < mant; ++i)
+                if (isdigit((unsigned char)s[i])) num = num * 10 + (uint64_t)(s[i] - '0');
+            for (long i = scale; i < 0; ++i) den *= 10;
+            uint64_t g = gcd_u64(num, den);
+            big_set_u64(&v->i, num / g);
+            big_set_u64(&v->den, den / g);
+            v->kind = den == g ? NUM_INT : NUM_RATIONAL;
+            return 1;
+        }
+        if (ctx->numbers == NUMBERS_RATIONAL) {
+            // digits / 10^-scale
+            if (!exact_fits(ctx, ((double)(digits - zeros) - (double)scale) * M_LN10 / M_LN2)) return 0;
+            BigInt num, den;
+            big_init(&num);
+            big_init(&den);
+            big_from_decimal(&num, s, mant);
+            big_set_u64(&den, 10);
+            big_pow(&den, &den, (uint64_t)-scale);
+            number_set_ratio(v, &num, &den, 1);
+            return 1;
+        }
+        if (!prec) {
+            number_set_double(v, value);
+            return 1;
+        }
+        // digits / 10^-scale, rounded once
+        if (!exact_fits(ctx, (double)-scale * M_LN10 / M_LN2)) return 0;
+        BigFloat num, den;
+        bf_init(&num);
+        bf_init(&den);
+        big_from_decimal(&num.m, s, mant);
+        big_set_u64(&den.m, 10);
+        big_pow(&den.m, &den.m, (uint64_t)-scale);
+        bf_div(&num, &num, &den, prec);
+        int ok = number_set_float(ctx, v, &num);
+        bf_free(&num);
+        bf_free(&den);
+        return ok;
+    }
+    if (!exact_fits(ctx, ((double)(digits - zeros) + (double)scale) * M_LN10 / M_LN2)) return 0;
+    big_from_decimal(&v->i, s, mant);
+    for (long i = scale; i < 0; ++i) big_div_small(&v->i, 10);
+    if (scale > 0) {
+        BigInt p;
+        big_init(&p);
+        big_set_u64(&p, 10);
+        big_pow(&p, &p, (uint64_t)scale);
+        big_mul(&v->i, &v->i, &p);
+        big_free(&p);
+    }
+    v->kind = NUM_INT;
+    return 1;
+}
+
+// a = a^e for a non-negative e, or 0 with ctx->error set.
+static int exact_pow(CalcContext *ctx, BigInt *a, const BigInt *e) {
+    if (!e->n) { big_set_u64(a, 1); return 1; }
+    if (a->n == 0 || (a->n == 1 && a->d[0] == 1)) {
+        // 0, 1 and -1 stay put, except (-1)^even
+        if (a->neg && !(e->d[0] & 1)) a->neg = 0;
+        return 1;
+    }
+    if (e->n > 1) return exact_fits(ctx, INFINITY);
+    if (!exact_fits(ctx, big_log2(a) * e->d[0])) return 0;
+    big_pow(a, a, e->d[0]);
+    return 1;
+}
+
+// x = fmod(x, y) for nonzero y: exact, then rounded to prec bits.
+static int float_fmod(CalcContext *ctx, BigFloat *x, const BigFloat *y, size_t prec) {
+    if (!x->m.n || bf_top(x) < bf_top(y)) return 1;
+    long e = x->e < y->e ? x->e : y->e;
+    if (!exact_fits(ctx, (double)(bf_top(x) - e))) return 0;
+    BigInt den;
+    big_init(&den);
+    big_shl(&x->m, &x->m, (size_t)(x->e - e));
+    big_shl(&den, &y->m, (size_t)(y->e - e));
+    big_divmod(NULL, &x->m, &x->m, &den);
+    x->e = e;
+    bf_round(x, prec);
+    big_free(&den);
+    return 1;
+}
+
+/*
+  x = x^y to prec bits, y an integer if yi is not NULL. Returns -1 where
+  the result is not a real number or not finite, for doubles to handle.
+*/
+static int float_pow(CalcContext *ctx, BigFloat *x, const BigFloat *y, const BigInt *yi, size_t prec) {
+    if (!x->m.n) return y->m.neg || !y->m.n ? -1 : 1;
+    BigFloat t;
+    bf_init(&t);
+    int ok = 1;
+    if (yi) {
+        // by squaring, with a bit of guard for every rounding
+        if (yi->n > 1 || !float_fits(ctx, ((double)bf_top(x) - 1) * big_to_double(yi))) {
+            bf_free(&t);
+            return float_fits(ctx, INFINITY);
+        }
+        uint64_t n = yi->n ? yi->d[0] : 0;
+        bf_pow_int(&t, x, n, prec + 2 * log2_size(n + 1) + 8);
+        if (yi->neg) {
+            bf_set_pow2(x, 0);
+            bf_div(x, x, &t, prec);
+        } else {
+            bf_move(x, &t);
+            bf_init(&t);
+            bf_round(x, prec);
+        }
+    } else {
+        if (x->m.neg) { bf_free(&t); return -1; }
+        // exp(y ln x), with as many more bits as y ln x has integer bits
+        FloatConsts *fc = float_consts(ctx);
+        bf_ln(fc, &t, x, prec + 32);
+        bf_mul(&t, &t, y, prec + 32);
+        long top = t.m.n ? bf_top(&t) : 0;
+        if (top > 0 && !float_fits(ctx, bf_to_double(&t) / M_LN2)) ok = 0;
+        else {
+            size_t w = prec + 32 + (size_t)(top > 0 ? top : 0);
+            bf_ln(fc, &t, x, w);
+            bf_mul(&t, &t, y, w);
+            bf_exp(fc, x, &t, prec);
+        }
+    }
+    bf_free(&t);
+    return ok;
+}
+
+// a = a op b in big floats; -1 where doubles have to answer.
+static int float_binary(CalcContext *ctx, char op, Number *a, const Number *b, size_t prec) {
+    BigFloat x, y;
+    bf_init(&x);
+    bf_init(&y);
+    number_to_float(a, &x);
+    number_to_float(b, &y);
+    int ok = 1;
+    switch (op) {
+    case '+': bf_add(&x, &x, &y, prec); break;
+    case '-': bf_sub(&x, &x, &y, prec); break;
+    case '*': bf_mul(&x, &x, &y, prec); break;
+    case '/': bf_div(&x, &x, &y, prec); break;
+    case '%': ok = float_fmod(ctx, &x, &y, prec); break;
+    case '^': ok = float_pow(ctx, &x, &y, b->kind == NUM_INT ? &b->i : NULL, prec); break;
+    }
+    if (ok > 0) ok = number_set_float(ctx, a, &x);
+    bf_free(&x);
+    bf_free(&y);
+    return ok;
+}
+
+static int number_is_finite(const Number *v) { return v->kind != NUM_DOUBLE || isfinite(v->d); }
+
+#if defined(__SIZEOF_INT128__)
+static int ratio_is_small(const Number *v) {
+    return big_bits(&v->i) < 64 && (v->kind == NUM_INT || big_bits(&v->den) < 64);
+}
+
+/*
+  ratio_binary's +, -, * and / for parts below 2^63, in 128-bit integers.
+  Henrici's reductions keep the result in lowest terms from gcds of the
+  parts (for a sum, gcd(n, g) with g = gcd(ad, bd) is all that can be
+  left) rather than one of the products. Returns 0, with a untouched,
+  when a part of the result is 2^63 or more.
+*/
+static int ratio_small(char op, Number *a, const Number *b) {
+    uint64_t an = big_low_u64(&a->i), ad = a->kind == NUM_RATIONAL ? big_low_u64(&a->den) : 1;
+    uint64_t bn = big_low_u64(&b->i), bd = b->kind == NUM_RATIONAL ? big_low_u64(&b->den) : 1;
+    int neg;
+    unsigned __int128 n, d;
+    if (op == '*' || op == '/') {
+        if (op == '/') { uint64_t t = bn; bn = bd; bd = t; }
+        uint64_t g1 = gcd_u64(an, bd), g2 = gcd_u64(bn, ad);
+        n = (unsigned __int128)(an / g1) * (bn / g2);
+        d = (unsigned __int128)(ad / g2) * (bd / g1);
+        neg = a->i.neg != b->i.neg;
+    } else {
+        uint64_t g = gcd_u64(ad, bd);
+        __int128 x = (__int128)an * (bd / g), y = (__int128)bn * (ad / g);
+        if (a->i.neg) x = -x;
+        if (b->i.neg != (op == '-')) y = -y;
+        x += y;
+        neg = x < 0;
+        n = (unsigned __int128)(neg ? -x : x);
+        uint64_t g2 = gcd_u64((uint64_t)(n % g), g);
+        n /= g2;
+        d = (unsigned __int128)(ad / g) * (bd / g2);
+    }
+    if (!n) d = 1;
+    if (n >> 63 || d >> 63) return 0;
+    big_set_u64(&a->i, (uint64_t)n);
+    a->i.neg = neg && n;
+    if (d == 1) {
+        a->kind = NUM_INT;
+    } else {
+        a->kind = NUM_RATIONAL;
+        big_set_u64(&a->den, (uint64_t)d);
+    }
+    return 1;
+}
+#endif
+
+/*
+  a = a op b for integers and fractions, exactly; -1 for powers that are
+  not integer ones, which doubles answer.
+*/
+static int ratio_binary(CalcContext *ctx, char op, Number *a, const Number *b) {
+#if defined(__SIZEOF_INT128__)
+    if (op != '^' && op != '%' && ratio_is_small(a) && ratio_is_small(b) && ratio_small(op, a, b)) return 1;
+#endif
+    BigInt one, n, d, t;
+    big_init(&one);
+    big_init(&n);
+    big_init(&d);
+    big_init(&t);
+    big_set_u64(&one, 1);
+    const BigInt *an = &a->i, *bn = &b->i;
+    const BigInt *ad = a->kind == NUM_RATIONAL ? &a->den : &one, *bd = b->kind == NUM_RATIONAL ? &b->den : &one;
+    double bits = (double)(big_bits(an) + big_bits(ad) + big_bits(bn) + big_bits(bd));
+    int ok = 1, reduce = 1;
+    if (op == '^') {
+        // (n/d)^e = n^e / d^e, still in lowest terms
+        if (b->kind != NUM_INT || bn->n > 1 || (!an->n && bn->neg)) ok = -1;
+        else if (exact_fits(ctx, (double)(big_bits(an) + big_bits(ad)) * (bn->n ? bn->d[0] : 0))) {
+            uint64_t e = bn->n ? bn->d[0] : 0;
+            big_pow(&n, an, e);
+            big_pow(&d, ad, e);
+            if (bn->neg) { BigInt s = n; n = d; d = s; }
+            reduce = 0;
+        } else {
+            ok = 0;
+        }
+    } else if (!exact_fits(ctx, bits)) {
+        ok = 0;
+    } else {
+        switch (op) {
+        case '+': case '-':
+            big_mul(&n, an, bd);
+            big_mul(&t, bn, ad);
+            if (op == '+') big_add(&n, &n, &t);
+            else big_sub(&n, &n, &t);
+            big_mul(&d, ad, bd);
+            break;
+        case '*':
+            big_mul(&n, an, bn);
+            big_mul(&d, ad, bd);
+            break;
+        case '/':
+            big_mul(&n, an, bd);
+            big_mul(&d, ad, bn);
+            break;
+        case '%':
+            // fmod: what is left of a after the whole multiples of b, over ad bd
+            big_mul(&n, an, bd);
+            big_mul(&t, bn, ad);
+            big_divmod(NULL, &n, &n, &t);
+            big_mul(&d, ad, bd);
+            break;
+        }
+    }
+    if (ok > 0) number_set_ratio(a, &n, &d, reduce);
+    big_free(&one);
+    big_free(&n);
+    big_free(&d);
+    big_free(&t);
+    return ok;
+}
+
+// a = a op b
+static int exact_binary(CalcContext *ctx, char op, Number *a, const Number *b) {
+    if ((op == '/' || op == '%') && number_is_zero(b)) {
+        calc_error(ctx, op == '/' ? "Math error: division by zero" : "Math error: modulo by zero");
+        return 0;
+    }
+    if (a->kind == NUM_INT && b->kind == NUM_INT) {
+        switch (op) {
+        case '+': big_add(&a->i, &a->i, &b->i); return 1;
+        case '-': big_sub(&a->i, &a->i, &b->i); return 1;
+        case '*':
+            if (!exact_fits(ctx, (double)(big_bits(&a->i) + big_bits(&b->i)))) return 0;
+            big_mul(&a->i, &a->i, &b->i);
+            return 1;
+        case '%': big_divmod(NULL, &a->i, &a->i, &b->i); return 1;
+        case '^':
+            if (!b->i.neg) return exact_pow(ctx, &a->i, &b->i);
+            break;
+        case '/': {
+            BigInt q, r;
+            big_init(&q);
+            big_init(&r);
+            big_divmod(&q, &r, &a->i, &b->i);
+            int even = !r.n;
+            if (even) big_move(&a->i, &q);
+            else big_free(&q);
+            big_free(&r);
+            if (even) return 1;
+            break;
+        }
+        }
+    }
+    if (ctx->numbers == NUMBERS_RATIONAL && number_is_ratio(a) && number_is_ratio(b)) {
+        int done = ratio_binary(ctx, op, a, b);
+        if (done >= 0) return done;
+    }
+    size_t prec = float_prec(ctx);
+    if (prec && number_is_finite(a) && number_is_finite(b)) {
+        int done = float_binary(ctx, op, a, b, prec);
+        if (done >= 0) return done;
+    }
+    double x = number_to_double(a), y = number_to_double(b), r = 0.0;
+    switch (op) {
+    case '+': r = x + y; break;
+    case '-': r = x - y; break;
+    case '*': r = x * y; break;
+    case '/': r = x / y; break;
+    case '%': r = fmod(x, y); break;
+    case '^': r = pow(x, y); break;
+    }
+    number_set_double(a, r);
+    return 1;
+}
+
+// Integer arguments that fit 32 bits: n and, for nCr and nPr, 0 <= k <= n.
+static int exact_counts(const Number *args, int arity, uint32_t *n, uint32_t *k) {
+    for (int i = 0; i < arity; ++i)
+        if (args[i].kind != NUM_INT || args[i].i.n > 1 || args[i].i.neg) return 0;
+    *n = args[0].i.n ? args[0].i.d[0] : 0;
+    *k = arity > 1 && args[1].i.n ? args[1].i.d[0] : 0;
+    return arity == 1 || *k <= *n;
+}
+
+// r = (e^x + sign e^-x) / 2 to w bits, for |x| within range.
+static void float_exp_pair(FloatConsts *fc, BigFloat *r, const BigFloat *x, int sign, size_t w) {
+    BigFloat t;
+    bf_init(&t);
+    bf_exp(fc, r, x, w);
+    bf_set_pow2(&t, 0);
+    bf_div(&t, &t, r, w);
+    if (sign < 0) bf_sub(r, r, &t, w);
+    else bf_add(r, r, &t, w);
+    r->e--;
+    bf_free(&t);
+}
+
+/*
+  args[0] = id(args[0]) in big floats, for the functions that have them;
+  -1 for the rest and for arguments outside the domain, which the double
+  kernels take (and report). sqrt, exp, ln, sin, cos and atan are
+  correctly rounded; the others are put together from them with 64 guard
+  bits, plus as many as cancellation near zero would cost.
+*/
+static int float_call(CalcContext *ctx, int id, Number *args, size_t prec) {
+    const FuncInfo *f = &func_info[id];
+    FloatConsts *fc = float_consts(ctx);
+    BigFloat x, t, u;
+    bf_init(&x);
+    bf_init(&t);
+    bf_init(&u);
+    number_to_float(&args[0], &x);
+    long top = x.m.n ? bf_top(&x) : LONG_MIN / 2;
+    size_t w = prec + 64 + (size_t)(top < 0 && top > -(long)EXACT_MAX_BITS ? -top : 0);
+    int done = 1;
+    if (f->angle == ANGLE_ARG && ctx->angle_mode == MODE_DEG) {
+        // x * pi / 180, with the bits the reduction will need
+        w += (size_t)(top > 0 ? top : 0);
+        float_const(fc, FC_PI, w, &t);
+        bf_mul(&x, &x, &t, w);
+        big_set_u64(&t.m, 180);
+        t.e = 0;
+        bf_div(&x, &x, &t, w);
+        top = x.m.n ? bf_top(&x) : LONG_MIN / 2;
+    }
+    int one = x.m.n && top == 1 && big_ctz(&x.m) + 1 == big_bits(&x.m); // |x| == 1
+    int big = x.m.n && top > 1;                                         // |x| > 1
+    switch (id) {
+    case FN_SQRT:
+        if (x.m.neg) done = -1;
+        else bf_sqrt(&x, &x, prec);
+        break;
+    case FN_EXP: case FN_SINH: case FN_COSH:
+        if (!x.m.n) {
+            if (id != FN_SINH) bf_set_pow2(&x, 0);
+        } else if (top > 0 && !float_fits(ctx, bf_to_double(&x) / M_LN2)) {
+            done = 0;
+        } else if (id == FN_EXP) {
+            bf_exp(fc, &x, &x, prec);
+        } else {
+            float_exp_pair(fc, &x, &x, id == FN_SINH ? -1 : 1, w);
+        }
+        break;
+    case FN_TANH:
+        // (e^2x - 1) / (e^2x + 1), which is +-1 to any precision once |x| > prec
+        if (x.m.n && top > (long)log2_size(prec) + 1) {
+            int neg = x.m.neg;
+            bf_set_pow2(&x, 0);
+            x.m.neg = neg;
+        } else if (x.m.n) {
+            x.e++;
+            bf_exp(fc, &t, &x, w);
+            bf_set_pow2(&u, 0);
+            bf_add(&x, &t, &u, w);
+            bf_sub(&t, &t, &u, w);
+            bf_div(&x, &t, &x, w);
+        }
+        break;
+    case FN_LN: case FN_LOG:
+        if (!x.m.n || x.m.neg) done = -1;
+        else if (id == FN_LN) bf_ln(fc, &x, &x, prec);
+        else {
+            bf_ln(fc, &x, &x, w);
+            float_const(fc, FC_LN10, w, &t);
+            bf_div(&x, &x, &t, w);
+        }
+        break;
+    case FN_SIN: case FN_COS: case FN_TAN:
+        if (!x.m.n) {
+            if (id == FN_COS) bf_set_pow2(&x, 0);
+        } else if (id == FN_SIN) {
+            bf_sin(fc, &x, &x, prec);
+        } else if (id == FN_COS) {
+            bf_cos(fc, &x, &x, prec);
+        } else {
+            bf_sin(fc, &t, &x, w);
+            bf_cos(fc, &u, &x, w);
+            bf_div(&x, &t, &u, w);
+        }
+        break;
+    case FN_ATAN:
+        if (x.m.n) bf_atan(fc, &x, &x, prec);
+        break;
+    case FN_ASIN: case FN_ACOS:
+        // asin x = atan(x / sqrt((1-x)(1+x))), acos x = 2 atan(sqrt((1-x)/(1+x))),
+        // with 1-x and 1+x exact
+        if (big) { done = -1; break; }
+        if (one && id == FN_ASIN) {
+            float_const(fc, FC_PI, w, &u);
+            u.e--;
+            u.m.neg = x.m.neg;
+            bf_move(&x, &u);
+            bf_init(&u);
+            break;
+        }
+        if (!x.m.n && id == FN_ASIN) break;
+        {
+            size_t exact = big_bits(&x.m) + (size_t)(x.e < 0 ? -x.e : 0) + 2;
+            BigFloat unit;
+            bf_init(&unit);
+            bf_set_pow2(&unit, 0);
+            bf_sub(&t, &unit, &x, exact);
+            bf_add(&u, &unit, &x, exact);
+            if (id == FN_ASIN) {
+                bf_mul(&t, &t, &u, w);
+                bf_sqrt(&t, &t, w);
+                bf_div(&x, &x, &t, w);
+                bf_atan(fc, &x, &x, w);
+            } else if (!u.m.n) {
+                float_const(fc, FC_PI, w, &x);
+            } else {
+                bf_div(&t, &t, &u, w);
+                bf_sqrt(&t, &t, w);
+                bf_atan(fc, &x, &t, w);
+                x.e++;
+            }
+            bf_free(&unit);
+        }
+        break;
+    case FN_CBRT:
+        if (x.m.n) {
+            int neg = x.m.neg;
+            x.m.neg = 0;
+            bf_ln(fc, &x, &x, w);
+            big_set_u64(&t.m, 3);
+            t.e = 0;
+            bf_div(&x, &x, &t, w);
+            bf_exp(fc, &x, &x, w);
+            x.m.neg = neg;
+        }
+        break;
+    case FN_ABS:
+        x.m.neg = 0;
+        break;
+    case FN_FLOOR: case FN_CEIL:
+        if (!exact_fits(ctx, (double)top)) { done = 0; break; }
+        bf_to_int(&args[0].i, &x, id == FN_FLOOR ? -1 : 1);
+        args[0].kind = NUM_INT;
+        bf_free(&x); bf_free(&t); bf_free(&u);
+        return 1;
+    default:
+        done = -1;
+    }
+    if (done > 0 && f->angle == ANGLE_RESULT && ctx->angle_mode == MODE_DEG) {
+        float_const(fc, FC_PI, w, &t);
+        big_set_u64(&u.m, 180);
+        u.e = 0;
+        bf_mul(&x, &x, &u, w);
+        bf_div(&x, &x, &t, w);
+    }
+    if (done > 0) {
+        bf_round(&x, prec);
+        done = number_set_float(ctx, &args[0], &x);
+    }
+    bf_free(&x); bf_free(&t); bf_free(&u);
+    return done;
+}
+
+// args[0] = id(args...), exactly when the function and arguments allow.
+static int exact_call(CalcContext *ctx, int id, Number *args) {
+    const FuncInfo *f = &func_info[id];
+    if (id == FN_POW) return exact_binary(ctx, '^', &args[0], &args[1]);
+    int ints = args[0].kind == NUM_INT && (f->arity < 2 || args[1].kind == NUM_INT);
+    BigInt *a = &args[0].i, *b = &args[1].i;
+    uint32_t n, k;
+    if (ints) switch (id) {
+    case FN_ABS: a->neg = 0; return 1;
+    case FN_FLOOR: case FN_CEIL: return 1;
+    case FN_GCD: big_gcd(a, a, b); return 1;
+    case FN_LCM:
+        if (!a->n || !b->n) { big_set_u64(a, 0); return 1; }
+        if (!exact_fits(ctx, (double)(big_bits(a) + big_bits(b)))) return 0;
+        {
+            BigInt g;
+            big_init(&g);
+            big_gcd(&g, a, b);
+            big_divmod(a, NULL, a, &g);
+            big_mul(a, a, b);
+            a->neg = 0;
+            big_free(&g);
+        }
+        return 1;
+    case FN_FACT:
+        if (!exact_counts(args, 1, &n, &k)) break;
+        if (!exact_fits(ctx, log2_factorial(n))) return 0;
+        big_range_product(a, 2, n);
+        return 1;
+    case FN_NPR:
+        if (!exact_counts(args, 2, &n, &k)) break;
+        if (!exact_fits(ctx, log2_factorial(n) - log2_factorial(n - k))) return 0;
+        if (k) big_range_product(a, n - k + 1, n);
+        else big_set_u64(a, 1);
+        return 1;
+    case FN_NCR:
+        if (!exact_counts(args, 2, &n, &k)) break;
+        if (!exact_fits(ctx, log2_factorial(n) - log2_factorial(k) - log2_factorial(n - k))) return 0;
+        big_binomial(a, n, k);
+        return 1;
+    }
+    if (args[0].kind == NUM_RATIONAL && (id == FN_ABS || id == FN_FLOOR || id == FN_CEIL)) {
+        if (id == FN_ABS) {
+            a->neg = 0;
+            return 1;
+        }
+        // the quotient truncates; floor and ceil step away from it for their side
+        int up = id == FN_CEIL;
+        BigInt q;
+        big_init(&q);
+        big_divmod(&q, NULL, a, &args[0].den);
+        if (a->neg != up) {
+            big_mul_add_small(&q, 1, 1);
+            q.neg = a->neg;
+        }
+        if (!q.n) q.neg = 0;
+        big_move(a, &q);
+        big_free(&args[0].den);
+        args[0].kind = NUM_INT;
+        return 1;
+    }
+    size_t prec = float_prec(ctx);
+    if (prec && f->arity == 1 && number_is_finite(&args[0])) {
+        int done = float_call(ctx, id, args, prec);
+        if (done >= 0) return done;
+    }
+    // the double kernel, for everything else (and to report domain errors)
+    double in[2] = { number_to_double(&args[0]), f->arity > 1 ? number_to_double(&args[1]) : 0.0 };
+    if (f->angle == ANGLE_ARG) in[0] = to_radians(ctx, in[0]);
+    if (!f->kernel(in, in)) {
+        calc_error(ctx, "Error evaluating function: %s", f->name);
+        return 0;
+    }
+    if (f->angle == ANGLE_RESULT) in[0] = from_radians(ctx, in[0]);
+    if (id == FN_FLOOR || id == FN_CEIL) number_from_double(&args[0], in[0]);
+    else number_set_double(&args[0], in[0]);
+    return 1;
+}
+
+// Evaluates rpn, which compile_rpn has accepted, into *result.
+static int exact_rpn(CalcContext *ctx, const TokenArray *rpn, Number *result) {
+    Number *stack = (Number*)arena_alloc(&ctx->arena, sizeof(Number) * (size_t)rpn->size);
+    for (int i = 0; i < rpn->size; ++i) number_init(&stack[i]);
+    int sp = 0, ok = 1;
+    for (int i = 0; ok && i < rpn->size; ++i) {
+        const Token *t = &rpn->data[i];
+        switch (t->type) {
+        case TOKEN_NUMBER:
+            ok = exact_literal(ctx, &stack[sp++], rpn->src + t->offset, t->len, t->u.value);
+            break;
+        case TOKEN_CONSTANT:
+            if (t->u.id == CONST_MEM) {
+                number_from_double(&stack[sp++], ctx->memory);
+            } else if (float_prec(ctx)) {
+                BigFloat c;
+                bf_init(&c);
+                bf_const(float_consts(ctx), t->u.id == CONST_PI ? FC_PI : FC_E, &c, float_prec(ctx));
+                ok = number_set_float(ctx, &stack[sp++], &c);
+                bf_free(&c);
+            } else {
+                number_set_double(&stack[sp++], const_info[t->u.id].value);
+            }
+            break;
+        case TOKEN_IDENTIFIER:
+            number_from_double(&stack[sp++], ctx->vars.values[t->u.id]);
+            break;
+        case TOKEN_OPERATOR:
+            sp--;
+            ok = exact_binary(ctx, t->op, &stack[sp-1], &stack[sp]);
+            break;
+        case TOKEN_UNARY:
+            if (t->op != '-') break;
+            if (number_is_ratio(&stack[sp-1])) stack[sp-1].i.neg = !stack[sp-1].i.neg && stack[sp-1].i.n;
+            else if (stack[sp-1].kind == NUM_FLOAT) stack[sp-1].f.m.neg = !stack[sp-1].f.m.neg && stack[sp-1].f.m.n;
+            else stack[sp-1].d = -stack[sp-1].d;
+            break;
+        case TOKEN_FUNCTION:
+            sp -= func_info[t->u.id].arity;
+            ok = exact_call(ctx, t->u.id, &stack[sp]);
+            sp++;
+            break;
+        }
+    }
+    if (ok) {
+        number_free(result);
+        *result = stack[0];
+        big_init(&stack[0].i);
+        big_init(&stack[0].den);
+        bf_init(&stack[0].f);
+    }
+    for (int i = 0; i < rpn->size; ++i) number_free(&stack[i]);
+    return ok;
+}
+
+/*
+  calc_evaluate for exact and digits modes: the same stages and errors,
+  with the value kept exact where it can be (see Number). *result is always initialized
+  and must be number_free'd. An assignment stores the value rounded to a
+  double, as variables are doubles.
+*/
+CalcStatus calc_evaluate_exact(CalcContext *ctx, const char *line, Number *result) {
+    calc_begin(ctx);
+    number_init(result);
+    uint64_t t = profile_start(ctx);
+    const char *target = NULL;
+    size_t target_len = assignment_target(line, &target, &line);
+
+    TokenArray tokens;
+    token_array_init(&tokens, ctx, (int)strlen(line) + 1);
+    if (!tokenize_expression(ctx, line, &tokens)) return CALC_ERR_TOKENIZE;
+    profile_lap(ctx, STAGE_TOKENIZE, &t);
+
+    TokenArray rpn;
+    token_array_init(&rpn, ctx, tokens.size);
+    if (!to_rpn(ctx, &tokens, &rpn)) return CALC_ERR_PARSE;
+    profile_lap(ctx, STAGE_RPN, &t);
+
+    // compiling checks names and operand counts; the program is not run
+    Program prog;
+    program_init(&prog, ctx, rpn.size + 1);
+    if (!compile_rpn(ctx, &rpn, &prog)) return CALC_ERR_EVAL;
+    if (target_len && !compile_assignment(ctx, target, target_len, &prog)) return CALC_ERR_EVAL;
+    profile_lap(ctx, STAGE_COMPILE, &t);
+
+    if (!exact_rpn(ctx, &rpn, result)) return CALC_ERR_EVAL;
+    if (target_len) {
+        int slot = prog.code[prog.size-1].func;
+        ctx->vars.values[slot] = number_to_double(result);
+        ctx->vars.defined[slot] = 1;
+    }
+    profile_lap(ctx, STAGE_EVALUATE, &t);
+    return CALC_OK;
+}
+
+/*
+  A fraction as an exact decimal if its denominator is 2^a 5^b, otherwise
+  as n/d. Returns a malloc'd string of *len characters.
+*/
+static char *ratio_format(const Number *v, size_t *len) {
+    BigInt rest, t;
+    big_init(&rest);
+    big_init(&t);
+    size_t twos = big_ctz(&v->den), fives = 0;
+    big_shr(&rest, &v->den, twos);
+    for (;;) {
+        big_copy(&t, &rest);
+        if (big_div_small(&t, 5)) break;
+        big_move(&rest, &t);
+        big_init(&t);
+        fives++;
+    }
+    char *s;
+    if (rest.n == 1 && rest.d[0] == 1) {
+        // n / (2^a 5^b) = n 2^(k-a) 5^(k-b) / 10^k, for k = max(a, b)
+        size_t k = twos > fives ? twos : fives, n;
+        big_set_u64(&t, 5);
+        big_pow(&t, &t, k - fives);
+        big_mul(&t, &t, &v->i);
+        big_shl(&t, &t, k - twos);
+        t.neg = 0;
+        char *digits = big_to_decimal(&t, &n);
+        size_t whole = n > k ? n - k : 0;
+        s = (char*)malloc(n + k + 4);
+        if (!s) { perror("malloc"); exit(1); }
+        char *p = s;
+        if (v->i.neg) *p++ = '-';
+        if (whole) {
+            memcpy(p, digits, whole);
+            p += whole;
+        } else {
+            *p++ = '0';
+        }
+        *p++ = '.';
+        for (size_t i = n; i < k; ++i) *p++ = '0';
+        memcpy(p, digits + whole, n - whole);
+        p += n - whole;
+        *p = '\0';
+        *len = (size_t)(p - s);
+        free(digits);
+    } else {
+        size_t nn, dn;
+        char *num = big_to_decimal(&v->i, &nn), *den = big_to_decimal(&v->den, &dn);
+        s = (char*)malloc(nn + dn + 2);
+        if (!s) { perror("malloc"); exit(1); }
+        memcpy(s, num, nn);
+        s[nn] = '/';
+        memcpy(s + nn + 1, den, dn + 1);
+        *len = nn + 1 + dn;
+        free(num);
+        free(den);
+    }
+    big_free(&rest);
+    big_free(&t);
+    return s;
+}
+
+/*
+  v as text: an integer in full, or rounded to digits significant digits
+  if it has more and digits is not 0; a float rounded to digits; a
+  fraction exactly; a double as fmt says. Returns a malloc'd string of
+  *len characters.
+*/
+char *number_format(const Number *v, const NumberFormat *fmt, int digits, size_t *len) {
+    if (v->kind == NUM_FLOAT) return bf_to_decimal(&v->f, digits, len);
+    if (v->kind == NUM_RATIONAL) return ratio_format(v, len);
+    if (v->kind == NUM_INT) {
+        char *s;
+        if (!digits || (double)big_bits(&v->i) * log10(2.0) < digits + 1) {
+            s = big_to_decimal(&v->i, len);
+            if (!digits || *len - (size_t)v->i.neg <= (size_t)digits) return s;
+            free(s);
+        }
+        BigFloat f;
+        bf_init(&f);
+        bf_set_int(&f, &v->i);
+        s = bf_to_decimal(&f, digits, len);
+        bf_free(&f);
+        return s;
+    }
+    char *s = (char*)malloc(FORMAT_BUF_LEN);
+    if (!s) { perror("malloc"); exit(1); }
+    *len = format_double(s, v->d, fmt);
+    return s;
+}
+
+/* ---------- Column evaluation ---------- */
+
+/*
+  Evaluates one compiled program over many bindings at once. Variables are
+  bound to columns (struct-of-arrays: one contiguous array per variable)
+  and the program runs over COLUMN_BLOCK rows at a time, with every stack
+  slot a block of lanes, so each instruction becomes one tight loop that
+  the compiler vectorizes. On x86-64 with GCC the block function is
+  cloned for AVX-512, AVX2 and baseline SSE2, and the loader picks one
+  for the running CPU.
+
+  Arithmetic is bit-identical to run_program. Powers and the functions
+  that have a vector kernel (see Vector math) go through those kernels and
+  agree with libm to within their documented error; a lane whose result
+  is not finite is recomputed by the scalar kernel, so errors and
+  infinities come out exactly as in run_program. A row that would fail
+  there (division by zero, a domain error in a function) is flagged
+  instead of stopping the others.
+*/
+
+#define COLUMN_BLOCK 256
+
+// A loop over every lane; the lanes of one stack slot never overlap another.
+#define COLUMN_LOOP(i) SIMD_LOOP(i, COLUMN_BLOCK)
+
+typedef double ColumnLanes[COLUMN_BLOCK];
+
+/*
+  One block: rows [base, base + lanes) of the bound columns. Lanes past
+  `lanes` are padding and their results are ignored. fail[i] gets the
+  index + 1 of the first instruction that failed for row base + i.
+  scratch is one block that is not part of the stack.
+*/
+CALC_SIMD_CLONES
+static void column_block(const CalcContext *ctx, const Program *prog, ColumnLanes *stack, double *scratch,
+                         const double *const *bind, size_t base, int lanes, double *out, int *fail) {
+    int deg = ctx->angle_mode == MODE_DEG;
+    int sp = 0;
+    for (int i = 0; i < lanes; ++i) fail[i] = 0;
+    for (int pc = 0; pc < prog->size; ++pc) {
+        const Instr *in = &prog->code[pc];
+        double *restrict a = stack[sp > 1 ? sp - 2 : 0];
+        double *restrict b = stack[sp > 0 ? sp - 1 : 0];
+        int i;
+        switch (in->op) {
+        case OP_PUSH:
+        case OP_LOAD_MEM:
+        case OP_LOAD_VAR: {
+            double *restrict t = stack[sp++];
+            const double *col = in->op == OP_LOAD_VAR ? bind[in->func] : NULL;
+            if (col) {
+                memcpy(t, col + base, sizeof(double) * (size_t)lanes);
+                for (i = lanes; i < COLUMN_BLOCK; ++i) t[i] = 1.0;
+            } else {
+                double v = in->op == OP_PUSH ? in->value : in->op == OP_LOAD_MEM ? ctx->memory : ctx->vars.values[in->func];
+                COLUMN_LOOP(i) t[i] = v;
+            }
+            break;
+        }
+        case OP_STORE_VAR: break; // column runs never assign
+        case OP_ADD: COLUMN_LOOP(i) a[i] = a[i] + b[i]; sp--; break;
+        case OP_SUB: COLUMN_LOOP(i) a[i] = a[i] - b[i]; sp--; break;
+        case OP_MUL: COLUMN_LOOP(i) a[i] = a[i] * b[i]; sp--; break;
+        case OP_DIV:
+        case OP_MOD: {
+            int zero = 0;
+            COLUMN_LOOP(i) zero |= b[i] == 0.0;
+            if (zero)
+                for (i = 0; i < lanes; ++i) if (b[i] == 0.0 && !fail[i]) fail[i] = pc + 1;
+            if (in->op == OP_DIV) COLUMN_LOOP(i) a[i] = a[i] / b[i];
+            else for (i = 0; i < lanes; ++i) a[i] = fmod(a[i], b[i]);
+            sp--;
+            break;
+        }
+        case OP_POW:
+            vmath_pow(a, b, scratch, COLUMN_BLOCK);
+            memcpy(a, scratch, sizeof(ColumnLanes));
+            sp--;
+            break;
+        case OP_POWI:
+            COLUMN_LOOP(i) b[i] = powi_small(b[i], in->func);
+            break;
+        case OP_NEG: COLUMN_LOOP(i) b[i] = -b[i]; break;
+        case OP_CALL: {
+            const FuncInfo *f = &func_info[in->func];
+            double *restrict x = stack[sp - f->arity];
+            double *restrict y = f->arity > 1 ? stack[sp - f->arity + 1] : NULL;
+            double *restrict t = scratch;
+            int odd = 1;
+            if (deg && f->angle == ANGLE_ARG) COLUMN_LOOP(i) x[i] = x[i] * M_PI / 180.0;
+            if (f->vec) {
+                // keep the finite results; the scalar kernel redoes the rest
+                f->vec(x, y, t, COLUMN_BLOCK);
+                odd = 0;
+                COLUMN_LOOP(i) {
+                    int finite = t[i] - t[i] == 0.0;
+                    odd |= !finite;
+                    x[i] = finite ? t[i] : x[i];
+                }
+            }
+            for (i = 0; odd && i < lanes; ++i) {
+                double args[2];
+                if (f->vec && t[i] - t[i] == 0.0) continue;
+                args[0] = x[i];
+                if (y) args[1] = y[i];
+                if (!f->kernel(args, args) && !fail[i]) fail[i] = pc + 1;
+                x[i] = args[0];
+            }
+            if (deg && f->angle == ANGLE_RESULT) COLUMN_LOOP(i) x[i] = x[i] * 180.0 / M_PI;
+            sp -= f->arity - 1;
+            break;
+        }
+        }
+    }
+    memcpy(out, stack[0], sizeof(double) * (size_t)lanes);
+}
+
+/*
+  Evaluates prog for n rows. bind is indexed by variable slot: a column of
+  n values, or NULL to use the variable's current value for every row.
+  Failed rows get NaN in out and a nonzero fail entry (see program_error).
+  Returns the number of failed rows.
+*/
+size_t eval_columns(const CalcContext *ctx, const Program *prog, const double *const *bind, size_t n,
+                    double *out, int *fail) {
+    size_t depth = (size_t)(prog->max_depth > 0 ? prog->max_depth : 1);
+    ColumnLanes *stack = (ColumnLanes*)malloc(sizeof(ColumnLanes) * (depth + 1));
+    if (!stack) { perror("malloc"); exit(1); }
+    size_t failed = 0;
+    for (size_t base = 0; base < n; base += COLUMN_BLOCK) {
+        int lanes = n - base < COLUMN_BLOCK ? (int)(n - base) : COLUMN_BLOCK;
+        column_block(ctx, prog, stack, stack[depth], bind, base, lanes, out + base, fail + base);
+        for (int i = 0; i < lanes; ++i)
+            if (fail[base + i]) { out[base + i] = NAN; failed++; }
+    }
+    free(stack);
+    return failed;
+}
+
+/* ---------- Library API ---------- */
+
+/*
+  The calc.h entry points. A calc_expr owns a copy of its program (and its
+  machine code), compiled in a throwaway context whose variable slots are
+  numbered in order of first appearance. Evaluation runs in a context view
+  on the caller's stack that holds only what a program reads (the
+  variables, memory and angle mode), so a calc_expr is never written after
+  calc_compile returns.
+*/
+
+struct calc_expr {
+    Program prog;       // code is malloc'd, arena NULL
+    char **names;       // variable names, by slot
+    size_t nvars;
+    AngleMode angle_mode;
+#ifdef CALC_HAVE_JIT
+    ExecBlock jit;
+#endif
+};
+
+#define CALC_EVAL_STACK 64 // deeper programs take their stack from the heap
+
+static void set_error_info(calc_error_info *err, CalcStatus status, long row, const char *message) {
+    if (!err) return;
+    err->status = status;
+    err->row = row;
+    snprintf(err->message, sizeof(err->message), "%s", message);
+}
+
+int calc_version(void) {
+    return CALC_VERSION;
+}
+
+calc_expr *calc_compile(const char *text, calc_error_info *err) {
+    CalcContext ctx;
+    calc_init(&ctx);
+    calc_begin(&ctx);
+    CalcStatus status = CALC_OK;
+    Program prog;
+    TokenArray tokens, rpn;
+    token_array_init(&tokens, &ctx, (int)strlen(text) + 1);
+    if (assignment_target(text, NULL, NULL)) {
+        calc_error(&ctx, "Assignments cannot be compiled, only expressions");
+        status = CALC_ERR_PARSE;
+    } else if (!tokenize_expression(&ctx, text, &tokens)) {
+        status = CALC_ERR_TOKENIZE;
+    } else {
+        // every name that is not a built-in becomes the next variable
+        for (int i = 0; i < tokens.size; ++i) {
+            Token *t = &tokens.data[i];
+            if (t->type != TOKEN_IDENTIFIER) continue;
+            t->u.id = var_intern(&ctx.vars, text + t->offset, t->len);
+            ctx.vars.defined[t->u.id] = 1;
+        }
+        token_array_init(&rpn, &ctx, tokens.size);
+        program_init(&prog, &ctx, tokens.size + 1);
+        if (!to_rpn(&ctx, &tokens, &rpn)) status = CALC_ERR_PARSE;
+        else if (!compile_rpn(&ctx, &rpn, &prog)) status = CALC_ERR_EVAL;
+        else {
+            prog.integer = 0; // columns are only run on doubles
+            optimize_program(&prog);
+        }
+    }
+    if (status != CALC_OK) {
+        set_error_info(err, status, -1, ctx.error);
+        calc_free(&ctx);
+        return NULL;
+    }
+
+    calc_expr *e = (calc_expr*)calloc(1, sizeof(calc_expr));
+    if (!e) { perror("calloc"); exit(1); }
+    e->prog = prog;
+    e->prog.arena = NULL;
+    e->prog.capacity = prog.size > 0 ? prog.size : 1;
+    e->prog.code = (Instr*)malloc(sizeof(Instr) * e->prog.capacity);
+    if (!e->prog.code) { perror("malloc"); exit(1); }
+    memcpy(e->prog.code, prog.code, sizeof(Instr) * (size_t)prog.size);
+    // the table's names move to the handle
+    e->nvars = (size_t)ctx.vars.count;
+    e->names = ctx.vars.names;
+    ctx.vars.names = NULL;
+    ctx.vars.count = 0;
+    e->angle_mode = MODE_RAD;
+#ifdef CALC_HAVE_JIT
+    // a compiled expression is there to be run many times: translate it now
+    if (jit_threshold > 0 && jit_compile(&e->prog, &e->jit)) e->prog.jit = (JitFn)(void*)e->jit.code;
+#endif
+    calc_free(&ctx);
+    set_error_info(err, CALC_OK, -1, "");
+    return e;
+}
+
+void calc_release(calc_expr *e) {
+    if (!e) return;
+    for (size_t i = 0; i < e->nvars; ++i) free(e->names[i]);
+    free(e->names);
+    free(e->prog.code);
+#ifdef CALC_HAVE_JIT
+    exec_free(&e->jit);
+#endif
+    free(e);
+}
+
+size_t calc_var_count(const calc_expr *e) {
+    return e->nvars;
+}
+
+const char *calc_var_name(const calc_expr *e, size_t i) {
+    return i < e->nvars ? e->names[i] : NULL;
+}
+
+void calc_set_degrees(calc_expr *e, int degrees) {
+    e->angle_mode = degrees ? MODE_DEG : MODE_RAD;
+}
+
+// The part of a context that running e reads, with vars bound by slot.
+static void calc_view(CalcContext *view, const calc_expr *e, const double *vars) {
+    view->angle_mode = e->angle_mode;
+    view->memory = 0.0;
+    memset(&view->vars, 0, sizeof(view->vars));
+    view->vars.values = (double*)vars; // programs without stores only read it
+    view->error[0] = '\0';
+}
+
+double calc_eval(const calc_expr *e, const double *vars, calc_error_info *err) {
+    CalcContext view;
+    calc_view(&view, e, vars);
+    double result, small[CALC_EVAL_STACK];
+    int fail;
+    if (e->prog.jit) {
+        fail = e->prog.jit(&view, &result);
+    } else if (e->prog.max_depth <= CALC_EVAL_STACK) {
+        fail = program_exec(&view, &e->prog, small, &result);
+    } else {
+        double *stack = (double*)malloc(sizeof(double) * (size_t)e->prog.max_depth);
+        if (!stack) { perror("malloc"); exit(1); }
+        fail = program_exec(&view, &e->prog, stack, &result);
+        free(stack);
+    }
+    if (fail) {
+        program_error(&view, &e->prog, fail);
+        set_error_info(err, CALC_ERR_EVAL, -1, view.error);
+        return NAN;
+    }
+    set_error_info(err, CALC_OK, -1, "");
+    return result;
+}
+
+size_t calc_eval_batch(const calc_expr *e, const double *const *columns, size_t n,
+                       double *out, calc_error_info *err) {
+    CalcContext view;
+    calc_view(&view, e, NULL);
+    int *fail = (int*)malloc(sizeof(int) * (n ? n : 1));
+    if (!fail) { perror("malloc"); exit(1); }
+    size_t failed = eval_columns(&view, &e->prog, columns, n, out, fail);
+    set_error_info(err, CALC_OK, -1, "");
+    for (size_t r = 0; failed && r < n; ++r) {
+        if (!fail[r]) continue;
+        program_error(&view, &e->prog, fail[r]);
+        set_error_info(err, CALC_ERR_EVAL, (long)r, view.error);
+        break;
+    }
+    free(fail);
+    return failed;
+}
+
+#ifndef CALC_LIBRARY
+
+/* ---------- Main calculator logic ---------- */
+
+void print_help() {
+    printf("Big Calculator - Help:\n");
+    printf("Basic usage: <number> <operator> <number>  (e.g. 3 + 4)\n");
+    printf("Operators: + - * / ^ %%\n");
+    printf("Numbers: 42, 3.5, 1e-9, 0x1F, 1_000_000\n");
+    printf("Functions:");
+    for (int i = 0; i < FN_COUNT; ++i) printf(" %s", func_info[i].name);
+    printf("\nConstants:");
+    for (int i = 0; i < CONST_COUNT; ++i) {
+        printf(" %s", const_info[i].name);
+        if (const_info[i].note) printf(" (%s)", const_info[i].note);
+    }
+    printf("\n");
+    printf("Angle mode: mode rad|deg (default is rad)\n");
+    printf("Number mode: mode float|exact|rational, digits <N> (exact keeps integers exact at any size,\n");
+    printf("             rational keeps fractions exact too, digits N computes the rest to N significant\n");
+    printf("             digits; default is float)\n");
+    printf("Memory: m+ <value>, m- <value>, mr (recall), mc (clear)\n");
+    printf("Variables: x = <expr> (assign), vars (list)\n");
+    printf("History: h (show), h <n> (show last n), !<n> (recall n), !! (repeat last)\n");
+    printf("Statistics: stats\n");
+    printf("Help: ? or help\n");
+}
+
+void print_usage(const char *prog) {
+    printf("Usage: %s [--batch | --interactive | --sweep EXPR] [--threads N] [--format shortest|N] [--cache N] [--jit N] [--accuracy] [--profile] [--jit-check] [--stress] [--bench [--perf]] [file]\n", prog);
+    printf("  --batch        read expressions from file or stdin, print one bare result per line\n");
+    printf("  --interactive  prompt for input even when stdin is not a terminal\n");
+    printf("  --sweep EXPR   evaluate EXPR for every row of a table whose first line names the columns\n");
+    printf("  --threads N    workers for large batch files and piped input (default: one per CPU)\n");
+    printf("  --format F     'shortest' (round-trips exactly) or N significant digits, 1-17\n");
+    printf("                 (default: shortest in batch mode, 10 at the prompt)\n");
+    printf("  --cache N      remember the compiled form of the last N distinct lines (default %d, 0 = off)\n", PROGRAM_CACHE_DEFAULT);
+    printf("  --jit N        compile a cached line to machine code once it has been used N times\n");
+    printf("                 (default 16, 0 = never; x86-64 only)\n");
+    printf("  --profile      print counters and per-stage latencies (as the stats command does) at exit\n");
+    printf("  --accuracy     check the vector math kernels against the C library and exit\n");
+    printf("  --jit-check    check machine code against the interpreter on random expressions and exit\n");
+    printf("  --stress       run sessions on many threads at once, check them against single runs and exit\n");
+    printf("  --bench        time each stage on built-in corpora (and file, if given), print JSON and exit\n");
+    printf("  --perf         --bench with hardware counters per stage: cycles, IPC, cache and branch misses (Linux)\n");
+    printf("Batch mode is the default when stdin is not a terminal.\n");
+}
+
+typedef enum { CMD_NONE, CMD_DONE, CMD_ERROR, CMD_QUIT } CommandStatus;
+
+// What a command may touch. In batch mode nothing is printed; commands
+// that produce a number (mr) hand it back instead.
+typedef struct {
+    CalcContext *ctx;
+    int interactive;
+    int has_value;
+    CalcValue value;
+} CommandEnv;
+
+typedef struct {
+    const char *name;
+    int prefix; // name only has to start the line (case-sensitive)
+    CommandStatus (*run)(CommandEnv *env, const char *line);
+} Command;
+
+static CommandStatus cmd_quit(CommandEnv *env, const char *line) {
+    (void)env; (void)line;
+    return CMD_QUIT;
+}
+
+static CommandStatus cmd_help(CommandEnv *env, const char *line) {
+    (void)line;
+    if (env->interactive) print_help();
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_mode_rad(CommandEnv *env, const char *line) {
+    (void)line;
+    env->ctx->angle_mode = MODE_RAD;
+    if (env->interactive) printf("Angle mode set to RADIANS\n");
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_mode_deg(CommandEnv *env, const char *line) {
+    (void)line;
+    env->ctx->angle_mode = MODE_DEG;
+    if (env->interactive) printf("Angle mode set to DEGREES\n");
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_mode_float(CommandEnv *env, const char *line) {
+    (void)line;
+    env->ctx->numbers = NUMBERS_FLOAT;
+    if (env->interactive) printf("Number mode set to FLOAT\n");
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_mode_exact(CommandEnv *env, const char *line) {
+    (void)line;
+    env->ctx->numbers = NUMBERS_EXACT;
+    if (env->interactive) printf("Number mode set to EXACT\n");
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_mode_rational(CommandEnv *env, const char *line) {
+    (void)line;
+    env->ctx->numbers = NUMBERS_RATIONAL;
+    if (env->interactive) printf("Number mode set to RATIONAL\n");
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_digits(CommandEnv *env, const char *line) {
+    // digits <N>
+    char *endptr;
+    long n = strtol(line + 6, &endptr, 10);
+    while (isspace((unsigned char)*endptr)) endptr++;
+    if (endptr == line + 6 || *endptr != '\0' || n < 1 || n > DIGITS_MAX) {
+        calc_error(env->ctx, "Invalid digits: expected 1-%d", DIGITS_MAX);
+        return CMD_ERROR;
+    }
+    env->ctx->numbers = NUMBERS_DIGITS;
+    env->ctx->digits = (int)n;
+    if (env->interactive) printf("Number mode set to %ld DIGITS\n", n);
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_memory_add(CommandEnv *env, const char *line) {
+    // m+ <value> / m- <value>
+    char op = line[1];
+    char *endptr;
+    double value = strtod(line+2, &endptr);
+    if (endptr == line+2 || *endptr != '\0') {
+        calc_error(env->ctx, "Invalid memory operation");
+        return CMD_ERROR;
+    }
+    if (op == '+') env->ctx->memory += value;
+    else env->ctx->memory -= value;
+    if (env->interactive) {
+        char num[FORMAT_BUF_LEN];
+        format_double(num, fabs(value), &env->ctx->format);
+        printf("Memory slot %s: %s\n", (op == '+') ? "added to" : "subtracted from", num);
+    }
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_memory_recall(CommandEnv *env, const char *line) {
+    (void)line;
+    if (env->interactive) {
+        char num[FORMAT_BUF_LEN];
+        format_double(num, env->ctx->memory, &env->ctx->format);
+        printf("Memory recall: %s\n", num);
+    }
+    env->has_value = 1;
+    env->value = (CalcValue){ env->ctx->memory, 0, 0 };
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_memory_clear(CommandEnv *env, const char *line) {
+    (void)line;
+    env->ctx->memory = 0.0;
+    if (env->interactive) printf("Memory cleared\n");
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_vars(CommandEnv *env, const char *line) {
+    (void)line;
+    if (!env->interactive) return CMD_DONE;
+    const VarTable *vars = &env->ctx->vars;
+    for (int i = 0; i < vars->count; ++i) {
+        if (!vars->defined[i]) continue;
+        char num[FORMAT_BUF_LEN];
+        format_double(num, vars->values[i], &env->ctx->format);
+        printf("%s = %s\n", vars->names[i], num);
+    }
+    return CMD_DONE;
+}
+
+static CommandStatus cmd_history(CommandEnv *env, const char *line) {
+    (void)line;
+    if (env->interactive) history_print(&env->ctx->history);
+    return CMD_DONE;
+}
+
+static const char *const stage_names[STAGE_COUNT] = {
+    "lookup", "tokenize", "rpn", "compile", "evaluate", "format",
+};
+
+static void print_duration(FILE *fp, double ns) {
+    if (ns < 1e3) fprintf(fp, " %7.0f ns", ns);
+    else if (ns < 1e6) fprintf(fp, " %7.2f us", ns / 1e3);
+    else if (ns < 1e9) fprintf(fp, " %7.2f ms", ns / 1e6);
+    else fprintf(fp, " %7.2f s ", ns / 1e9);
+}
+
+// The stats report: counters, and stage latencies when profiling.
+void print_stats(FILE *fp, const CalcContext *ctx) {
+    const Profile *p = ctx->profile;
+    unsigned long expressions = ctx->expressions + (p ? p->expressions : 0);
+    unsigned long allocs = ctx->arena.heap_allocs + ctx->programs.heap_allocs + (p ? p->heap_allocs : 0);
+    unsigned long hits = ctx->programs.hits + (p ? p->cache_hits : 0);
+    unsigned long misses = ctx->programs.misses + (p ? p->cache_misses : 0);
+    fprintf(fp, "Expressions: %lu\n", expressions);
+    fprintf(fp, "Heap allocations: %lu (%.3f per expression, arena %lu KB)\n", allocs,
+            expressions ? (double)allocs / (double)expressions : 0.0, (unsigned long)(ctx->arena.cap / 1024));
+    fprintf(fp, "Program cache: %lu hits, %lu misses, %.1f%% hit rate (%d of %d entries)\n", hits, misses,
+            hits + misses ? 100.0 * (double)hits / (double)(hits + misses) : 0.0,
+            ctx->programs.count, ctx->programs.capacity);
+    if (!p) return;
+    fprintf(fp, "%-9s %10s %10s %10s %10s %10s %10s\n", "stage", "count", "mean", "p50", "p99", "p999", "max");
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        const StageProfile *sp = &p->stage[s];
+        fprintf(fp, "%-9s %10lu", stage_names[s], sp->count);
+        print_duration(fp, sp->count ? (double)sp->total_ns / (double)sp->count : 0.0);
+        print_duration(fp, profile_percentile(sp, 0.5));
+        print_duration(fp, profile_percentile(sp, 0.99));
+        print_duration(fp, profile_percentile(sp, 0.999));
+        print_duration(fp, (double)sp->max_ns);
+        fputc('\n', fp);
+    }
+}
+
+static CommandStatus cmd_stats(CommandEnv *env, const char *line) {
+    (void)line;
+    if (env->interactive) print_stats(stdout, env->ctx);
+    return CMD_DONE;
+}
+
+static const Command commands[] = {
+    {"exit", 0, cmd_quit},
+    {"quit", 0, cmd_quit},
+    {"?", 1, cmd_help},
+    {"mode rad", 0, cmd_mode_rad},
+    {"mode deg", 0, cmd_mode_deg},
+    {"mode float", 0, cmd_mode_float},
+    {"mode exact", 0, cmd_mode_exact},
+    {"mode rational", 0, cmd_mode_rational},
+    {"digits ", 1, cmd_digits},
+    {"m+", 1, cmd_memory_add},
+    {"m-", 1, cmd_memory_add},
+    {"mr", 0, cmd_memory_recall},
+    {"mc", 0, cmd_memory_clear},
+    {"vars", 0, cmd_vars},
+    {"h", 0, cmd_history},
+    {"stats", 0, cmd_stats},
+};
+
+// Finds the command a line invokes, without running it.
+const Command *find_command(const char *line) {
+    for (size_t i = 0; i < sizeof(commands)/sizeof(commands[0]); ++i) {
+        const Command *c = &commands[i];
+        if (c->prefix ? strncmp(line, c->name, strlen(c->name)) == 0 : str_eq_nocase(line, c->name)) return c;
+    }
+    return NULL;
+}
+
+CommandStatus run_command(CommandEnv *env, const char *line) {
+    const Command *c = find_command(line);
+    return c ? c->run(env, line) : CMD_NONE;
+}
+
+int run_repl(CalcContext *ctx) {
+    printf("Big Calculator - Type ? or help for help\n");
+
+    char line[8192];
+    while (1) {
+        printf("> ");
+        if (!fgets(line, sizeof(line), stdin)) break;
+        trim_trailing_newline(line);
+
+        CommandEnv env = { ctx, 1, 0, { 0.0, 0, 0 } };
+        CommandStatus cmd = run_command(&env, line);
+        if (cmd == CMD_QUIT) break;
+        if (cmd == CMD_ERROR) fprintf(stderr, "%s\n", ctx->error);
+        if (cmd != CMD_NONE) continue;
+
+        CalcValue result;
+        Number exact;
+        int is_exact = ctx->numbers != NUMBERS_FLOAT;
+        CalcStatus status = is_exact ? calc_evaluate_exact(ctx, line, &exact) : calc_evaluate(ctx, line, &result);
+        if (status != CALC_ERR_TOKENIZE) history_add(&ctx->history, line);
+        if (status != CALC_OK) {
+            fprintf(stderr, "%s\n", ctx->error);
+            if (status == CALC_ERR_TOKENIZE) fprintf(stderr, "Invalid expression: %s\n", line);
+            else if (status == CALC_ERR_PARSE) fprintf(stderr, "Error converting to RPN\n");
+            else fprintf(stderr, "Error evaluating expression\n");
+        } else if (is_exact) {
+            size_t len;
+            uint64_t t = profile_start(ctx);
+            char *num = number_format(&exact, &ctx->format, ctx->numbers == NUMBERS_DIGITS ? ctx->digits : 0, &len);
+            profile_lap(ctx, STAGE_FORMAT, &t);
+            printf("Result: %s\n", num);
+            free(num);
+        } else {
+            char num[FORMAT_BUF_LEN];
+            uint64_t t = profile_start(ctx);
+            format_value(num, &result, &ctx->format);
+            profile_lap(ctx, STAGE_FORMAT, &t);
+            printf("Result: %s\n", num);
+        }
+        if (is_exact) number_free(&exact);
+    }
+
+    printf("Goodbye!\n");
+    return 0;
+}
+
+/* ---------- Batch mode ---------- */
+
+#define BATCH_READ_SIZE (1 << 20)
+#define BATCH_WRITE_SIZE (1 << 20)
+
+/*
+  Buffered writer for results and messages. With a FILE it is flushed when
+  full and at the end; without one (fp == NULL) it grows and keeps
+  everything, which lets parallel workers hold output until its turn.
+*/
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t cap;
+    FILE *fp;
+} OutBuf;
+
+void outbuf_init(OutBuf *o, FILE *fp, size_t cap) {
+    o->buf = (char*)malloc(cap);
+    if (!o->buf) { perror("malloc"); exit(1); }
+    o->len = 0;
+    o->cap = cap;
+    o->fp = fp;
+}
+void outbuf_flush(OutBuf *o) {
+    if (o->fp && o->len) fwrite(o->buf, 1, o->len, o->fp);
+    if (o->fp) o->len = 0;
+}
+// Returns room for at least n bytes at the end of the buffer.
+char *outbuf_reserve(OutBuf *o, size_t n) {
+    if (o->cap - o->len < n) {
+        outbuf_flush(o);
+        if (o->cap - o->len < n) {
+            while (o->cap - o->len < n) o->cap *= 2;
+            o->buf = (char*)realloc(o->buf, o->cap);
+            if (!o->buf) { perror("realloc"); exit(1); }
+        }
+    }
+    return o->buf + o->len;
+}
+void outbuf_write(OutBuf *o, const char *s, size_t n) {
+    memcpy(outbuf_reserve(o, n), s, n);
+    o->len += n;
+}
+void outbuf_free(OutBuf *o) {
+    outbuf_flush(o);
+    free(o->buf);
+    o->buf = NULL;
+}
+
+// Where one batch run, or one slice of it, sends its output.
+typedef struct {
+    OutBuf out;
+    OutBuf err;
+    int failed;
+} BatchOutput;
+
+void batch_output_init(BatchOutput *o, FILE *out, FILE *err) {
+    outbuf_init(&o->out, out, BATCH_WRITE_SIZE);
+    outbuf_init(&o->err, err, 4096);
+    o->failed = 0;
+}
+void batch_output_free(BatchOutput *o) {
+    outbuf_free(&o->out);
+    outbuf_free(&o->err);
+}
+
+void batch_write_result(OutBuf *out, const CalcValue *value, const NumberFormat *fmt) {
+    char *p = outbuf_reserve(out, FORMAT_BUF_LEN + 1);
+    size_t n = format_value(p, value, fmt);
+    p[n] = '\n';
+    out->len += n + 1;
+}
+
+typedef enum { LINE_DONE, LINE_QUIT, LINE_STATEFUL } LineStatus;
+
+/*
+  Evaluates one line of batch input in place (line[len] is overwritten).
+  Emits a bare result, or "error" plus a numbered message, so output stays
+  aligned with the expression lines. With stateless set, a command or
+  assignment line is left alone and reported as LINE_STATEFUL.
+*/
+LineStatus batch_line(CalcContext *ctx, char *line, size_t len, unsigned long lineno, int stateless, BatchOutput *o) {
+    if (len && line[len-1] == '\r') len--;
+    line[len] = '\0';
+    size_t start = 0;
+    while (start < len && isspace((unsigned char)line[start])) start++;
+    if (start == len) return LINE_DONE;
+    line += start;
+
+    CommandEnv env = { ctx, 0, 0, { 0.0, 0, 0 } };
+    CommandStatus cmd = CMD_NONE;
+    const Command *c = find_command(line);
+    if (c) {
+        if (stateless) return LINE_STATEFUL;
+        cmd = c->run(&env, line);
+        if (cmd == CMD_QUIT) return LINE_QUIT;
+    } else if (stateless && assignment_target(line, NULL, NULL)) {
+        return LINE_STATEFUL;
+    } else if (ctx->numbers != NUMBERS_FLOAT) {
+        Number v;
+        if (calc_evaluate_exact(ctx, line, &v) == CALC_OK) {
+            size_t n;
+            uint64_t t = profile_start(ctx);
+            char *num = number_format(&v, &ctx->format, ctx->numbers == NUMBERS_DIGITS ? ctx->digits : 0, &n);
+            outbuf_write(&o->out, num, n);
+            outbuf_write(&o->out, "\n", 1);
+            free(num);
+            profile_lap(ctx, STAGE_FORMAT, &t);
+        } else {
+            cmd = CMD_ERROR;
+        }
+        number_free(&v);
+    } else {
+        env.has_value = calc_evaluate(ctx, line, &env.value) == CALC_OK;
+        if (!env.has_value) cmd = CMD_ERROR;
+    }
+    if (cmd == CMD_ERROR) {
+        o->failed = 1;
+        outbuf_write(&o->out, "error\n", 6);
+        char *p = outbuf_reserve(&o->err, CALC_ERROR_LEN + 32);
+        o->err.len += (size_t)snprintf(p, CALC_ERROR_LEN + 32, "line %lu: %s\n", lineno, ctx->error);
+    } else if (env.has_value) {
+        uint64_t t = profile_start(ctx);
+        batch_write_result(&o->out, &env.value, &ctx->format);
+        profile_lap(ctx, STAGE_FORMAT, &t);
+    }
+    return LINE_DONE;
+}
+
+// Runs every line of text[0, len); the text must be writable.
+LineStatus batch_text(CalcContext *ctx, char *text, size_t len, unsigned long *lineno, BatchOutput *o) {
+    char *p = text, *end = text + len;
+    while (p < end) {
+        char *nl = (char*)memchr(p, '\n', (size_t)(end - p));
+        if (!nl) nl = end;
+        if (batch_line(ctx, p, (size_t)(nl - p), ++*lineno, 0, o) == LINE_QUIT) return LINE_QUIT;
+        p = nl + 1;
+    }
+    return LINE_DONE;
+}
+
+// Reads in, a file or pipe, in large blocks with no line length limit.
+/*
+  Reads in by blocks and hands fn every complete line, several at a time:
+  text[0, len) is writable and holds whole lines, the last one without its
+  newline. Stops early when fn returns 0. Returns 1 on a read error.
+*/
+typedef int (*TextFn)(void *arg, char *text, size_t len);
+
+int read_text_blocks(FILE *in, TextFn fn, void *arg) {
+    size_t cap = BATCH_READ_SIZE;
+    char *buf = (char*)malloc(cap + 1);
+    if (!buf) { perror("malloc"); exit(1); }
+
+    size_t have = 0;
+    int running = 1, eof = 0;
+    while (running && !eof) {
+        if (have == cap) { // one line fills the buffer: grow it
+            cap *= 2;
+            buf = (char*)realloc(buf, cap + 1);
+            if (!buf) { perror("realloc"); exit(1); }
+        }
+        size_t n = fread(buf + have, 1, cap - have, in);
+        if (n == 0) eof = 1;
+        have += n;
+
+        // hand over complete lines; at EOF the rest is the last line
+        char *end = buf + have;
+        char *last_nl = eof ? end : NULL;
+        for (char *q = end; !last_nl && q > buf; --q)
+            if (q[-1] == '\n') last_nl = q - 1;
+        if (!last_nl) continue;
+        running = fn(arg, buf, (size_t)(last_nl - buf));
+        char *rest = (last_nl == end) ? end : last_nl + 1;
+        have = (size_t)(end - rest);
+        memmove(buf, rest, have);
+    }
+
+    free(buf);
+    if (ferror(in)) { perror("read"); return 1; }
+    return 0;
+}
+
+typedef struct {
+    CalcContext *ctx;
+    unsigned long lineno;
+    BatchOutput o;
+} BatchRun;
+
+static int batch_block(void *arg, char *text, size_t len) {
+    BatchRun *r = (BatchRun*)arg;
+    return batch_text(r->ctx, text, len, &r->lineno, &r->o) != LINE_QUIT;
+}
+
+int run_batch(CalcContext *ctx, FILE *in) {
+    BatchRun r;
+    r.ctx = ctx;
+    r.lineno = 0;
+    batch_output_init(&r.o, stdout, stderr);
+    int read_failed = read_text_blocks(in, batch_block, &r);
+    int failed = r.o.failed;
+    batch_output_free(&r.o);
+    return read_failed || failed;
+}
+
+/* ---------- Column sweeps ---------- */
+
+/*
+  --sweep evaluates one expression over a table. The first line names the
+  columns, each further line holds one number per column (separated by
+  commas or blanks), and every column is bound to the variable of the same
+  name. Rows are parsed straight into per-column arrays, SWEEP_ROWS at a
+  time, and evaluated with eval_columns; output matches batch mode, one
+  result or "error" per row.
+*/
+
+#define SWEEP_ROWS (64 * COLUMN_BLOCK)
+
+typedef struct {
+    CalcContext *ctx;
+    const char *expr;
+    Program prog;
+    int ncols;                 // 0 until the header has been read
+    double **cols;             // ncols arrays of SWEEP_ROWS values
+    const double **bind;       // column for each variable slot, or NULL
+    unsigned long *lines;      // input line of each pending row
+    unsigned char *bad;        // rows that did not hold ncols numbers
+    double *out;
+    int *fail;
+    size_t rows;
+    unsigned long lineno;
+    int setup_failed;
+    BatchOutput o;
+} Sweep;
+
+static int sweep_header(Sweep *sw, const char *line) {
+    const char *p = line;
+    int *slots = NULL;
+    while (*p) {
+        while (*p && (isspace((unsigned char)*p) || *p == ',')) p++;
+        if (!*p) break;
+        const char *name = p;
+        if (!is_identifier_char(*p)) {
+            fprintf(stderr, "line %lu: column names must be identifiers\n", sw->lineno);
+            free(slots);
+            return 0;
+        }
+        while (is_identifier_char(*p) || isdigit((unsigned char)*p) || *p == '.') p++;
+        size_t len = (size_t)(p - name);
+        if (registry_lookup(name, len).kind != SYM_NONE) {
+            fprintf(stderr, "line %lu: column name is a built-in: %.*s\n", sw->lineno, (int)len, name);
+            free(slots);
+            return 0;
+        }
+        int slot = var_intern(&sw->ctx->vars, name, len);
+        for (int c = 0; c < sw->ncols; ++c) {
+            if (slots[c] == slot) {
+                fprintf(stderr, "line %lu: duplicate column: %.*s\n", sw->lineno, (int)len, name);
+                free(slots);
+                return 0;
+            }
+        }
+        sw->ctx->vars.defined[slot] = 1; // lets the expression resolve it
+        slots = (int*)realloc(slots, sizeof(int) * (size_t)(sw->ncols + 1));
+        if (!slots) { perror("realloc"); exit(1); }
+        slots[sw->ncols++] = slot;
+    }
+    if (sw->ncols == 0) {
+        fprintf(stderr, "line %lu: no column names\n", sw->lineno);
+        return 0;
+    }
+
+    CalcContext *ctx = sw->ctx;
+    calc_begin(ctx);
+    if (assignment_target(sw->expr, NULL, NULL)) calc_error(ctx, "--sweep takes an expression, not an assignment");
+    else if (compile_line(ctx, sw->expr, &sw->prog) != CALC_OK && !ctx->error[0]) calc_error(ctx, "Invalid expression");
+    if (ctx->error[0]) {
+        fprintf(stderr, "%s\n", ctx->error);
+        free(slots);
+        return 0;
+    }
+
+    sw->cols = (double**)malloc(sizeof(double*) * (size_t)sw->ncols);
+    sw->bind = (const double**)calloc((size_t)ctx->vars.count, sizeof(double*));
+    sw->lines = (unsigned long*)malloc(sizeof(unsigned long) * SWEEP_ROWS);
+    sw->bad = (unsigned char*)malloc(SWEEP_ROWS);
+    sw->out = (double*)malloc(sizeof(double) * SWEEP_ROWS);
+    sw->fail = (int*)malloc(sizeof(int) * SWEEP_ROWS);
+    if (!sw->cols || !sw->bind || !sw->lines || !sw->bad || !sw->out || !sw->fail) { perror("malloc"); exit(1); }
+    for (int c = 0; c < sw->ncols; ++c) {
+        sw->cols[c] = (double*)malloc(sizeof(double) * SWEEP_ROWS);
+        if (!sw->cols[c]) { perror("malloc"); exit(1); }
+        sw->bind[slots[c]] = sw->cols[c];
+    }
+    free(slots);
+    return 1;
+}
+
+// Parses one row into the columns; 0 unless it holds exactly ncols numbers.
+static int sweep_row(Sweep *sw, const char *p, const char *end) {
+    for (int c = 0; c < sw->ncols; ++c) {
+        while (p < end && (isspace((unsigned char)*p) || *p == ',')) p++;
+        int neg = 0;
+        if (p < end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+        if (p == end || !(isdigit((unsigned char)*p) || (*p == '.' && p + 1 < end && isdigit((unsigned char)p[1])))) return 0;
+        double v;
+        p += scan_number(p, (size_t)(end - p), &v);
+        sw->cols[c][sw->rows] = neg ? -v : v;
+    }
+    while (p < end && (isspace((unsigned char)*p) || *p == ',')) p++;
+    return p == end;
+}
+
+static void sweep_flush(Sweep *sw) {
+    eval_columns(sw->ctx, &sw->prog, sw->bind, sw->rows, sw->out, sw->fail);
+    for (size_t r = 0; r < sw->rows; ++r) {
+        if (!sw->bad[r] && !sw->fail[r]) {
+            CalcValue v = { sw->out[r], 0, 0 };
+            batch_write_result(&sw->o.out, &v, &sw->ctx->format);
+            continue;
+        }
+        if (sw->bad[r]) calc_error(sw->ctx, "expected %d numbers", sw->ncols);
+        else program_error(sw->ctx, &sw->prog, sw->fail[r]);
+        sw->o.failed = 1;
+        outbuf_write(&sw->o.out, "error\n", 6);
+        char *p = outbuf_reserve(&sw->o.err, CALC_ERROR_LEN + 32);
+        sw->o.err.len += (size_t)snprintf(p, CALC_ERROR_LEN + 32, "line %lu: %s\n", sw->lines[r], sw->ctx->error);
+    }
+    sw->rows = 0;
+}
+
+static int sweep_block(void *arg, char *text, size_t len) {
+    Sweep *sw = (Sweep*)arg;
+    char *p = text, *end = text + len;
+    while (p < end) {
+        char *nl = (char*)memchr(p, '\n', (size_t)(end - p));
+        if (!nl) nl = end;
+        char *line_end = nl;
+        if (line_end > p && line_end[-1] == '\r') line_end--;
+        *line_end = '\0';
+        sw->lineno++;
+        const char *q = p;
+        while (q < line_end && isspace((unsigned char)*q)) q++;
+        if (q < line_end) {
+            if (!sw->ncols) {
+                if (!sweep_header(sw, q)) { sw->setup_failed = 1; return 0; }
+            } else {
+                // a row that does not parse is kept, as NaN, so output stays aligned
+                sw->bad[sw->rows] = !sweep_row(sw, q, line_end);
+                if (sw->bad[sw->rows])
+                    for (int c = 0; c < sw->ncols; ++c) sw->cols[c][sw->rows] = NAN;
+                sw->lines[sw->rows++] = sw->lineno;
+                if (sw->rows == SWEEP_ROWS) sweep_flush(sw);
+            }
+        }
+        p = nl + 1;
+    }
+    return 1;
+}
+
+int run_sweep(CalcContext *ctx, const char *expr, FILE *in) {
+    Sweep sw;
+    memset(&sw, 0, sizeof(sw));
+    sw.ctx = ctx;
+    sw.expr = expr;
+    batch_output_init(&sw.o, stdout, stderr);
+    int read_failed = read_text_blocks(in, sweep_block, &sw);
+    if (sw.rows) sweep_flush(&sw);
+    int failed = sw.o.failed;
+    batch_output_free(&sw.o);
+    for (int c = 0; sw.cols && c < sw.ncols; ++c) free(sw.cols[c]);
+    free(sw.cols);
+    free(sw.bind);
+    free(sw.lines);
+    free(sw.bad);
+    free(sw.out);
+    free(sw.fail);
+    if (sw.setup_failed) return 2;
+    if (!sw.ncols) { fprintf(stderr, "--sweep: no header line\n"); return 2; }
+    return read_failed || failed;
+}
+
+/* ---------- Parallel batch mode ---------- */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CALC_HAVE_PARALLEL 1
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+/*
+  A regular input file is mapped and cut into newline-aligned chunks.
+  Workers claim chunks in order, each with its own copy of the session's
+  CalcContext, and keep their output in memory; the main thread writes
+  finished chunks in input order, and workers stay at most
+  PARALLEL_WINDOW chunks ahead of it.
+
+  Commands and assignments change session state, so workers never run
+  them: a worker stops at the first such line it meets and the main thread
+  evaluates the rest of the file sequentially from there.
+*/
+
+#define PARALLEL_CHUNK_SIZE (4 << 20)
+#define PARALLEL_WINDOW(threads) (2 * (threads))
+
+typedef struct {
+    const char *begin, *end;  // slice of the mapping, ends after a newline
+    const char *stop;         // first unprocessed line, when a worker bailed out
+    unsigned long lines;      // lines the worker handled
+    BatchOutput output;
+    int done;
+} BatchChunk;
+
+typedef struct {
+    BatchChunk *chunks;
+    int nchunks;
+    int next;      // next chunk to claim
+    int written;   // chunks already written by the main thread
+    int window;
+    int cancel;    // a chunk stopped early: later chunks are not needed
+    const CalcContext *session; // state every worker starts from
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BatchPool;
+
+typedef struct {
+    BatchPool *pool;
+    CalcContext ctx; // kept until the worker is joined, for its profile
+    pthread_t thread;
+} BatchWorker;
+
+static void batch_chunk_run(CalcContext *ctx, BatchChunk *ch, char **linebuf, size_t *linecap) {
+    const char *p = ch->begin;
+    while (p < ch->end) {
+        const char *nl = (const char*)memchr(p, '\n', (size_t)(ch->end - p));
+        if (!nl) nl = ch->end;
+        size_t len = (size_t)(nl - p);
+        if (len + 1 > *linecap) {
+            while (len + 1 > *linecap) *linecap *= 2;
+            *linebuf = (char*)realloc(*linebuf, *linecap);
+            if (!*linebuf) { perror("realloc"); exit(1); }
+        }
+        memcpy(*linebuf, p, len); // the mapping is read-only; lines are short
+        if (batch_line(ctx, *linebuf, len, ch->lines + 1, 1, &ch->output) == LINE_STATEFUL) {
+            ch->stop = p;
+            return;
+        }
+        ch->lines++;
+        p = nl + 1;
+    }
+}
+
+static void *batch_worker_main(void *arg) {
+    BatchWorker *self = (BatchWorker*)arg;
+    BatchPool *pool = self->pool;
+    CalcContext *ctx = &self->ctx;
+    calc_init_copy(ctx, pool->session);
+    size_t linecap = 256;
+    char *linebuf = (char*)malloc(linecap);
+    if (!linebuf) { perror("malloc"); exit(1); }
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->cancel && pool->next < pool->nchunks) {
+        if (pool->next >= pool->written + pool->window) {
+            pthread_cond_wait(&pool->cond, &pool->lock);
+            continue;
+        }
+        BatchChunk *ch = &pool->chunks[pool->next++];
+        pthread_mutex_unlock(&pool->lock);
+
+        batch_output_init(&ch->output, NULL, NULL);
+        batch_chunk_run(ctx, ch, &linebuf, &linecap);
+
+        pthread_mutex_lock(&pool->lock);
+        ch->done = 1;
+        if (ch->stop) pool->cancel = 1;
+        pthread_cond_broadcast(&pool->cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    free(linebuf);
+    return NULL;
+}
+
+// Writes a worker's messages with its chunk-local line numbers rebased.
+static void batch_write_errors(const OutBuf *err, unsigned long base) {
+    const char *p = err->buf, *end = err->buf + err->len;
+    while (p < end) {
+        const char *nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        char *rest;
+        unsigned long local = strtoul(p + 5, &rest, 10); // "line N: ..."
+        fprintf(stderr, "line %lu%.*s\n", base + local, (int)(nl - rest), rest);
+        p = nl + 1;
+    }
+}
+
+int run_batch_parallel(CalcContext *ctx, const char *text, size_t size, int threads) {
+    BatchPool pool;
+    pool.nchunks = (int)((size + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE);
+    pool.chunks = (BatchChunk*)calloc((size_t)pool.nchunks, sizeof(BatchChunk));
+    if (!pool.chunks) { perror("calloc"); exit(1); }
+    const char *p = text, *end = text + size;
+    int n = 0;
+    while (p < end) {
+        const char *cut = p + PARALLEL_CHUNK_SIZE < end ? p + PARALLEL_CHUNK_SIZE : end;
+        const char *nl = (const char*)memchr(cut - 1, '\n', (size_t)(end - cut + 1));
+        cut = nl ? nl + 1 : end;
+        pool.chunks[n].begin = p;
+        pool.chunks[n].end = cut;
+        n++;
+        p = cut;
+    }
+    pool.nchunks = n;
+    pool.next = pool.written = pool.cancel = 0;
+    pool.window = PARALLEL_WINDOW(threads);
+    pool.session = ctx;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.cond, NULL);
+
+    BatchWorker *workers = (BatchWorker*)malloc(sizeof(BatchWorker) * threads);
+    if (!workers) { perror("malloc"); exit(1); }
+    for (int i = 0; i < threads; ++i) {
+        workers[i].pool = &pool;
+        if (pthread_create(&workers[i].thread, NULL, batch_worker_main, &workers[i]) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    }
+
+    unsigned long lineno = 0;
+    int failed = 0;
+    const char *rest = NULL;
+    for (int i = 0; i < pool.nchunks && !rest; ++i) {
+        BatchChunk *ch = &pool.chunks[i];
+        pthread_mutex_lock(&pool.lock);
+        while (!ch->done) pthread_cond_wait(&pool.cond, &pool.lock);
+        pthread_mutex_unlock(&pool.lock);
+
+        fwrite(ch->output.out.buf, 1, ch->output.out.len, stdout);
+        batch_write_errors(&ch->output.err, lineno);
+        failed |= ch->output.failed;
+        lineno += ch->lines;
+        rest = ch->stop;
+        batch_output_free(&ch->output);
+
+        pthread_mutex_lock(&pool.lock);
+        pool.written = i + 1;
+        pthread_cond_broadcast(&pool.cond);
+        pthread_mutex_unlock(&pool.lock);
+    }
+
+    for (int i = 0; i < threads; ++i) {
+        pthread_join(workers[i].thread, NULL);
+        calc_profile_merge(ctx, &workers[i].ctx);
+        calc_free(&workers[i].ctx);
+    }
+    for (int i = 0; i < pool.nchunks; ++i)
+        if (pool.chunks[i].done && pool.chunks[i].output.out.buf) batch_output_free(&pool.chunks[i].output);
+
+    if (rest) {
+        // finish from the first command on, in order, with the main context
+        size_t len = (size_t)(end - rest);
+        char *copy = (char*)malloc(len + 1);
+        if (!copy) { perror("malloc"); exit(1); }
+        memcpy(copy, rest, len);
+        BatchOutput o;
+        batch_output_init(&o, stdout, stderr);
+        batch_text(ctx, copy, len, &lineno, &o);
+        failed |= o.failed;
+        batch_output_free(&o);
+        free(copy);
+    }
+
+    pthread_cond_destroy(&pool.cond);
+    pthread_mutex_destroy(&pool.lock);
+    free(workers);
+    free(pool.chunks);
+    return failed;
+}
+
+int is_regular_file(int fd) {
+    struct stat st;
+    return fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+}
+
+// Maps fd when it is a regular file big enough to split; returns -1 if
+// the caller should stream it instead.
+int run_batch_mapped(CalcContext *ctx, int fd, int threads) {
+    struct stat st;
+    if (threads < 2 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return -1;
+    if (st.st_size < 2 * (off_t)PARALLEL_CHUNK_SIZE) return -1;
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) return -1;
+    madvise(map, size, MADV_SEQUENTIAL);
+    fflush(stdout);
+    int rc = run_batch_parallel(ctx, (const char*)map, size, threads);
+    fflush(stdout);
+    munmap(map, size);
+    return rc;
+}
+
+/* ---------- Streaming pipeline ---------- */
+
+/*
+  For unbounded input that cannot be mapped (a pipe or terminal stream):
+  one reader thread cuts lines into batches, N workers evaluate them and
+  the main thread writes results. Stages talk through single-producer /
+  single-consumer rings: reader -> worker i, worker i -> writer, and
+  writer -> reader for recycling. Batches come from a fixed pool, so a slow
+  writer stalls the reader instead of growing memory.
+
+  Batches are dealt to workers round-robin and collected in the same order,
+  which keeps output in input order. Commands and assignments change
+  session state, of which every worker has its own copy, so such a line is
+  a barrier: the reader waits until the whole pool is back, deals that line
+  alone to every worker (the writer keeps the first one's output), and
+  waits again before dealing more lines.
+*/
+
+#include <stdatomic.h>
+#include <sched.h>
+
+#define PIPE_RING_SIZE 256      // power of two, larger than any pool
+#define PIPE_MAX_THREADS 60
+#define PIPE_BATCH_BYTES (64 * 1024)
+#define PIPE_POOL(threads) (4 * (threads) + 4)
+
+typedef struct {
+    _Atomic size_t head;        // next slot to pop, owned by the consumer
+    char pad[64 - sizeof(size_t)];
+    _Atomic size_t tail;        // next slot to fill, owned by the producer
+    void *slots[PIPE_RING_SIZE];
+} SpscRing;
+
+static void ring_init(SpscRing *r) {
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+}
+
+// The ring never holds more than the whole pool, so push cannot fail.
+static void ring_push(SpscRing *r, void *item) {
+    size_t t = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    r->slots[t & (PIPE_RING_SIZE - 1)] = item;
+    atomic_store_explicit(&r->tail, t + 1, memory_order_release);
+}
+
+static void *ring_try_pop(SpscRing *r) {
+    size_t h = atomic_load_explicit(&r->head, memory_order_relaxed);
+    if (h == atomic_load_explicit(&r->tail, memory_order_acquire)) return NULL;
+    void *item = r->slots[h & (PIPE_RING_SIZE - 1)];
+    atomic_store_explicit(&r->head, h + 1, memory_order_release);
+    return item;
+}
+
+static void *ring_pop(SpscRing *r) {
+    void *item;
+    while (!(item = ring_try_pop(r))) sched_yield();
+    return item;
+}
+
+typedef struct {
+    int end;                  // no more input after this batch
+    int replay;               // a stateful line for another worker's copy: output unused
+    unsigned long first_line; // line number of the first line in text
+    OutBuf text;              // lines, each ending in '\n'
+    BatchOutput output;
+} PipeBatch;
+
+typedef struct {
+    int fd;
+    int threads;
+    int pool;
+    const CalcContext *session; // state every worker starts from
+    SpscRing *to_worker;      // [threads]
+    SpscRing *to_writer;      // [threads]
+    SpscRing free_batches;
+} Pipeline;
+
+// Free batches the reader has taken back from the pool but not used yet.
+typedef struct {
+    PipeBatch **items;
+    int count;
+} PipeStash;
+
+typedef struct {
+    Pipeline *pipe;
+    int index;
+    CalcContext ctx; // kept until the worker is joined, for its profile
+    pthread_t thread;
+} PipeWorker;
+
+static PipeBatch *pipe_take(Pipeline *p, PipeStash *stash) {
+    PipeBatch *b = stash->count ? stash->items[--stash->count] : (PipeBatch*)ring_pop(&p->free_batches);
+    b->end = b->replay = 0;
+    b->text.len = 0;
+    b->output.out.len = b->output.err.len = 0;
+    b->output.failed = 0;
+    return b;
+}
+
+// Waits until every batch is back: no worker is evaluating anything.
+static void pipe_drain(Pipeline *p, PipeStash *stash, PipeBatch *held) {
+    int missing = p->pool - stash->count - (held ? 1 : 0);
+    while (missing-- > 0) stash->items[stash->count++] = (PipeBatch*)ring_pop(&p->free_batches);
+}
+
+static void pipe_send(Pipeline *p, int *next_worker, PipeBatch *b) {
+    ring_push(&p->to_worker[*next_worker], b);
+    *next_worker = (*next_worker + 1) % p->threads;
+}
+
+static void *pipe_reader_main(void *arg) {
+    Pipeline *p = (Pipeline*)arg;
+    size_t cap = BATCH_READ_SIZE, have = 0;
+    char *buf = (char*)malloc(cap + 1);
+    if (!buf) { perror("malloc"); exit(1); }
+    int next_worker = 0, quit = 0;
+    unsigned long lineno = 0;
+    PipeBatch *b = NULL;
+    PipeStash stash;
+    stash.items = (PipeBatch**)malloc(sizeof(PipeBatch*) * p->pool);
+    if (!stash.items) { perror("malloc"); exit(1); }
+    stash.count = 0;
+
+    while (!quit) {
+        if (have == cap) {
+            cap *= 2;
+            buf = (char*)realloc(buf, cap + 1);
+            if (!buf) { perror("realloc"); exit(1); }
+        }
+        ssize_t n = read(p->fd, buf + have, cap - have);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) perror("read");
+        int eof = n <= 0;
+        if (n > 0) have += (size_t)n;
+        if (eof && have && buf[have-1] != '\n') buf[have++] = '\n'; // buf has one spare byte
+
+        char *line = buf, *end = buf + have, *nl;
+        while (!quit && (nl = (char*)memchr(line, '\n', (size_t)(end - line)))) {
+            size_t len = (size_t)(nl - line);
+            if (!b) {
+                b = pipe_take(p, &stash);
+                b->first_line = lineno + 1;
+            }
+            // classify on a trimmed, terminated copy of the line
+            char *s = line;
+            size_t slen = len;
+            while (slen && isspace((unsigned char)*s)) { s++; slen--; }
+            if (slen && s[slen-1] == '\r') slen--;
+            char saved = s[slen];
+            s[slen] = '\0';
+            const Command *c = find_command(s);
+            int stateful = c || assignment_target(s, NULL, NULL);
+            s[slen] = saved;
+            lineno++;
+
+            if (c && c->run == cmd_quit) {
+                quit = 1;
+            } else if (stateful) {
+                // flush pending lines, then run the command on every
+                // worker with the pipeline idle on both sides of it
+                if (b->text.len) {
+                    pipe_send(p, &next_worker, b);
+                    b = NULL;
+                }
+                pipe_drain(p, &stash, b);
+                for (int w = 0; w < p->threads; ++w) {
+                    if (!b) b = pipe_take(p, &stash);
+                    b->first_line = lineno;
+                    b->replay = w > 0;
+                    outbuf_write(&b->text, line, len + 1);
+                    pipe_send(p, &next_worker, b);
+                    b = NULL;
+                }
+                pipe_drain(p, &stash, NULL);
+            } else {
+                outbuf_write(&b->text, line, len + 1);
+                if (b->text.len >= PIPE_BATCH_BYTES) {
+                    pipe_send(p, &next_worker, b);
+                    b = NULL;
+                }
+            }
+            line = nl + 1;
+        }
+        have = (size_t)(end - line);
+        memmove(buf, line, have);
+        // whatever arrived is sent now, so a live stream is not held back
+        if (b && b->text.len) {
+            pipe_send(p, &next_worker, b);
+            b = NULL;
+        }
+        if (eof) break;
+    }
+
+    // one end marker per worker, in round-robin order
+    for (int w = 0; w < p->threads; ++w) {
+        if (!b) b = pipe_take(p, &stash);
+        b->end = 1;
+        pipe_send(p, &next_worker, b);
+        b = NULL;
+    }
+    free(stash.items);
+    free(buf);
+    return NULL;
+}
+
+static void *pipe_worker_main(void *arg) {
+    PipeWorker *self = (PipeWorker*)arg;
+    Pipeline *p = self->pipe;
+    CalcContext *ctx = &self->ctx;
+    calc_init_copy(ctx, p->session);
+
+    for (;;) {
+        PipeBatch *b = (PipeBatch*)ring_pop(&p->to_worker[self->index]);
+        int end = b->end; // b belongs to the writer once pushed
+        if (!end) {
+            unsigned long lineno = b->first_line - 1;
+            batch_text(ctx, b->text.buf, b->text.len, &lineno, &b->output);
+        }
+        ring_push(&p->to_writer[self->index], b);
+        if (end) break;
+    }
+    return NULL;
+}
+
+static void write_all(int fd, const char *s, size_t n) {
+    while (n) {
+        ssize_t w = write(fd, s, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) { perror("write"); exit(1); }
+        s += w;
+        n -= (size_t)w;
+    }
+}
+
+int run_batch_pipeline(CalcContext *ctx, int fd, int threads) {
+    if (threads > PIPE_MAX_THREADS) threads = PIPE_MAX_THREADS;
+    Pipeline p;
+    p.session = ctx;
+    p.fd = fd;
+    p.threads = threads;
+    p.to_worker = (SpscRing*)malloc(sizeof(SpscRing) * threads);
+    p.to_writer = (SpscRing*)malloc(sizeof(SpscRing) * threads);
+    PipeWorker *workers = (PipeWorker*)malloc(sizeof(PipeWorker) * threads);
+    int pool = p.pool = PIPE_POOL(threads);
+    PipeBatch *batches = (PipeBatch*)malloc(sizeof(PipeBatch) * pool);
+    if (!p.to_worker || !p.to_writer || !workers || !batches) { perror("malloc"); exit(1); }
+
+    ring_init(&p.free_batches);
+    for (int i = 0; i < pool; ++i) {
+        outbuf_init(&batches[i].text, NULL, PIPE_BATCH_BYTES + 4096);
+        batch_output_init(&batches[i].output, NULL, NULL);
+        ring_push(&p.free_batches, &batches[i]);
+    }
+    for (int w = 0; w < threads; ++w) {
+        ring_init(&p.to_worker[w]);
+        ring_init(&p.to_writer[w]);
+        workers[w].pipe = &p;
+        workers[w].index = w;
+        if (pthread_create(&workers[w].thread, NULL, pipe_worker_main, &workers[w]) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    }
+    pthread_t reader;
+    if (pthread_create(&reader, NULL, pipe_reader_main, &p) != 0) { perror("pthread_create"); exit(1); }
+
+    // this thread is the writer
+    fflush(stdout);
+    int failed = 0;
+    for (int w = 0; ; w = (w + 1) % threads) {
+        PipeBatch *b = (PipeBatch*)ring_pop(&p.to_writer[w]);
+        if (b->end) break;
+        if (!b->replay) {
+            write_all(STDOUT_FILENO, b->output.out.buf, b->output.out.len);
+            if (b->output.err.len) write_all(STDERR_FILENO, b->output.err.buf, b->output.err.len);
+            failed |= b->output.failed;
+        }
+        ring_push(&p.free_batches, b);
+    }
+
+    pthread_join(reader, NULL);
+    for (int w = 0; w < threads; ++w) {
+        pthread_join(workers[w].thread, NULL);
+        calc_profile_merge(ctx, &workers[w].ctx);
+        calc_free(&workers[w].ctx);
+    }
+    for (int i = 0; i < pool; ++i) {
+        outbuf_free(&batches[i].text);
+        batch_output_free(&batches[i].output);
+    }
+    free(batches);
+    free(workers);
+    free(p.to_writer);
+    free(p.to_worker);
+    return failed;
+}
+
+int default_thread_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+#else
+int default_thread_count(void) { return 1; }
+#endif
+
+/* ---------- Vector math accuracy ---------- */
+
+/*
+  --accuracy checks every vector kernel against libm on random arguments
+  and prints the largest error seen, in units in the last place. It exits
+  nonzero if a kernel goes past the bound documented in Vector math.
+*/
+
+#define ACCURACY_SAMPLES 1000000
+#define ACCURACY_CHUNK 4096
+
+typedef struct {
+    const char *name;
+    VmathFn vec;
+    void (*vec2)(const double *, const double *, double *, int);
+    double (*ref)(double);
+    double (*ref2)(double, double);
+    double lo, hi;      // x range
+    int log_scale;      // x = 10^u with u uniform in [lo, hi]
+    double ylo, yhi;    // y range for pow
+    int bound;          // documented maximum, in ulps
+} AccuracyCase;
+
+static const AccuracyCase accuracy_cases[] = {
+    {"exp", vmath_exp, NULL, exp, NULL, -1, 1, 0, 0, 0, 1},
+    {"exp", vmath_exp, NULL, exp, NULL, -708, 709, 0, 0, 0, 1},
+    {"ln", vmath_log, NULL, log, NULL, 0.5, 2, 0, 0, 0, 1},
+    {"ln", vmath_log, NULL, log, NULL, -300, 300, 1, 0, 0, 1},
+    {"log", vmath_log10, NULL, log10, NULL, 0.5, 2, 0, 0, 0, 2},
+    {"log", vmath_log10, NULL, log10, NULL, -300, 300, 1, 0, 0, 2},
+    {"sin", vmath_sin, NULL, sin, NULL, -4, 4, 0, 0, 0, 1},
+    {"sin", vmath_sin, NULL, sin, NULL, -1e6, 1e6, 0, 0, 0, 1},
+    {"cos", vmath_cos, NULL, cos, NULL, -4, 4, 0, 0, 0, 1},
+    {"cos", vmath_cos, NULL, cos, NULL, -1e6, 1e6, 0, 0, 0, 1},
+    {"tan", vmath_tan, NULL, tan, NULL, -4, 4, 0, 0, 0, 2},
+    {"tan", vmath_tan, NULL, tan, NULL, -1e6, 1e6, 0, 0, 0, 2},
+    {"asin", vmath_asin, NULL, asin, NULL, -1, 1, 0, 0, 0, 1},
+    {"acos", vmath_acos, NULL, acos, NULL, -1, 1, 0, 0, 0, 1},
+    {"atan", vmath_atan, NULL, atan, NULL, -4, 4, 0, 0, 0, 1},
+    {"atan", vmath_atan, NULL, atan, NULL, -300, 300, 1, 0, 0, 1},
+    {"sinh", vmath_sinh, NULL, sinh, NULL, -2, 2, 0, 0, 0, 2},
+    {"sinh", vmath_sinh, NULL, sinh, NULL, -709, 709, 0, 0, 0, 2},
+    {"cosh", vmath_cosh, NULL, cosh, NULL, -2, 2, 0, 0, 0, 2},
+    {"cosh", vmath_cosh, NULL, cosh, NULL, -709, 709, 0, 0, 0, 2},
+    {"tanh", vmath_tanh, NULL, tanh, NULL, -2, 2, 0, 0, 0, 3},
+    {"tanh", vmath_tanh, NULL, tanh, NULL, -30, 30, 0, 0, 0, 3},
+    {"pow", NULL, vmath_pow, NULL, pow, 0.5, 2, 0, -100, 100, 3},
+    {"pow", NULL, vmath_pow, NULL, pow, -3, 3, 1, -100, 100, 3},
+};
+
+static uint64_t accuracy_next(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return *state = x;
+}
+
+static double accuracy_uniform(uint64_t *state, double lo, double hi) {
+    return lo + (hi - lo) * ((double)(accuracy_next(state) >> 11) * 0x1p-53);
+}
+
+// Distance between two doubles counted in representable values.
+static uint64_t ulp_distance(double a, double b) {
+    if (a != a || b != b) return a != a && b != b ? 0 : UINT64_MAX;
+    int64_t ia = (int64_t)vm_bits(a), ib = (int64_t)vm_bits(b);
+    if (ia < 0) ia = INT64_MIN - ia;
+    if (ib < 0) ib = INT64_MIN - ib;
+    return ia > ib ? (uint64_t)ia - (uint64_t)ib : (uint64_t)ib - (uint64_t)ia;
+}
+
+int run_accuracy(void) {
+    static double x[ACCURACY_CHUNK], y[ACCURACY_CHUNK], out[ACCURACY_CHUNK];
+    int failed = 0;
+    printf("%-6s %-22s %10s %6s\n", "func", "range", "max ulp", "bound");
+    for (size_t c = 0; c < sizeof accuracy_cases / sizeof accuracy_cases[0]; ++c) {
+        const AccuracyCase *t = &accuracy_cases[c];
+        uint64_t state = 0x9e3779b97f4a7c15ULL + c, worst = 0;
+        double worst_x = 0, worst_y = 0;
+        for (int done = 0; done < ACCURACY_SAMPLES; done += ACCURACY_CHUNK) {
+            for (int i = 0; i < ACCURACY_CHUNK; ++i) {
+                double u = accuracy_uniform(&state, t->lo, t->hi);
+                x[i] = t->log_scale ? pow(10.0, u) : u;
+                y[i] = t->vec2 ? accuracy_uniform(&state, t->ylo, t->yhi) : 0.0;
+            }
+            if (t->vec2) t->vec2(x, y, out, ACCURACY_CHUNK);
+            else t->vec(x, out, ACCURACY_CHUNK);
+            for (int i = 0; i < ACCURACY_CHUNK; ++i) {
+                uint64_t d = ulp_distance(out[i], t->vec2 ? t->ref2(x[i], y[i]) : t->ref(x[i]));
+                if (d > worst) { worst = d; worst_x = x[i]; worst_y = y[i]; }
+            }
+        }
+        char range[64];
+        snprintf(range, sizeof range, t->log_scale ? "[1e%g, 1e%g]" : "[%g, %g]", t->lo, t->hi);
+        printf("%-6s %-22s %10llu %6d", t->name, range, (unsigned long long)worst, t->bound);
+        if (worst > (uint64_t)t->bound) {
+            printf("  FAIL at x=%.17g", worst_x);
+            if (t->vec2) printf(" y=%.17g", worst_y);
+            failed = 1;
+        }
+        printf("\n");
+    }
+    return failed;
+}
+
+/* ---------- JIT check ---------- */
+
+/*
+  --jit-check: compiles random expressions over every operator and
+  built-in, then runs each one through the JIT and the interpreter with
+  special and random variable values in both angle modes. Any difference
+  in the bits of a result, or in an error, is a failure.
+*/
+
+#define JIT_CHECK_EXPRESSIONS 20000
+#define JIT_CHECK_DEPTH 5
+
+static const char *const jit_check_leaves[] = {
+    "x", "y", "z", "M", "0", "1", "2", "3", "0.5", "-0", "pi", "e", "180", "1e308", "1e-310",
+};
+
+static const double jit_check_values[] = {
+    0.0, -0.0, 1.0, -1.0, 0.5, 2.0, -3.75, 12.0, 170.0, 171.0, 1e300, -1e-300, 5e-324,
+    INFINITY, -INFINITY, NAN,
+};
+
+#define JIT_CHECK_COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+// Appends a random expression to buf.
+static void jit_check_expr(uint64_t *state, char *buf, size_t cap, int depth) {
+    size_t len = strlen(buf);
+    uint64_t r = accuracy_next(state);
+    int kind = depth >= JIT_CHECK_DEPTH ? 0 : (int)(r % 8);
+    r >>= 8;
+    if (kind < 2) {
+        snprintf(buf + len, cap - len, "%s", jit_check_leaves[r % JIT_CHECK_COUNT(jit_check_leaves)]);
+    } else if (kind < 5) {
+        snprintf(buf + len, cap - len, "(");
+        jit_check_expr(state, buf, cap, depth + 1);
+        len = strlen(buf);
+        snprintf(buf + len, cap - len, "%c", "+-*/%^"[r % 6]);
+        jit_check_expr(state, buf, cap, depth + 1);
+        len = strlen(buf);
+        snprintf(buf + len, cap - len, ")");
+    } else if (kind == 5) {
+        snprintf(buf + len, cap - len, "-");
+        jit_check_expr(state, buf, cap, depth + 1);
+    } else {
+        const FuncInfo *f = &func_info[r % FN_COUNT];
+        snprintf(buf + len, cap - len, "%s(", f->name);
+        for (int k = 0; k < f->arity; ++k) {
+            if (k) { len = strlen(buf); snprintf(buf + len, cap - len, ","); }
+            jit_check_expr(state, buf, cap, depth + 1);
+        }
+        len = strlen(buf);
+        snprintf(buf + len, cap - len, ")");
+    }
+}
+
+int run_jit_check(void) {
+#ifdef CALC_HAVE_JIT
+    int saved_capacity = program_cache_capacity;
+    program_cache_capacity = 0;
+    CalcContext ctx;
+    calc_init(&ctx);
+    program_cache_capacity = saved_capacity;
+
+    VarTable *vars = &ctx.vars;
+    int slots[3] = { var_intern(vars, "x", 1), var_intern(vars, "y", 1), var_intern(vars, "z", 1) };
+    for (int k = 0; k < 3; ++k) vars->defined[slots[k]] = 1;
+
+    uint64_t state = 0x2545f4914f6cdd1dULL;
+    unsigned long compiled = 0, runs = 0, mismatches = 0;
+    char expr[4096];
+    for (int n = 0; n < JIT_CHECK_EXPRESSIONS; ++n) {
+        expr[0] = '\0';
+        jit_check_expr(&state, expr, sizeof expr, 0);
+        calc_begin(&ctx);
+        Program prog;
+        ExecBlock code;
+        if (compile_line(&ctx, expr, &prog) != CALC_OK || !jit_compile(&prog, &code)) continue;
+        compiled++;
+        for (int trial = 0; trial < 32; ++trial) {
+            for (int k = 0; k < 3; ++k) {
+                uint64_t r = accuracy_next(&state);
+                vars->values[slots[k]] = r & 1 ? accuracy_uniform(&state, -50, 50)
+                                               : jit_check_values[(r >> 1) % JIT_CHECK_COUNT(jit_check_values)];
+            }
+            ctx.memory = jit_check_values[trial % JIT_CHECK_COUNT(jit_check_values)];
+            ctx.angle_mode = trial & 1 ? MODE_DEG : MODE_RAD;
+
+            double want = 0, got = 0;
+            char want_error[CALC_ERROR_LEN];
+            prog.jit = NULL;
+            ctx.error[0] = '\0';
+            int want_ok = run_program(&ctx, &prog, &want);
+            memcpy(want_error, ctx.error, sizeof want_error);
+            prog.jit = (JitFn)(void*)code.code;
+            ctx.error[0] = '\0';
+            int got_ok = run_program(&ctx, &prog, &got);
+            runs++;
+            if (got_ok != want_ok || (want_ok ? vm_bits(got) != vm_bits(want) : strcmp(ctx.error, want_error) != 0)) {
+                if (mismatches++ < 10) {
+                    printf("mismatch: %s with x=%.17g y=%.17g z=%.17g M=%.17g (%s)\n", expr,
+                           vars->values[slots[0]], vars->values[slots[1]], vars->values[slots[2]],
+                           ctx.memory, ctx.angle_mode == MODE_DEG ? "deg" : "rad");
+                    printf("  interpreter: %s   jit: %s\n", want_ok ? "" : want_error, got_ok ? "" : ctx.error);
+                    if (want_ok && got_ok) printf("  %.17g vs %.17g\n", want, got);
+                }
+            }
+        }
+        exec_free(&code);
+    }
+    calc_free(&ctx);
+    printf("%lu of %d expressions compiled, %lu runs, %lu mismatches\n", compiled, JIT_CHECK_EXPRESSIONS, runs, mismatches);
+    return mismatches != 0;
+#else
+    printf("no JIT on this platform\n");
+    return 0;
+#endif
+}
+
+/* ---------- Context stress test ---------- */
+
+/*
+  --stress: runs a different random session (commands, assignments and
+  expressions that repeat often enough to be cached and compiled) on
+  STRESS_THREADS threads at once, one context each, and compares every
+  thread's output with a run of the same session on its own. Built with
+  -fsanitize=thread, it also lets ThreadSanitizer confirm that contexts
+  share no mutable state:
+
+    gcc -fsanitize=thread -g -O1 calculator.c -o calc-tsan -lm -pthread
+    ./calc-tsan --stress
+*/
+
+#ifdef CALC_HAVE_PARALLEL
+
+#define STRESS_THREADS 8
+#define STRESS_LINES 20000
+
+static const char *const stress_lines[] = {
+    "mode deg", "mode rad", "m+ %d", "m- 0.25", "mc",
+    "a = %d", "b = a * %d + M", "c = sin(a) + cos(b)", "x = %d / 4",
+    "a + b * %d", "sin(%d) + asin(0.5)", "c / (a - %d)", "M * %d + a", "sqrt(b - %d)",
+    "fact(%d) / b", "atan(a) * %d", "x ^ 2 + a", "ln(M) + %d", "nCr(%d, 3) + c", "undefined_name + %d",
+};
+
+typedef struct {
+    char *script;
+    size_t len;
+    int digits;      // format of this session, to tell them apart
+    BatchOutput output;
+    pthread_t thread;
+} StressSession;
+
+static void stress_script(StressSession *s, uint64_t seed) {
+    OutBuf text;
+    outbuf_init(&text, NULL, 4096);
+    for (int i = 0; i < STRESS_LINES; ++i) {
+        uint64_t r = accuracy_next(&seed);
+        char line[64];
+        int n = snprintf(line, sizeof line, stress_lines[r % (sizeof stress_lines / sizeof stress_lines[0])],
+                         (int)(r >> 32) % 12);
+        line[n++] = '\n';
+        outbuf_write(&text, line, (size_t)n);
+    }
+    s->script = text.buf;
+    s->len = text.len;
+}
+
+// Runs the session in a fresh context; out receives what batch mode prints.
+static void stress_run(const StressSession *s, BatchOutput *out) {
+    CalcContext ctx;
+    calc_init(&ctx);
+    ctx.format.digits = s->digits;
+    char *text = (char*)malloc(s->len);
+    if (!text) { perror("malloc"); exit(1); }
+    memcpy(text, s->script, s->len); // batch_text writes into its text
+    unsigned long lineno = 0;
+    batch_output_init(out, NULL, NULL);
+    batch_text(&ctx, text, s->len, &lineno, out);
+    free(text);
+    calc_free(&ctx);
+}
+
+static void *stress_thread_main(void *arg) {
+    StressSession *s = (StressSession*)arg;
+    stress_run(s, &s->output);
+    return NULL;
+}
+
+int run_stress(void) {
+    StressSession sessions[STRESS_THREADS];
+    for (int t = 0; t < STRESS_THREADS; ++t) {
+        stress_script(&sessions[t], 0x9e3779b97f4a7c15ULL * (uint64_t)(t + 1));
+        sessions[t].digits = 6 + t;
+    }
+    for (int t = 0; t < STRESS_THREADS; ++t)
+        if (pthread_create(&sessions[t].thread, NULL, stress_thread_main, &sessions[t]) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    for (int t = 0; t < STRESS_THREADS; ++t) pthread_join(sessions[t].thread, NULL);
+
+    int mismatches = 0;
+    for (int t = 0; t < STRESS_THREADS; ++t) {
+        StressSession *s = &sessions[t];
+        BatchOutput alone;
+        stress_run(s, &alone);
+        int same = alone.out.len == s->output.out.len && alone.err.len == s->output.err.len &&
+                   memcmp(alone.out.buf, s->output.out.buf, alone.out.len) == 0 &&
+                   memcmp(alone.err.buf, s->output.err.buf, alone.err.len) == 0;
+        if (!same) {
+            printf("session %d: output differs from running it alone\n", t);
+            mismatches++;
+        }
+        batch_output_free(&alone);
+        batch_output_free(&s->output);
+        free(s->script);
+    }
+    printf("%d sessions of %d lines on %d threads: %d mismatches\n",
+           STRESS_THREADS, STRESS_LINES, STRESS_THREADS, mismatches);
+    return mismatches != 0;
+}
+#else
+int run_stress(void) {
+    printf("no threads on this platform\n");
+    return 0;
+}
+#endif
+
+/* ---------- Benchmarks ---------- */
+
+#if defined(__linux__)
+#define CALC_HAVE_PERF 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/*
+  --bench [file]: times the pipeline one stage at a time
+  (tokenize_expression, to_rpn and evaluate_rpn, each given the previous
+  stage's output made beforehand) and whole lines through calc_evaluate,
+  with the program cache off and then on, and through calc_evaluate_exact
+  in rational mode. The corpora are generated
+  expressions of three sizes, realistic formulas over a set of variables,
+  and the lines of file if one is given; lines that do not evaluate
+  cleanly are left out.
+
+  Each stage runs over its corpus for at least BENCH_MIN_NS. Time per
+  expression is from the fastest round; heap allocations per expression
+  are counted over all of them. The report is JSON on stdout, so runs of
+  different builds can be compared (make bench writes bench.json).
+  Add --perf for hardware counters (below).
+*/
+
+#define BENCH_MIN_NS 2e8
+#define BENCH_MIN_ROUNDS 3
+
+// Variables the realistic formulas (and a benchmarked file) can use.
+static const struct { const char *name; double value; } bench_vars[] = {
+    {"x", 0.75}, {"y", -1.5}, {"z", 2.25}, {"principal", 250000}, {"rate", 0.045}, {"years", 30},
+    {"g", 9.81}, {"t", 2.5}, {"v0", 12}, {"r", 0.3}, {"h", 1.2}, {"mu", 100}, {"sigma", 15},
+    {"mass", 72.5}, {"height", 1.78}, {"price", 19.99}, {"qty", 3}, {"tax", 0.2}, {"theta", 0.6},
+};
+
+static const char *const bench_realistic[] = {
+    "principal * (1 + rate / 12) ^ (12 * years)",
+    "principal * rate / 12 / (1 - (1 + rate / 12) ^ (-12 * years))",
+    "price * qty * (1 + tax)",
+    "v0 * t - 0.5 * g * t ^ 2",
+    "v0 ^ 2 * sin(2 * theta) / g",
+    "sqrt(x ^ 2 + y ^ 2 + z ^ 2)",
+    "2 * pi * r * (r + h)",
+    "pi * r ^ 2 * h / 3",
+    "exp(-(x - mu) ^ 2 / (2 * sigma ^ 2)) / (sigma * sqrt(2 * pi))",
+    "1 / (1 + exp(-x))",
+    "log(principal) / log(2)",
+    "sin(theta) ^ 2 + cos(theta) ^ 2",
+    "atan(y / x) * 180 / pi",
+    "mass / height ^ 2",
+    "nCr(52, 5) / nCr(13, 2)",
+    "fact(10) / (fact(3) * fact(7))",
+    "gcd(1071, 462) + lcm(4, 6)",
+    "(x + y + z) / 3",
+    "abs(x - y) / (abs(x) + abs(y))",
+    "floor(price * 100 + 0.5) / 100",
+    "cbrt(mass / 1000)",
+    "tanh(x) * cosh(y) - sinh(z)",
+    "ln(1 + rate) * years",
+    "3.5e-3 * 1.2e4 + 0.25 * 16",
+};
+
+static const char *const bench_funcs[] = { "sin", "cos", "atan", "tanh", "abs", "floor", "cbrt" };
+
+#define BENCH_COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    const char *name;
+    char **lines;
+    int count;
+    int dropped; // lines that did not evaluate cleanly
+    size_t bytes;
+} BenchCorpus;
+
+static void bench_define_vars(CalcContext *ctx) {
+    for (size_t i = 0; i < BENCH_COUNT(bench_vars); ++i) {
+        const char *name = bench_vars[i].name;
+        int slot = var_intern(&ctx->vars, name, strlen(name));
+        ctx->vars.values[slot] = bench_vars[i].value;
+        ctx->vars.defined[slot] = 1;
+    }
+}
+
+static void bench_sum(uint64_t *state, OutBuf *out, int budget);
+
+// Appends a number, a variable, a call or a parenthesized sum.
+static void bench_term(uint64_t *state, OutBuf *out, int budget) {
+    uint64_t r = accuracy_next(state);
+    char text[32];
+    int n;
+    if (budget < 8 || r % 4 == 0) {
+        switch ((r >> 8) % 3) {
+        case 0: n = snprintf(text, sizeof text, "%d", 1 + (int)((r >> 16) % 999)); break;
+        case 1: n = snprintf(text, sizeof text, "%.3f", (double)((r >> 16) % 100000) / 1000.0); break;
+        default: n = snprintf(text, sizeof text, "%c", "xyz"[(r >> 16) % 3]); break;
+        }
+        outbuf_write(out, text, (size_t)n);
+        return;
+    }
+    if (r % 4 == 1) {
+        n = snprintf(text, sizeof text, "%s(", bench_funcs[(r >> 8) % BENCH_COUNT(bench_funcs)]);
+        outbuf_write(out, text, (size_t)n);
+        bench_sum(state, out, budget - n - 1);
+    } else {
+        outbuf_write(out, "(", 1);
+        bench_sum(state, out, budget - 2);
+    }
+    outbuf_write(out, ")", 1);
+}
+
+// Appends terms joined by operators, about budget characters in all.
+// Divisors and exponents are literals, so nothing fails.
+static void bench_sum(uint64_t *state, OutBuf *out, int budget) {
+    size_t start = out->len;
+    int left = budget;
+    for (;;) {
+        bench_term(state, out, left / 4 + (int)(accuracy_next(state) % (uint64_t)(left / 4 + 1)));
+        for (;;) {
+            left = budget - (int)(out->len - start);
+            if (left <= 0) return;
+            uint64_t r = accuracy_next(state);
+            char text[32];
+            int n;
+            if (r % 6 == 0) n = snprintf(text, sizeof text, " / %d", 2 + (int)((r >> 8) % 30));
+            else if (r % 6 == 1) n = snprintf(text, sizeof text, "^%d", 2 + (int)((r >> 8) % 2));
+            else n = snprintf(text, sizeof text, " %c ", "+-*+"[(r >> 8) % 4]);
+            outbuf_write(out, text, (size_t)n);
+            if (r % 6 > 1) break; // the operator still needs its right operand
+        }
+    }
+}
+
+static void bench_add_line(BenchCorpus *c, const char *line, size_t len) {
+    if (c->count % 64 == 0) {
+        c->lines = (char**)realloc(c->lines, sizeof(char*) * (size_t)(c->count + 64));
+        if (!c->lines) { perror("realloc"); exit(1); }
+    }
+    char *copy = (char*)malloc(len + 1);
+    if (!copy) { perror("malloc"); exit(1); }
+    memcpy(copy, line, len);
+    copy[len] = '\0';
+    c->lines[c->count++] = copy;
+    c->bytes += len;
+}
+
+static void bench_generate(BenchCorpus *c, const char *name, int count, int budget, uint64_t seed) {
+    memset(c, 0, sizeof(*c));
+    c->name = name;
+    OutBuf text;
+    outbuf_init(&text, NULL, (size_t)budget * 2 + 64);
+    for (int i = 0; i < count; ++i) {
+        text.len = 0;
+        bench_sum(&seed, &text, budget);
+        bench_add_line(c, text.buf, text.len);
+    }
+    outbuf_free(&text);
+}
+
+static int bench_load(BenchCorpus *c, const char *path) {
+    memset(c, 0, sizeof(*c));
+    c->name = "file";
+    FILE *in = fopen(path, "rb");
+    if (!in) { perror(path); return 0; }
+    char line[8192];
+    while (fgets(line, sizeof line, in)) {
+        size_t len = strcspn(line, "\r\n");
+        if (len) bench_add_line(c, line, len);
+    }
+    fclose(in);
+    return 1;
+}
+
+/*
+  Tokenizes and parses every line of c in prep, whose arena is never reset,
+  so the token and RPN arrays stay valid for the later stages. Lines that
+  fail any stage are dropped.
+*/
+static void bench_prepare(CalcContext *prep, BenchCorpus *c, TokenArray *tokens, TokenArray *rpn) {
+    int kept = 0;
+    for (int i = 0; i < c->count; ++i) {
+        char *line = c->lines[i];
+        double result;
+        token_array_init(&tokens[kept], prep, (int)strlen(line) + 1);
+        int ok = !assignment_target(line, NULL, NULL) && tokenize_expression(prep, line, &tokens[kept]);
+        if (ok) {
+            token_array_init(&rpn[kept], prep, tokens[kept].size);
+            ok = to_rpn(prep, &tokens[kept], &rpn[kept]) && evaluate_rpn(prep, &rpn[kept], &result);
+        }
+        if (ok) {
+            c->lines[kept++] = line;
+        } else {
+            c->bytes -= strlen(line);
+            free(line);
+        }
+    }
+    c->dropped = c->count - kept;
+    c->count = kept;
+}
+
+typedef enum {
+    BENCH_TOKENIZE, BENCH_RPN, BENCH_EVALUATE, BENCH_LINE, BENCH_LINE_CACHED, BENCH_LINE_RATIONAL, BENCH_STAGES
+} BenchStage;
+
+static const char *const bench_stage_names[BENCH_STAGES] = {
+    "tokenize", "to_rpn", "evaluate_rpn", "end_to_end", "end_to_end_cached", "end_to_end_rational",
+};
+
+// One pass of stage over the corpus.
+static void bench_round(CalcContext *ctx, BenchStage stage, const BenchCorpus *c,
+                        const TokenArray *tokens, const TokenArray *rpn) {
+    double result;
+    for (int i = 0; i < c->count; ++i) {
+        switch (stage) {
+        case BENCH_TOKENIZE: {
+            TokenArray out;
+            calc_begin(ctx);
+            token_array_init(&out, ctx, (int)strlen(c->lines[i]) + 1);
+            tokenize_expression(ctx, c->lines[i], &out);
+            break;
+        }
+        case BENCH_RPN: {
+            TokenArray out;
+            calc_begin(ctx);
+            token_array_init(&out, ctx, tokens[i].size);
+            to_rpn(ctx, &tokens[i], &out);
+            break;
+        }
+        case BENCH_EVALUATE:
+            calc_begin(ctx);
+            evaluate_rpn(ctx, &rpn[i], &result);
+            break;
+        case BENCH_LINE_RATIONAL: {
+            Number v;
+            calc_evaluate_exact(ctx, c->lines[i], &v);
+            number_free(&v);
+            break;
+        }
+        default: {
+            CalcValue v;
+            calc_evaluate(ctx, c->lines[i], &v);
+            break;
+        }
+        }
+    }
+}
+
+/*
+  --perf (with --bench) also brackets every round with hardware counters
+  from perf_event_open: cycles, instructions, L1 data and last-level
+  cache misses and branch misses, counted in user space for this thread
+  only. They are reported per expression, with IPC, next to the times.
+  An event the CPU or kernel cannot count (virtual machines often have no
+  PMU, and perf_event_paranoid may forbid it) is reported as null.
+*/
+
+typedef enum { COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_L1D_MISSES, COUNTER_LLC_MISSES, COUNTER_BRANCH_MISSES, COUNTER_COUNT } Counter;
+
+static const char *const counter_names[COUNTER_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+};
+
+typedef struct {
+    int fd[COUNTER_COUNT];       // -1 for an event that could not be opened
+    double total[COUNTER_COUNT]; // counts over the rounds so far, scaled for multiplexing
+} PerfCounters;
+
+#ifdef CALC_HAVE_PERF
+static const struct { uint32_t type; uint64_t config; } counter_events[COUNTER_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+// Opens every event on its own, so one the CPU lacks does not take the
+// others with it. Returns how many opened.
+static int perf_open(PerfCounters *pc) {
+    int opened = 0;
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = counter_events[i].type;
+        attr.config = counter_events[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        pc->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (pc->fd[i] < 0) fprintf(stderr, "perf: no %s counter (%s)\n", counter_names[i], strerror(errno));
+        else opened++;
+    }
+    return opened;
+}
+
+static void perf_start(PerfCounters *pc) {
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        if (pc->fd[i] < 0) continue;
+        ioctl(pc->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static void perf_stop(PerfCounters *pc) {
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+        if (pc->fd[i] >= 0) ioctl(pc->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        uint64_t v[3]; // value, time enabled, time running
+        if (pc->fd[i] < 0 || read(pc->fd[i], v, sizeof v) != (ssize_t)sizeof v) continue;
+        // a counter that shared the PMU with others ran part of the time
+        if (v[2]) pc->total[i] += (double)v[0] * ((double)v[1] / (double)v[2]);
+    }
+}
+
+static void perf_close(PerfCounters *pc) {
+    for (int i = 0; i < COUNTER_COUNT; ++i)
+        if (pc->fd[i] >= 0) close(pc->fd[i]);
+}
+#else
+static int perf_open(PerfCounters *pc) {
+    for (int i = 0; i < COUNTER_COUNT; ++i) pc->fd[i] = -1;
+    fprintf(stderr, "perf: no hardware counters on this platform\n");
+    return 0;
+}
+static void perf_start(PerfCounters *pc) { (void)pc; }
+static void perf_stop(PerfCounters *pc) { (void)pc; }
+static void perf_close(PerfCounters *pc) { (void)pc; }
+#endif
+
+static void perf_print(const PerfCounters *pc, double expressions) {
+    printf(", \"perf\": {");
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        printf("%s\"%s\": ", i ? ", " : "", counter_names[i]);
+        if (pc->fd[i] >= 0) printf("%.2f", pc->total[i] / expressions);
+        else printf("null");
+    }
+    if (pc->fd[COUNTER_CYCLES] >= 0 && pc->fd[COUNTER_INSTRUCTIONS] >= 0 && pc->total[COUNTER_CYCLES] > 0)
+        printf(", \"ipc\": %.3f", pc->total[COUNTER_INSTRUCTIONS] / pc->total[COUNTER_CYCLES]);
+    else
+        printf(", \"ipc\": null");
+    printf("}");
+}
+
+static void bench_stage(BenchStage stage, const BenchCorpus *c, const TokenArray *tokens, const TokenArray *rpn,
+                        PerfCounters *perf) {
+    // the cached run gets room for the whole corpus, so later rounds only hit
+    int saved_capacity = program_cache_capacity;
+    program_cache_capacity = stage == BENCH_LINE_CACHED ? (c->count > saved_capacity ? c->count : saved_capacity) : 0;
+    CalcContext ctx;
+    calc_init(&ctx);
+    program_cache_capacity = saved_capacity;
+    bench_define_vars(&ctx);
+    if (stage == BENCH_LINE_RATIONAL) ctx.numbers = NUMBERS_RATIONAL;
+
+    unsigned long allocs = ctx.arena.heap_allocs + ctx.programs.heap_allocs;
+    double best = INFINITY, total = 0;
+    long rounds = 0;
+    if (perf) memset(perf->total, 0, sizeof(perf->total));
+    while (rounds < BENCH_MIN_ROUNDS || total < BENCH_MIN_NS) {
+        if (perf) perf_start(perf);
+        uint64_t start = now_ns();
+        bench_round(&ctx, stage, c, tokens, rpn);
+        double ns = (double)(now_ns() - start);
+        if (perf) perf_stop(perf);
+        if (ns < best) best = ns;
+        total += ns;
+        rounds++;
+    }
+    allocs = ctx.arena.heap_allocs + ctx.programs.heap_allocs - allocs;
+    calc_free(&ctx);
+
+    double per_expr = c->count ? best / c->count : 0.0;
+    printf("        \"%s\": {\"ns_per_expr\": %.1f, \"expr_per_sec\": %.0f, \"allocs_per_expr\": %.4f, \"rounds\": %ld",
+           bench_stage_names[stage], per_expr, per_expr > 0 ? 1e9 / per_expr : 0.0,
+           c->count ? (double)allocs / ((double)rounds * c->count) : 0.0, rounds);
+    if (perf && c->count) perf_print(perf, (double)rounds * c->count);
+    printf("}");
+}
+
+static void bench_corpus(BenchCorpus *c, int last, PerfCounters *perf) {
+    CalcContext prep;
+    calc_init(&prep);
+    bench_define_vars(&prep);
+    TokenArray *tokens = (TokenArray*)malloc(sizeof(TokenArray) * (size_t)(c->count + 1));
+    TokenArray *rpn = (TokenArray*)malloc(sizeof(TokenArray) * (size_t)(c->count + 1));
+    if (!tokens || !rpn) { perror("malloc"); exit(1); }
+    bench_prepare(&prep, c, tokens, rpn);
+
+    printf("    \"%s\": {\n", c->name);
+    printf("      \"expressions\": %d,\n      \"dropped\": %d,\n      \"mean_length\": %.1f,\n",
+           c->count, c->dropped, c->count ? (double)c->bytes / c->count : 0.0);
+    printf("      \"stages\": {\n");
+    for (int s = 0; s < BENCH_STAGES; ++s) {
+        bench_stage((BenchStage)s, c, tokens, rpn, perf);
+        printf(s + 1 < BENCH_STAGES ? ",\n" : "\n");
+        fflush(stdout);
+    }
+    printf("      }\n    }%s\n", last ? "" : ",");
+
+    free(tokens);
+    free(rpn);
+    calc_free(&prep);
+    for (int i = 0; i < c->count; ++i) free(c->lines[i]);
+    free(c->lines);
+}
+
+int run_bench(const char *path, int counters) {
+    BenchCorpus corpora[5];
+    int n = 0;
+    bench_generate(&corpora[n++], "short", 4096, 12, 0x853c49e6748fea9bULL);
+    bench_generate(&corpora[n++], "medium", 1024, 80, 0xda3e39cb94b95bdbULL);
+    bench_generate(&corpora[n++], "huge", 16, 6000, 0x2545f4914f6cdd1dULL);
+    memset(&corpora[n], 0, sizeof(corpora[n]));
+    corpora[n].name = "realistic";
+    for (size_t i = 0; i < BENCH_COUNT(bench_realistic); ++i)
+        bench_add_line(&corpora[n], bench_realistic[i], strlen(bench_realistic[i]));
+    n++;
+    if (path && !bench_load(&corpora[n++], path)) return 1;
+
+    PerfCounters perf;
+    if (counters) perf_open(&perf);
+    printf("{\n  \"jit\": %s,\n  \"perf\": %s,\n  \"corpora\": {\n",
+#ifdef CALC_HAVE_JIT
+           jit_threshold > 0 ? "true" : "false",
+#else
+           "false",
+#endif
+           counters ? "true" : "false");
+    for (int i = 0; i < n; ++i) bench_corpus(&corpora[i], i + 1 == n, counters ? &perf : NULL);
+    printf("  }\n}\n");
+    if (counters) perf_close(&perf);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int batch = !isatty(fileno(stdin));
+    int threads = 0;
+    int bench = 0, counters = 0, profile = 0;
+    const char *path = NULL, *format = NULL, *sweep = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--batch") == 0) batch = 1;
+        else if (strcmp(argv[i], "--interactive") == 0) batch = 0;
+        else if ((strcmp(argv[i], "--threads") == 0 || strcmp(argv[i], "-j") == 0) && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            if (threads < 1) threads = 1;
+        }
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i];
+        else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            program_cache_capacity = atoi(argv[++i]);
+            if (program_cache_capacity < 0) program_cache_capacity = 0;
+        }
+        else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) sweep = argv[++i];
+        else if (strcmp(argv[i], "--jit") == 0 && i + 1 < argc) {
+#ifdef CALC_HAVE_JIT
+            jit_threshold = atoi(argv[i + 1]);
+            if (jit_threshold < 0) jit_threshold = 0;
+#endif
+            i++;
+        }
+        else if (strcmp(argv[i], "--accuracy") == 0) return run_accuracy();
+        else if (strcmp(argv[i], "--jit-check") == 0) return run_jit_check();
+        else if (strcmp(argv[i], "--stress") == 0) return run_stress();
+        else if (strcmp(argv[i], "--bench") == 0) bench = 1;
+        else if (strcmp(argv[i], "--perf") == 0) bench = counters = 1;
+        else if (strcmp(argv[i], "--profile") == 0) profile = 1;
+        else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) { print_usage(argv[0]); return 0; }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 2;
+        } else path = argv[i];
+    }
+    if (bench) return run_bench(path, counters);
+    if (threads == 0) threads = default_thread_count();
+    NumberFormat result_format = { FMT_DIGITS, 10 };
+    if (format) {
+        if (strcmp(format, "shortest") == 0) result_format.mode = FMT_SHORTEST;
+        else {
+            result_format.digits = atoi(format);
+            if (result_format.digits < 1 || result_format.digits > FORMAT_MAX_DIGITS) {
+                fprintf(stderr, "Invalid format: %s\n", format);
+                return 2;
+            }
+        }
+    } else if (path || batch || sweep) {
+        result_format.mode = FMT_SHORTEST;
+    }
+
+    CalcContext ctx;
+    calc_init(&ctx);
+    ctx.format = result_format;
+    // the prompt always keeps timings for stats; other modes with --profile
+    if (profile || !(sweep || path || batch)) calc_profile(&ctx);
+
+    int rc;
+    if (sweep) {
+        FILE *in = path ? fopen(path, "rb") : stdin;
+        if (!in) { perror(path); calc_free(&ctx); return 1; }
+        rc = run_sweep(&ctx, sweep, in);
+        if (path) fclose(in);
+    } else if (path || batch) {
+        FILE *in = path ? fopen(path, "rb") : stdin;
+        if (!in) { perror(path); calc_free(&ctx); return 1; }
+        rc = -1;
+#ifdef CALC_HAVE_PARALLEL
+        rc = run_batch_mapped(&ctx, fileno(in), threads);
+        if (rc < 0 && threads > 1 && !is_regular_file(fileno(in))) rc = run_batch_pipeline(&ctx, fileno(in), threads);
+#endif
+        if (rc < 0) rc = run_batch(&ctx, in);
+        if (path) fclose(in);
+    } else {
+        rc = run_repl(&ctx);
+    }
+
+    if (profile) print_stats(stderr, &ctx);
+    calc_free(&ctx);
+    return rc;
+}
+
+#endif